@@ -0,0 +1,551 @@
+/*!
+  \file bench.c
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \brief Benchmarks of the engine
+  \remarks None
+
+  Times the core functions of the engine on
+  minefields from 9x9 up to 10000x10000 and prints
+  the results as JSON, to compare commits. The
+  allocation functions are wrapped at link time
+  (see the bench target of the Makefile) to count
+  the allocations of every benchmark.
+
+*/
+
+/* Additional librairies */
+#include "utils.h"
+#include "console.h"
+#include "minesweeper.h"
+#include "bitboard.h"
+#include "random.h"
+#include "render.h"
+#include "setup.h"
+#include "snapshot.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+/*! Measured time after which a benchmark stops repeating */
+#define BENCH_TARGET_NS 100000000LL
+/*! Time, preparations included, after which a benchmark stops repeating */
+#define BENCH_MAX_WALL_NS 1000000000LL
+/*! Maximum amount of repetitions of a benchmark */
+#define BENCH_MAX_REPS 10000
+/*! Largest minefield printed, the frame of bigger ones doesn't fit in memory */
+#define BENCH_RENDER_MAX_CELLS 4000000LL
+/*! Seed of every minefield, for results that can be compared */
+#define BENCH_SEED 20261018ULL
+/*! Snapshot written and read by the benchmarks */
+#define BENCH_SNAPSHOT "bin/bench.snap"
+
+
+/* Custom types */
+/*! Measurements of a benchmark */
+typedef struct {
+  int64_t ns;           /*!< nanoseconds spent in the measured parts */
+  int64_t allocs;       /*!< allocations done in the measured parts */
+  int64_t bytes;        /*!< bytes allocated in the measured parts */
+  int64_t start;        /*!< time the current measured part started at */
+  int64_t startAllocs;  /*!< allocations when the current measured part started */
+  int64_t startBytes;   /*!< bytes allocated when the current measured part started */
+} measure;
+
+/*! Parameters of a benchmark */
+typedef struct {
+  dimensions dim;       /*!< dimensions of the minefield */
+  int64_t mines;        /*!< amount of mines */
+  double density;       /*!< amount of mines per cell */
+} benchParams;
+
+/*! One repetition of a benchmark, measuring only what it benchmarks */
+typedef void (*benchStep)(benchParams* params, measure* m);
+
+
+/* Global variables */
+/*! Allocations since the start of the program */
+static int64_t allocCount = 0;
+/*! Bytes allocated since the start of the program */
+static int64_t allocBytes = 0;
+/*! true once a benchmark has been printed */
+static boolean hasPrinted = false;
+
+void* __real_malloc(size_t size_bytes);
+void* __real_calloc(size_t size_n, size_t size_bytes);
+void* __real_realloc(void* ptr, size_t size_bytes);
+int __real_posix_memalign(void** ptr, size_t size_alignment, size_t size_bytes);
+
+
+
+/*!
+  \fn void* __wrap_malloc(size_t size_bytes)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param size_bytes Bytes to allocate
+  \return The allocated memory
+  \brief Counts the calls to malloc
+  \remarks The counters are atomic, the tiled setup allocates from its threads
+*/
+void* __wrap_malloc(size_t size_bytes)
+{
+  __atomic_fetch_add(&allocCount, 1, __ATOMIC_RELAXED);
+  __atomic_fetch_add(&allocBytes, size_bytes, __ATOMIC_RELAXED);
+  return(__real_malloc(size_bytes));
+}
+
+/*!
+  \fn void* __wrap_calloc(size_t size_n, size_t size_bytes)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param size_n Amount of elements
+  \param size_bytes Bytes of an element
+  \return The allocated memory
+  \brief Counts the calls to calloc
+  \remarks None
+*/
+void* __wrap_calloc(size_t size_n, size_t size_bytes)
+{
+  __atomic_fetch_add(&allocCount, 1, __ATOMIC_RELAXED);
+  __atomic_fetch_add(&allocBytes, size_n * size_bytes, __ATOMIC_RELAXED);
+  return(__real_calloc(size_n, size_bytes));
+}
+
+/*!
+  \fn void* __wrap_realloc(void* ptr, size_t size_bytes)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param ptr Memory to resize
+  \param size_bytes New size
+  \return The resized memory
+  \brief Counts the calls to realloc
+  \remarks None
+*/
+void* __wrap_realloc(void* ptr, size_t size_bytes)
+{
+  __atomic_fetch_add(&allocCount, 1, __ATOMIC_RELAXED);
+  __atomic_fetch_add(&allocBytes, size_bytes, __ATOMIC_RELAXED);
+  return(__real_realloc(ptr, size_bytes));
+}
+
+/*!
+  \fn int __wrap_posix_memalign(void** ptr, size_t size_alignment, size_t size_bytes)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param ptr Where to store the allocated memory
+  \param size_alignment Alignment of the memory
+  \param size_bytes Bytes to allocate
+  \return 0 on success
+  \brief Counts the calls to posix_memalign
+  \remarks None
+*/
+int __wrap_posix_memalign(void** ptr, size_t size_alignment, size_t size_bytes)
+{
+  __atomic_fetch_add(&allocCount, 1, __ATOMIC_RELAXED);
+  __atomic_fetch_add(&allocBytes, size_bytes, __ATOMIC_RELAXED);
+  return(__real_posix_memalign(ptr, size_alignment, size_bytes));
+}
+
+/*!
+  \fn static void startMeasure(measure* m)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param m The measurements
+  \brief Starts a measured part
+  \remarks None
+*/
+static void startMeasure(measure* m)
+{
+  m->startAllocs = allocCount;
+  m->startBytes = allocBytes;
+  m->start = nowNs();
+}
+
+/*!
+  \fn static void stopMeasure(measure* m)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param m The measurements
+  \brief Ends a measured part and adds it to the measurements
+  \remarks None
+*/
+static void stopMeasure(measure* m)
+{
+  m->ns += nowNs() - m->start;
+  m->allocs += allocCount - m->startAllocs;
+  m->bytes += allocBytes - m->startBytes;
+}
+
+/*!
+  \fn static void createMinefield(board* minefield, benchParams* params)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param minefield The minefield to create
+  \param params The parameters of the benchmark
+  \brief Creates a minefield with its mines and counts, outside of the measures
+  \remarks None
+*/
+static void createMinefield(board* minefield, benchParams* params)
+{
+  /* Variables */
+  rng gen;
+
+  seedRng(&gen, BENCH_SEED);
+  initMinefield(minefield, params->dim);
+  placeMines(minefield, params->mines, &gen);
+  initSurroundingMinesBitboard(minefield);
+}
+
+/*!
+  \fn static void benchInitMinefield(benchParams* params, measure* m)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param params The parameters of the benchmark
+  \param m The measurements
+  \brief Times initMinefield
+  \remarks None
+*/
+static void benchInitMinefield(benchParams* params, measure* m)
+{
+  /* Variables */
+  board minefield;
+
+  startMeasure(m);
+  initMinefield(&minefield, params->dim);
+  stopMeasure(m);
+  freeMinefield(&minefield);
+}
+
+/*!
+  \fn static void benchPlaceMines(benchParams* params, measure* m)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param params The parameters of the benchmark
+  \param m The measurements
+  \brief Times placeMines
+  \remarks None
+*/
+static void benchPlaceMines(benchParams* params, measure* m)
+{
+  /* Variables */
+  board minefield;
+  rng gen;
+
+  seedRng(&gen, BENCH_SEED);
+  initMinefield(&minefield, params->dim);
+  startMeasure(m);
+  placeMines(&minefield, params->mines, &gen);
+  stopMeasure(m);
+  freeMinefield(&minefield);
+}
+
+/*!
+  \fn static void benchInitSurroundingMines(benchParams* params, measure* m)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param params The parameters of the benchmark
+  \param m The measurements
+  \brief Times initSurroundingMines
+  \remarks None
+*/
+static void benchInitSurroundingMines(benchParams* params, measure* m)
+{
+  /* Variables */
+  board minefield;
+
+  createMinefield(&minefield, params);
+  startMeasure(m);
+  initSurroundingMines(&minefield);
+  stopMeasure(m);
+  freeMinefield(&minefield);
+}
+
+/*!
+  \fn static void benchInitSurroundingMinesBitboard(benchParams* params, measure* m)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param params The parameters of the benchmark
+  \param m The measurements
+  \brief Times initSurroundingMinesBitboard
+  \remarks None
+*/
+static void benchInitSurroundingMinesBitboard(benchParams* params, measure* m)
+{
+  /* Variables */
+  board minefield;
+
+  createMinefield(&minefield, params);
+  startMeasure(m);
+  initSurroundingMinesBitboard(&minefield);
+  stopMeasure(m);
+  freeMinefield(&minefield);
+}
+
+/*!
+  \fn static void benchSetupMinefieldTiled(benchParams* params, measure* m)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param params The parameters of the benchmark
+  \param m The measurements
+  \brief Times setupMinefieldTiled on every core
+  \remarks To compare with initMinefield, placeMines and
+  initSurroundingMinesBitboard together
+*/
+static void benchSetupMinefieldTiled(benchParams* params, measure* m)
+{
+  /* Variables */
+  board minefield;
+
+  startMeasure(m);
+  setupMinefieldTiled(&minefield, params->dim, params->mines, BENCH_SEED, 0);
+  stopMeasure(m);
+  freeMinefield(&minefield);
+}
+
+/*!
+  \fn static void benchSaveSnapshot(benchParams* params, measure* m)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param params The parameters of the benchmark
+  \param m The measurements
+  \brief Times saveSnapshot, synced to the disk
+  \remarks Leaves BENCH_SNAPSHOT for benchLoadSnapshot
+*/
+static void benchSaveSnapshot(benchParams* params, measure* m)
+{
+  /* Variables */
+  board minefield;
+
+  createMinefield(&minefield, params);
+  startMeasure(m);
+  saveSnapshot(&minefield, BENCH_SEED, BENCH_SNAPSHOT);
+  stopMeasure(m);
+  freeMinefield(&minefield);
+}
+
+/*!
+  \fn static void benchLoadSnapshot(benchParams* params, measure* m)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param params The parameters of the benchmark
+  \param m The measurements
+  \brief Times loadSnapshot on the snapshot of benchSaveSnapshot
+  \remarks The cells are mapped, not read : the time doesn't depend on the
+  size of the minefield
+*/
+static void benchLoadSnapshot(benchParams* params, measure* m)
+{
+  /* Variables */
+  board minefield;
+  uint64_t int_seed;
+
+  startMeasure(m);
+  loadSnapshot(&minefield, &int_seed, BENCH_SNAPSHOT, false);
+  stopMeasure(m);
+  freeMinefield(&minefield);
+}
+
+/*!
+  \fn static void benchReveal(benchParams* params, measure* m)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param params The parameters of the benchmark
+  \param m The measurements
+  \brief Times reveal on an opening of the whole minefield
+  \remarks The single mine is in a corner, the opposite one is revealed :
+  the flood fill goes through every cell
+*/
+static void benchReveal(benchParams* params, measure* m)
+{
+  /* Variables */
+  board minefield;
+
+  initMinefield(&minefield, params->dim);
+  CELL_AT(&minefield, 0, 0) |= CELL_MINE;
+  minefield.count.mines = 1;
+  minefield.count.hiddenMines = 1;
+  minefield.count.hiddenSafe--;
+  initSurroundingMinesBitboard(&minefield);
+
+  startMeasure(m);
+  reveal(&minefield, params->dim.width - 1, params->dim.height - 1);
+  stopMeasure(m);
+  freeMinefield(&minefield);
+}
+
+/*!
+  \fn static void benchUserHasWon(benchParams* params, measure* m)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param params The parameters of the benchmark
+  \param m The measurements
+  \brief Times userHasWon
+  \remarks Called many times per repetition, it doesn't depend on the size
+*/
+static void benchUserHasWon(benchParams* params, measure* m)
+{
+  /* Variables */
+  board minefield;
+  int i;
+  volatile int int_won;
+
+  createMinefield(&minefield, params);
+  startMeasure(m);
+  for (i = 0; i < 1000; i++) int_won = userHasWon(&minefield);
+  stopMeasure(m);
+  (void)int_won;
+  freeMinefield(&minefield);
+}
+
+/*!
+  \fn static void benchPrintMinefield(benchParams* params, measure* m)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param params The parameters of the benchmark
+  \param m The measurements
+  \brief Times printMinefield, with stdout sent to /dev/null
+  \remarks None
+*/
+static void benchPrintMinefield(benchParams* params, measure* m)
+{
+  /* Variables */
+  board minefield;
+  int int_null;
+  int int_stdout;
+
+  createMinefield(&minefield, params);
+  fflush(stdout);
+  int_stdout = dup(STDOUT_FILENO);
+  int_null = open("/dev/null", O_WRONLY);
+  dup2(int_null, STDOUT_FILENO);
+
+  startMeasure(m);
+  printMinefield(&minefield);
+  stopMeasure(m);
+
+  dup2(int_stdout, STDOUT_FILENO);
+  close(int_null);
+  close(int_stdout);
+  freeMinefield(&minefield);
+}
+
+/*!
+  \fn static void runBench(const char* str_name, benchStep step, benchParams* params, int int_opsPerRep)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param str_name Name of the benchmark
+  \param step One repetition of the benchmark
+  \param params The parameters of the benchmark
+  \param int_opsPerRep Calls of the benchmarked function in a repetition
+  \brief Repeats a benchmark until it has been measured long enough and
+  prints its results
+  \remarks None
+*/
+static void runBench(const char* str_name, benchStep step, benchParams* params, int int_opsPerRep)
+{
+  /* Variables */
+  measure m;
+  int64_t int_reps;
+  int64_t int_ops;
+  int64_t int_nCells;
+  int64_t int_start;
+
+  memset(&m, 0, sizeof(measure));
+  int_reps = 0;
+  int_start = nowNs();
+  do {
+    step(params, &m);
+    int_reps++;
+  } while ( (m.ns < BENCH_TARGET_NS) && (int_reps < BENCH_MAX_REPS) && (nowNs() - int_start < BENCH_MAX_WALL_NS) );
+
+  int_ops = int_reps * int_opsPerRep;
+  int_nCells = cellCount(params->dim);
+  printf("%s\n    {\"name\":\"%s\",\"width\":%d,\"height\":%d,\"mines\":%lld,\"density\":%.3f,"
+         "\"reps\":%lld,\"ns_per_op\":%.1f,\"ns_per_cell\":%.4f,\"allocs_per_op\":%.2f,\"bytes_per_op\":%.0f}",
+         hasPrinted ? "," : "", str_name, params->dim.width, params->dim.height, (long long)params->mines,
+         params->density, (long long)int_reps, (double)m.ns / int_ops, (double)m.ns / int_ops / int_nCells,
+         (double)m.allocs / int_ops, (double)m.bytes / int_ops);
+  fflush(stdout);
+  hasPrinted = true;
+}
+
+/*!
+  \fn int main(int argc, char** argv)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param argc Number of console arguments
+  \param argv Console parameters
+  \return 0 on success
+  \brief Runs every benchmark, --quick stops at 1000x1000
+  \remarks None
+*/
+int main(int argc, char** argv)
+{
+  /* Variables */
+  static const dimensions SIZES[] = {
+    { 9, 9 }, { 16, 16 }, { 30, 16 }, { 100, 100 }, { 1000, 1000 }, { 10000, 10000 }
+  };
+  static const double DENSITIES[] = { 0.01, 0.12, 0.21, 0.5, 0.9 };
+  int i;
+  int j;
+  int int_sizes;
+  benchParams params;
+
+  int_sizes = sizeof(SIZES) / sizeof(SIZES[0]);
+  if ( (argc > 1) && (strcmp(argv[1], "--quick") == 0) ) int_sizes--;
+
+  printf("{\"seed\":%llu,\"benchmarks\":[", (unsigned long long)BENCH_SEED);
+  for (i = 0; i < int_sizes; i++) {
+    params.dim = SIZES[i];
+
+    /* Expert density unless the benchmark is about densities */
+    params.density = 0.21;
+    params.mines = cellCount(params.dim) * params.density;
+    runBench("initMinefield", benchInitMinefield, &params, 1);
+
+    for (j = 0; j < (int)(sizeof(DENSITIES) / sizeof(DENSITIES[0])); j++) {
+      params.density = DENSITIES[j];
+      params.mines = cellCount(params.dim) * params.density;
+      if (params.mines == 0) params.mines = 1;
+      runBench("placeMines", benchPlaceMines, &params, 1);
+    }
+
+    params.density = 0.21;
+    params.mines = cellCount(params.dim) * params.density;
+    runBench("initSurroundingMines", benchInitSurroundingMines, &params, 1);
+    runBench("initSurroundingMinesBitboard", benchInitSurroundingMinesBitboard, &params, 1);
+    runBench("setupMinefieldTiled", benchSetupMinefieldTiled, &params, 1);
+    runBench("userHasWon", benchUserHasWon, &params, 1000);
+    if (cellCount(params.dim) <= BENCH_RENDER_MAX_CELLS) runBench("printMinefield", benchPrintMinefield, &params, 1);
+    runBench("saveSnapshot", benchSaveSnapshot, &params, 1);
+    runBench("loadSnapshot", benchLoadSnapshot, &params, 1);
+
+    params.density = 1.0 / cellCount(params.dim);
+    params.mines = 1;
+    runBench("reveal", benchReveal, &params, 1);
+  }
+  printf("\n]}\n");
+  remove(BENCH_SNAPSHOT);
+
+  return(0);
+}
@@ -0,0 +1,143 @@
+/*!
+  \file bitboard.h
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \brief Header file for bitboard.c
+  \remarks None
+*/
+
+#ifndef _BITBOARD_H_
+#define _BITBOARD_H_
+
+/* Additional librairies */
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include "utils.h"
+
+/* Global variables */
+/*! Bit k of a byte moved to byte k of a word */
+#define SPREAD_MASK 0x0101010101010101ULL
+
+
+/* Custom types */
+/*! Scratch bit planes used to count the surrounding mines 64 cells at a time */
+typedef struct {
+  int64_t words;        /*!< 64-bit words in a row of the minefield */
+  uint64_t* mines;      /*!< 3 rows of mine bits (above, current, below), each with a zero guard word on both sides */
+  uint64_t* counts;     /*!< 4 rows of count bits (bit 0 to bit 3 of the amount of surrounding mines) */
+} bitboard;
+
+
+/* Inline functions */
+/*!
+  \fn static inline uint64_t spreadBits(uint64_t int_bits)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param int_bits 8 bits
+  \return A word where byte k is bit k of the input
+  \brief Spreads 8 bits over the 8 bytes of a word
+  \remarks None
+*/
+static inline uint64_t spreadBits(uint64_t int_bits)
+{
+  int_bits = (int_bits | (int_bits << 28)) & 0x0000000F0000000FULL;
+  int_bits = (int_bits | (int_bits << 14)) & 0x0003000300030003ULL;
+  int_bits = (int_bits | (int_bits << 7))  & SPREAD_MASK;
+
+  return(int_bits);
+}
+
+
+/* Function prototypes */
+/*!
+  \fn void packMineRow(board* minefield, int int_y, uint64_t* ptr_row, int64_t int_words)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.2 - halos
+  \param minefield The minefield
+  \param int_y Row to pack, may be outside of the minefield
+  \param ptr_row Destination row (guard words excluded)
+  \param int_words Amount of words in the row
+  \brief Packs the mine bits of a row of cells into words
+  \remarks Rows outside of the minefield and bits after the last
+  column are left at zero. Cells are read 8 at a time (little-endian)
+*/
+void packMineRow(board* minefield, int int_y, uint64_t* ptr_row, int64_t int_words);
+
+/*!
+  \fn int newBitboard(bitboard* planes, dimensions dim_dimensions)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param planes The bit planes to create
+  \param dim_dimensions The dimensions of the minefield
+  \return 0 on success, MEMORY_ALLOCATION_ERROR otherwise (nothing is
+  left allocated)
+  \brief Allocates the bit planes for a minefield of the given width
+  \remarks See initBitboard in console.h for the program
+*/
+int newBitboard(bitboard* planes, dimensions dim_dimensions);
+
+/*!
+  \fn void freeBitboard(bitboard* planes)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param planes The bit planes to free
+  \brief Releases the memory of bit planes created by initBitboard
+  \remarks None
+*/
+void freeBitboard(bitboard* planes);
+
+/*!
+  \fn void countSurroundingMinesRows(board* minefield, bitboard* planes, int int_y0, int int_y1)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.3 - halos
+  \param minefield The minefield
+  \param planes Bit planes allocated for the width of the minefield
+  \param int_y0 First row to count
+  \param int_y1 Row after the last row to count
+  \brief Counts the amount of surrounding mines of each cell of rows [y0, y1)
+  \remarks Reads the mines of rows y0-1 and y1 as well, but only writes
+  the counts of rows [y0, y1). All the rows of a preset minefield are
+  counted by its kernel (see preset.h)
+*/
+void countSurroundingMinesRows(board* minefield, bitboard* planes, int int_y0, int int_y1);
+
+/*!
+  \fn void countSurroundingMinesHalo(board* minefield, bitboard* planes, int int_y0, int int_y1, const uint64_t* ptr_above, const uint64_t* ptr_below)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param minefield The minefield
+  \param planes Bit planes allocated for the width of the minefield
+  \param int_y0 First row to count
+  \param int_y1 Row after the last row to count
+  \param ptr_above Mines of row y0-1 packed by packMineRow, NULL to read them
+  \param ptr_below Mines of row y1 packed by packMineRow, NULL to read them
+  \brief Same as countSurroundingMinesRows, with the rows around given
+  \remarks Only the cells of rows [y0, y1) are read when both rows are
+  given, so that other threads can count the rows around at the same time
+*/
+void countSurroundingMinesHalo(board* minefield, bitboard* planes, int int_y0, int int_y1, const uint64_t* ptr_above, const uint64_t* ptr_below);
+
+/*!
+  \fn void initSurroundingMinesBitboard(board* minefield)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.2 - presets
+  \param minefield The minefield
+  \brief Counts the amount of surrounding mines of each cell using bit planes
+  \remarks Same result as initSurroundingMines, which it falls back to if
+  the bit planes can't be allocated. A preset minefield is counted by its
+  kernel, without any bit planes
+*/
+void initSurroundingMinesBitboard(board* minefield);
+
+
+#endif
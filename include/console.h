@@ -0,0 +1,101 @@
+/*!
+  \file console.h
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \brief Header file for console.c
+  \remarks None
+*/
+
+#ifndef _CONSOLE_H_
+#define _CONSOLE_H_
+
+/* Additional librairies */
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include "utils.h"
+#include "bitboard.h"
+
+/* Global variables */
+
+
+/* Custom types */
+
+
+/* Function prototypes */
+/*!
+  \fn void printMinefield(board* minefield)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 17/12/2020
+  \version 0.3 - buffered renderer
+  \param minefield The minefield to print
+  \brief Prints the minefield to the terminal
+  \remarks One-shot renderer, see render.h to reuse the frame buffer
+*/
+void printMinefield(board* minefield);
+
+/*!
+  \fn void allocMinefield(board* minefield, dimensions dim_dimensions)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.2 - console
+  \param minefield The minefield to create
+  \param dim_dimensions The dimensions of the minefield
+  \brief Creates a minefield without initializing its cells
+  \remarks The caller writes every cell (and the padding up to
+  CELL_ALIGNMENT), for instance from the threads that will use them.
+  Kills the program on allocation error, see newMinefield
+*/
+void allocMinefield(board* minefield, dimensions dim_dimensions);
+
+/*!
+  \fn void initMinefield(board* minefield, dimensions dim_dimensions)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 15/12/2020
+  \version 0.3 - console
+  \param minefield The minefield to init
+  \param dim_dimensions The dimensions of the minefield
+  \brief Creates a minefield and initializes all the values
+  \remarks All the cells are allocated at once, aligned on CELL_ALIGNMENT.
+  Kills the program on allocation error
+*/
+void initMinefield(board* minefield, dimensions dim_dimensions);
+
+/*!
+  \fn int intInput(void)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 13/10/2020
+  \version 0.1 - first draft
+  \return The user's input
+  \brief This function makes sure the user inputs an int
+  \remarks None
+*/
+int intInput(void);
+
+/*!
+  \fn int64_t int64Input(void)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \return The user's input
+  \brief This function makes sure the user inputs a 64-bit int
+  \remarks Used for amounts of cells, which can exceed an int
+*/
+int64_t int64Input(void);
+
+/*!
+  \fn void initBitboard(bitboard* planes, dimensions dim_dimensions)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.2 - console
+  \param planes The bit planes to init
+  \param dim_dimensions The dimensions of the minefield
+  \brief Allocates the bit planes for a minefield of the given width
+  \remarks Kills the program on allocation error, like initMinefield
+*/
+void initBitboard(bitboard* planes, dimensions dim_dimensions);
+
+
+#endif
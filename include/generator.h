@@ -0,0 +1,87 @@
+/*!
+  \file generator.h
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \brief Header file for generator.c
+  \remarks None
+*/
+
+#ifndef _GENERATOR_H_
+#define _GENERATOR_H_
+
+/* Additional librairies */
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <pthread.h>
+#include "utils.h"
+#include "options.h"
+
+/* Global variables */
+/*! Candidates tried before giving up on a minefield without guesses */
+#define GENERATOR_MAX_ATTEMPTS 100000
+
+
+/* Custom types */
+/*! Candidates shared by the threads of a generation */
+typedef struct {
+  dimensions dim;       /*!< dimensions of the minefield */
+  int64_t mines;        /*!< amount of mines */
+  int x;                /*!< x coordinate of the first click */
+  int y;                /*!< y coordinate of the first click */
+  uint64_t seed;        /*!< seed of the generation, candidate i uses the stream mixSeed(seed, i) */
+  int64_t next;         /*!< first candidate no thread has taken yet */
+  int64_t best;         /*!< first candidate found that needs no guess, INT64_MAX until then */
+  int64_t tried;        /*!< candidates played by the solver */
+} generatorJob;
+
+/*! Statistics of a generation */
+typedef struct {
+  boolean found;        /*!< true if the minefield needs no guess */
+  int64_t attempts;     /*!< number of the candidate kept, plus one */
+  int64_t tried;        /*!< candidates played, speculative ones included */
+  int64_t ns;           /*!< nanoseconds spent */
+} generatorStats;
+
+
+/* Function prototypes */
+/*!
+  \fn boolean generateNoGuess(board* minefield, int64_t int_mines, int int_x, int int_y, uint64_t int_seed, int int_threads, generatorStats* stats)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param minefield The minefield, without any mine (flags are kept)
+  \param int_mines Amount of mines
+  \param int_x x coordinate of the first click
+  \param int_y y coordinate of the first click
+  \param int_seed Seed of the generation
+  \param int_threads Amount of threads, 0 for one per core
+  \param stats Where to store the statistics, may be NULL
+  \return true if the minefield can be cleared without guessing
+  \brief Places the mines so that the solver clears the minefield from the
+  first click without a single guess
+  \remarks The first click and its neighbours never hold a mine (see
+  placeMinesAround). Candidates are tried speculatively on every thread
+  and the first one in order that passes is kept, so the minefield only
+  depends on the seed. After GENERATOR_MAX_ATTEMPTS candidates, the first
+  one is kept : it is still safe on the first click
+*/
+boolean generateNoGuess(board* minefield, int64_t int_mines, int int_x, int int_y, uint64_t int_seed, int int_threads, generatorStats* stats);
+
+/*!
+  \fn int runGenerator(options* opt)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param opt The command line options
+  \return Exit code of the program
+  \brief Generates --games minefields without guesses from the centre and
+  prints the statistics of the attempts as a JSON line
+  \remarks None
+*/
+int runGenerator(options* opt);
+
+
+#endif
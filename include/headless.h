@@ -0,0 +1,120 @@
+/*!
+  \file headless.h
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \brief Header file for headless.c
+  \remarks None
+*/
+
+#ifndef _HEADLESS_H_
+#define _HEADLESS_H_
+
+/* Additional librairies */
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include "utils.h"
+#include "options.h"
+
+/* Global variables */
+/*! The moves ran out before the end of the game */
+#define OUTCOME_UNFINISHED 0
+/*! Every safe cell has been revealed */
+#define OUTCOME_WON 1
+/*! A mine has been revealed */
+#define OUTCOME_LOST 2
+
+/*! Size of the read buffer of a move stream */
+#define MOVE_BUFFER_SIZE 65536
+/*! Moves read ahead and played by one clickBatch */
+#define MOVE_BATCH 256
+
+
+/* Custom types */
+/*! Buffered reader of "x y action" moves */
+typedef struct {
+  FILE* file;                       /*!< file the moves are read from */
+  char buffer[MOVE_BUFFER_SIZE];    /*!< bytes read from the file */
+  size_t size;                      /*!< bytes in the buffer */
+  size_t pos;                       /*!< next byte to parse */
+  boolean end;                      /*!< true once the file has been read entirely */
+  int64_t line;                     /*!< line of the next byte, from 1 */
+} moveStream;
+
+/*! Result of a headless game */
+typedef struct {
+  int outcome;          /*!< OUTCOME_UNFINISHED, OUTCOME_WON or OUTCOME_LOST */
+  int64_t moves;        /*!< moves applied to the minefield */
+  int64_t rejected;     /*!< moves ignored : out of the minefield, unknown action or cell not clickable */
+  int64_t revealed;     /*!< cells revealed by the moves */
+  int64_t errorLine;    /*!< line of the first malformed move, 0 if there is none */
+  int64_t setupNs;      /*!< nanoseconds spent creating the minefield */
+  int64_t playNs;       /*!< nanoseconds spent reading and applying the moves */
+} headlessResult;
+
+
+/* Function prototypes */
+/*!
+  \fn void initMoveStream(moveStream* stream, FILE* file)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param stream The move stream to init
+  \param file The file to read the moves from
+  \brief Creates a move stream
+  \remarks The file is not closed by the stream
+*/
+void initMoveStream(moveStream* stream, FILE* file);
+
+/*!
+  \fn int readMove(moveStream* stream, int64_t* ptr_x, int64_t* ptr_y, int64_t* ptr_action)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param stream The move stream
+  \param ptr_x Where to store the x coordinate
+  \param ptr_y Where to store the y coordinate
+  \param ptr_action Where to store the action (1 reveal, 2 mark)
+  \return 1 if a move has been read, 0 at the end of the stream, -1 if the
+  stream is malformed
+  \brief Reads the next move of a stream
+  \remarks Numbers are separated by any amount of blanks, commas or new
+  lines and "#" starts a comment up to the end of the line
+*/
+int readMove(moveStream* stream, int64_t* ptr_x, int64_t* ptr_y, int64_t* ptr_action);
+
+/*!
+  \fn void playHeadless(board* minefield, moveStream* stream, headlessResult* result)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.2 - batches
+  \param minefield The minefield, with its mines
+  \param stream The moves to play
+  \param result Where to store the result, setupNs is left untouched
+  \brief Plays the moves of a stream until the end of the game or of the stream
+  \remarks The moves are read by MOVE_BATCH and played with clickBatch.
+  The moves after the end of the game are not played, and a malformed one
+  among them is not reported
+*/
+void playHeadless(board* minefield, moveStream* stream, headlessResult* result);
+
+/*!
+  \fn int runHeadless(options* opt)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.3 - infinite minefield
+  \param opt The command line options
+  \return 0 on success, the error code otherwise
+  \brief Creates the minefield of the options (or resumes the one of
+  --load), plays the move stream (or lets the solver play) and prints the
+  result as a line of JSON
+  \remarks Nothing is displayed but the result. With --save, the game is
+  saved once the moves are played. With --infinite, the moves are played
+  by runInfinite
+*/
+int runHeadless(options* opt);
+
+
+#endif
@@ -0,0 +1,226 @@
+/*!
+  \file journal.h
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \brief Header file for journal.c
+  \remarks None
+*/
+
+#ifndef _JOURNAL_H_
+#define _JOURNAL_H_
+
+/* Additional librairies */
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include "utils.h"
+
+/* Global variables */
+/*! First bytes of a journal file */
+#define JOURNAL_MAGIC "MINEJRNL"
+/*! Version of the format, to increase with any change of the records */
+#define JOURNAL_VERSION 1
+/*! Bytes of the header : magic, version, width, height, reserved (4 bytes each), mines and seed (8 bytes each) */
+#define JOURNAL_HEADER_SIZE 40
+/*! Size of the write buffer of a journal */
+#define JOURNAL_BUFFER_SIZE 65536
+/*! Least work (moves plus cells revealed) between two keyframes, more on minefields of more cells */
+#define JOURNAL_KEYFRAME_WORK 65536
+
+/*! Low bits of a record that is not a move */
+#define JOURNAL_RECORD 3
+/*! Record holding the hidden and flag planes and the counters after a move */
+#define JOURNAL_KEYFRAME 0
+/*! Record telling how the mines were placed */
+#define JOURNAL_SETUP 1
+
+/*! Mines placed by placeMines from the seed, before the first move */
+#define SETUP_PLACE 0
+/*! Mines placed by setupMinefieldTiled from the seed, before the first move */
+#define SETUP_TILED 1
+/*! Mines placed by placeMinesAround the first cell revealed, from the seed */
+#define SETUP_AROUND 2
+/*! Mines placed by generateNoGuess from the first cell revealed and the seed */
+#define SETUP_NO_GUESS 3
+/*! Minefield loaded from a snapshot, before the first move */
+#define SETUP_SNAPSHOT 4
+
+
+/* Custom types */
+/*! Journal the clicks of a game are appended to. A journal is the header
+  followed by records, each starting with a varint : for a move, the
+  zigzag delta of its cell index from the previous move (0 after a
+  keyframe), shifted by 3, the action minus 1 in bit 2 and the result plus
+  1 in bits 0-1; for any other record, its type shifted by 2 with both low
+  bits set */
+typedef struct journalWriter {
+  int fd;               /*!< file descriptor of the journal */
+  uint8_t* buffer;      /*!< records not written yet */
+  size_t used;          /*!< bytes in the buffer */
+  boolean failed;       /*!< true once a write has failed */
+  int64_t moves;        /*!< moves appended */
+  int64_t lastIndex;    /*!< cell index of the previous move, the base of the next delta */
+  boolean placed;       /*!< true once the mines are placed, keyframes only come after */
+  int64_t work;         /*!< moves and cells revealed since the last keyframe */
+  int64_t keyframeWork; /*!< work after which a keyframe is written */
+  int64_t hiddenSafe;   /*!< hidden safe cells after the previous move */
+} journalWriter;
+
+/*! Keyframe of a journal being read */
+typedef struct {
+  int64_t move;         /*!< moves played before the keyframe */
+  size_t offset;        /*!< offset of the keyframe record in the journal */
+} journalKeyframe;
+
+/*! Journal mapped for reading, with the position of its keyframes */
+typedef struct {
+  uint8_t* data;              /*!< the journal file */
+  size_t size;                /*!< bytes of the journal file */
+  size_t end;                 /*!< end of the last whole record */
+  dimensions dim;             /*!< dimensions of the minefield */
+  int64_t mines;              /*!< amount of mines */
+  uint64_t seed;              /*!< seed of the minefield */
+  int64_t moves;              /*!< moves in the journal */
+  int setup;                  /*!< SETUP_PLACE, SETUP_TILED, SETUP_AROUND, SETUP_NO_GUESS or SETUP_SNAPSHOT, -1 if the mines were never placed */
+  int setupX;                 /*!< x coordinate of the first reveal of the setup */
+  int setupY;                 /*!< y coordinate of the first reveal of the setup */
+  journalKeyframe* keyframes; /*!< keyframes, in order */
+  int64_t nKeyframes;         /*!< amount of keyframes */
+} journalReader;
+
+/*! A record read back from a journal */
+typedef struct {
+  int type;             /*!< JOURNAL_KEYFRAME, JOURNAL_SETUP, or -1 for a move */
+  int64_t index;        /*!< cell index of a move */
+  int action;           /*!< action of a move, 1 to reveal and 2 to mark */
+  int result;           /*!< result click returned for a move */
+  int setup;            /*!< SETUP_* of a setup record */
+  int x;                /*!< x coordinate of the first reveal of a setup record */
+  int y;                /*!< y coordinate of the first reveal of a setup record */
+  int64_t move;         /*!< moves played before a keyframe */
+  counters count;       /*!< counters of a keyframe */
+  const uint8_t* planes;/*!< hidden plane then flag plane of a keyframe, one bit per cell */
+} journalRecord;
+
+
+/* Function prototypes */
+/*!
+  \fn int openJournal(journalWriter* journal, const char* str_path, board* minefield, int64_t int_mines, uint64_t int_seed)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param journal The journal to create
+  \param str_path File to write
+  \param minefield The minefield of the game, its clicks are recorded from now on
+  \param int_mines Amount of mines of the game
+  \param int_seed Seed of the game
+  \return 0 on success, FILE_ERROR otherwise (with a message on stderr)
+  \brief Creates a journal and attaches it to a minefield
+  \remarks The caller then records how the mines are placed with journalSetup
+*/
+int openJournal(journalWriter* journal, const char* str_path, board* minefield, int64_t int_mines, uint64_t int_seed);
+
+/*!
+  \fn void journalSetup(journalWriter* journal, board* minefield, int int_setup, int int_x, int int_y)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param journal The journal
+  \param minefield The minefield, once its mines are placed
+  \param int_setup SETUP_PLACE, SETUP_TILED, SETUP_AROUND, SETUP_NO_GUESS or SETUP_SNAPSHOT
+  \param int_x x coordinate of the first reveal (SETUP_AROUND and SETUP_NO_GUESS)
+  \param int_y y coordinate of the first reveal (SETUP_AROUND and SETUP_NO_GUESS)
+  \brief Records how the mines were placed, after the moves played before
+  \remarks None
+*/
+void journalSetup(journalWriter* journal, board* minefield, int int_setup, int int_x, int int_y);
+
+/*!
+  \fn void appendMove(journalWriter* journal, board* minefield, int64_t int_index, int int_action, int int_result)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param journal The journal
+  \param minefield The minefield, after the move
+  \param int_index Cell index of the move
+  \param int_action 1 to reveal, 2 to mark
+  \param int_result What click returned
+  \brief Appends a move to the buffer of the journal, called by click
+  \remarks A move takes 1 to 4 bytes in most games. Once enough work has
+  been played since the previous keyframe (at least the amount of cells),
+  a keyframe follows : the hidden and flag planes take a quarter of a byte
+  per cell, so keyframes never take more than a quarter of a byte per cell
+  revealed or move played
+*/
+void appendMove(journalWriter* journal, board* minefield, int64_t int_index, int int_action, int int_result);
+
+/*!
+  \fn boolean flushJournal(journalWriter* journal)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param journal The journal
+  \return false if a write has failed since the journal was opened
+  \brief Writes the buffer of a journal to its file
+  \remarks The interactive game flushes after every move, the headless mode
+  only when the buffer is full
+*/
+boolean flushJournal(journalWriter* journal);
+
+/*!
+  \fn int closeJournal(journalWriter* journal, board* minefield)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param journal The journal
+  \param minefield The minefield it is attached to
+  \return 0 on success, FILE_ERROR otherwise (with a message on stderr)
+  \brief Flushes and closes a journal and detaches it from the minefield
+  \remarks None
+*/
+int closeJournal(journalWriter* journal, board* minefield);
+
+/*!
+  \fn int openReplay(journalReader* reader, const char* str_path)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param reader The reader to create
+  \param str_path Journal to read
+  \return 0 on success, FILE_ERROR otherwise (with a message on stderr)
+  \brief Maps a journal and finds its keyframes
+  \remarks The moves are only counted, looking for the end of their
+  varint : the game isn't played. A record cut by a crash ends the journal
+*/
+int openReplay(journalReader* reader, const char* str_path);
+
+/*!
+  \fn void closeReplay(journalReader* reader)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param reader The reader
+  \brief Releases a journal mapped by openReplay
+  \remarks None
+*/
+void closeReplay(journalReader* reader);
+
+/*!
+  \fn size_t readRecord(journalReader* reader, size_t size_offset, int64_t* ptr_lastIndex, journalRecord* record)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param reader The reader
+  \param size_offset Offset of the record
+  \param ptr_lastIndex Cell index of the previous move, updated
+  \param record The record to fill
+  \return Offset of the next record, 0 if the record is cut or malformed
+  \brief Decodes a record of a journal
+  \remarks None
+*/
+size_t readRecord(journalReader* reader, size_t size_offset, int64_t* ptr_lastIndex, journalRecord* record);
+
+
+#endif
@@ -0,0 +1,191 @@
+/*!
+  \file libminesweeper.h
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \brief Header file for libminesweeper.c, the interface of the library
+  \remarks The only header a program linked with libminesweeper.a or
+  libminesweeper.so needs
+*/
+
+#ifndef _LIBMINESWEEPER_H_
+#define _LIBMINESWEEPER_H_
+
+/* Additional librairies */
+#include <stdint.h>
+
+/* Global variables */
+/*! The game goes on */
+#define MINE_PLAYING 0
+/*! Every safe cell has been revealed, or every mine has a flag and only them */
+#define MINE_WON 1
+/*! A mine has been revealed */
+#define MINE_LOST 2
+
+/*! Memory allocation error code (MEMORY_ALLOCATION_ERROR of the program) */
+#define MINE_ERROR_MEMORY -1
+/*! The cell can't be clicked : it is already revealed */
+#define MINE_REJECTED -2
+/*! Argument error code (ARGUMENT_ERROR of the program) : out of the
+  minefield, unknown action, impossible minefield or game over */
+#define MINE_ERROR_ARGUMENT -3
+
+/*! Reveal action of mineClick */
+#define MINE_REVEAL 1
+/*! Mark action of mineClick, puts or removes a flag */
+#define MINE_MARK 2
+
+/*! Hidden cell, for mineCell (0 to 8 are revealed cells and their amount of surrounding mines) */
+#define MINE_CELL_HIDDEN 9
+/*! Hidden cell with a flag */
+#define MINE_CELL_FLAG 10
+/*! Mine without a flag, only shown once the game is over */
+#define MINE_CELL_MINE 11
+/*! The mine that ended the game */
+#define MINE_CELL_BOMB 12
+
+
+/* Custom types */
+/*! A game, only handled through the functions below */
+typedef struct mineGame mineGame;
+
+/*! Memory of finished games, kept for the next ones */
+typedef struct minePool minePool;
+
+/*! State of a game */
+typedef struct {
+  int width;            /*!< width of the minefield */
+  int height;           /*!< height of the minefield */
+  int64_t mines;        /*!< mines in the minefield */
+  int64_t flags;        /*!< flags placed */
+  int64_t hiddenSafe;   /*!< safe cells left to reveal */
+  int64_t moves;        /*!< clicks applied */
+  int state;            /*!< MINE_PLAYING, MINE_WON or MINE_LOST */
+} mineStatus;
+
+
+/* Function prototypes */
+/*!
+  \fn int mineCreate(mineGame** ptr_game, int int_width, int int_height, int64_t int_mines, uint64_t int_seed)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param ptr_game Where to store the new game
+  \param int_width Width of the minefield, at least 1
+  \param int_height Height of the minefield, at least 1
+  \param int_mines Amount of mines, at least 1 and less than the cells
+  \param int_seed Seed of the minefield
+  \return 0 on success, MINE_ERROR_ARGUMENT or MINE_ERROR_MEMORY otherwise
+  (*ptr_game is then NULL)
+  \brief Creates a game
+  \remarks The mines are placed on the first reveal, never on the cell
+  revealed nor around it. Games share nothing : each one may be played
+  by its own thread without any lock. A game is a single allocation,
+  see mineCreateFrom to reuse it for the next game
+*/
+int mineCreate(mineGame** ptr_game, int int_width, int int_height, int64_t int_mines, uint64_t int_seed);
+
+/*!
+  \fn int mineCreateFrom(minePool* pool, mineGame** ptr_game, int int_width, int int_height, int64_t int_mines, uint64_t int_seed)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param pool The pool the memory of the game comes from, NULL for mineCreate
+  \param ptr_game Where to store the new game
+  \param int_width Width of the minefield, at least 1
+  \param int_height Height of the minefield, at least 1
+  \param int_mines Amount of mines, at least 1 and less than the cells
+  \param int_seed Seed of the minefield
+  \return 0 on success, MINE_ERROR_ARGUMENT or MINE_ERROR_MEMORY otherwise
+  (*ptr_game is then NULL)
+  \brief Creates a game like mineCreate, with the memory of a game of the
+  pool destroyed before if there is one of the same size
+  \remarks Once the pool holds the memory of finished games, creating and
+  destroying games of the same sizes calls neither malloc nor free. The
+  pool and its games must only be used by one thread at a time
+*/
+int mineCreateFrom(minePool* pool, mineGame** ptr_game, int int_width, int int_height, int64_t int_mines, uint64_t int_seed);
+
+/*!
+  \fn int mineClick(mineGame* game, int int_x, int int_y, int int_action)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param game The game
+  \param int_x x coordinate to click
+  \param int_y y coordinate to click
+  \param int_action MINE_REVEAL or MINE_MARK
+  \return The state of the game after the click (MINE_PLAYING, MINE_WON or
+  MINE_LOST), MINE_REJECTED if the cell is already revealed,
+  MINE_ERROR_ARGUMENT if the click is out of the minefield, the action is
+  unknown or the game is over
+  \brief Plays a click
+  \remarks None
+*/
+int mineClick(mineGame* game, int int_x, int int_y, int int_action);
+
+/*!
+  \fn int mineCell(const mineGame* game, int int_x, int int_y)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param game The game
+  \param int_x x coordinate of the cell
+  \param int_y y coordinate of the cell
+  \return What the player sees on the cell : 0 to 8 for a revealed cell,
+  MINE_CELL_HIDDEN, MINE_CELL_FLAG, MINE_CELL_MINE or MINE_CELL_BOMB, or
+  MINE_ERROR_ARGUMENT out of the minefield
+  \brief Reads a cell of a game
+  \remarks The mines stay hidden until the game is over
+*/
+int mineCell(const mineGame* game, int int_x, int int_y);
+
+/*!
+  \fn void mineQuery(const mineGame* game, mineStatus* status)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param game The game
+  \param status Where to store the state of the game
+  \brief Reads the state and the counters of a game
+  \remarks O(1), the counters are kept up to date by every click
+*/
+void mineQuery(const mineGame* game, mineStatus* status);
+
+/*!
+  \fn void mineDestroy(mineGame* game)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param game The game, may be NULL
+  \brief Releases a game created by mineCreate, or gives its memory back
+  to the pool of mineCreateFrom
+  \remarks None
+*/
+void mineDestroy(mineGame* game);
+
+/*!
+  \fn int minePoolCreate(minePool** ptr_pool)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param ptr_pool Where to store the new pool
+  \return 0 on success, MINE_ERROR_MEMORY otherwise (*ptr_pool is then NULL)
+  \brief Creates an empty pool for mineCreateFrom
+  \remarks None
+*/
+int minePoolCreate(minePool** ptr_pool);
+
+/*!
+  \fn void minePoolDestroy(minePool* pool)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param pool The pool, may be NULL
+  \brief Frees the memory kept by a pool, and the pool
+  \remarks Every game created from the pool must be destroyed first
+*/
+void minePoolDestroy(minePool* pool);
+
+
+#endif
@@ -0,0 +1,89 @@
+/*!
+  \file loadgen.h
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \brief Header file for loadgen.c
+  \remarks None
+*/
+
+#ifndef _LOADGEN_H_
+#define _LOADGEN_H_
+
+/* Additional librairies */
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <pthread.h>
+#include "utils.h"
+#include "options.h"
+#include "random.h"
+#include "stats.h"
+
+/* Global variables */
+/*! Connections opened when --clients is not given */
+#define LOADGEN_CLIENTS 1000
+/*! Duration of the load when --seconds is not given */
+#define LOADGEN_SECONDS 10
+/*! The client waits for the reply to new */
+#define LOADGEN_NEW 0
+/*! The client waits for the reply to click */
+#define LOADGEN_CLICK 1
+/*! The client waits for the reply to diff */
+#define LOADGEN_DIFF 2
+
+
+/* Custom types */
+/*! A connection to the server, playing random games */
+typedef struct {
+  int fd;               /*!< socket, -1 once closed */
+  rng gen;              /*!< picks the cells to click */
+  uint8_t* revealed;    /*!< 1 for each cell the diffs showed revealed */
+  char* in;             /*!< bytes of the reply received so far */
+  int64_t inCount;      /*!< bytes in the input buffer */
+  int pending;          /*!< LOADGEN_NEW, LOADGEN_CLICK or LOADGEN_DIFF */
+  int64_t sentAt;       /*!< time the pending request was sent, in nanoseconds */
+} loadClient;
+
+/*! Load of a thread */
+typedef struct {
+  pthread_t thread;     /*!< thread of the worker */
+  const options* opt;   /*!< the command line options */
+  dimensions dim;       /*!< dimensions of the games */
+  int64_t mines;        /*!< mines of the games */
+  int64_t first;        /*!< index of the first client of the worker */
+  int64_t count;        /*!< clients of the worker */
+  int64_t seconds;      /*!< duration of the load */
+  int64_t connected;    /*!< clients that could connect */
+  int64_t requests;     /*!< replies received */
+  int64_t moves;        /*!< click requests answered */
+  int64_t games;        /*!< games finished, won or lost */
+  int64_t won;          /*!< games won */
+  int64_t errors;       /*!< error replies, refused or lost connections */
+  int64_t elapsedNs;    /*!< time from the first request to the last reply */
+  latencyHistogram latency; /*!< latencies of the requests */
+} loadWorker;
+
+
+/* Function prototypes */
+/*!
+  \fn int runLoadgen(options* opt)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param opt The command line options
+  \return 0 on success, FILE_ERROR if no client could connect
+  \brief Loads the --loadgen server with --clients connections for
+  --seconds and prints the throughput and the latency percentiles as a line
+  of JSON
+  \remarks Each of the --threads threads runs an epoll loop over its
+  share of the clients. A client keeps one request in flight : new, then
+  click on a random cell it doesn't know revealed followed by diff, until
+  the game ends and a new one starts. The games are 30x16 with 99 mines
+  unless --width, --height and --mines are given
+*/
+int runLoadgen(options* opt);
+
+
+#endif
@@ -15,78 +15,154 @@
 #include <stdio.h>
 #include <string.h>
 #include "utils.h"
+#include "random.h"
 
 /* Global variables */
 
 
+/* Custom types */
+/*! A move of a batch (see clickBatch) */
+typedef struct {
+  int x;                /*!< x coordinate to click */
+  int y;                /*!< y coordinate to click */
+  int action;           /*!< 1 to reveal, 2 to mark */
+  int result;           /*!< result of the move, written by clickBatch : 1, 0 for a mine, -1 if it was rejected */
+} boardMove;
+
+/*! What a batch of moves did */
+typedef struct {
+  int64_t played;       /*!< moves looked at, the moves after the end of the game are not */
+  int64_t applied;      /*!< moves that changed the minefield */
+  int64_t rejected;     /*!< moves out of the minefield, with an unknown action or on a cell that can't be clicked */
+  int64_t revealed;     /*!< safe cells revealed by the batch */
+  boolean lost;         /*!< true if a move revealed a mine */
+  boolean won;          /*!< true if the minefield is won after the batch */
+} batchResult;
+
+
 /* Function prototypes */
 /*!
-  \fn void placeMines(cell** minefield, dimensions dim_dimensions, int int_numOfMines)
+  \fn void placeMines(board* minefield, int64_t int_numOfMines, rng* gen)
   \author L.Draescher <draescherl@eisti.eu>
   \date 17/12/2020
-  \version 0.1 - first draft
-  \param minefield The minefield
-  \param dim_dimensions The dimensions of the minefield
+  \version 0.3 - O(mines) placement
+  \param minefield The minefield, without any mine
   \param int_numOfMines Number of mines to place
+  \param gen Random number generator of the game
   \brief Randomly places a given amount of mines 
-  \remarks None
+  \remarks Every set of cells is equally likely. Uses Floyd's sampling :
+  one random draw per mine, or per safe cell above half the cells
 */
-void placeMines(cell** minefield, dimensions dim_dimensions, int int_numOfMines);
+void placeMines(board* minefield, int64_t int_numOfMines, rng* gen);
 
 /*!
-  \fn void initSurroundingMines(cell** minefield, dimensions dim_dimensions)
+  \fn void placeMinesAround(board* minefield, int64_t int_numOfMines, int int_x, int int_y, rng* gen)
   \author L.Draescher <draescherl@eisti.eu>
-  \date 17/12/2020
+  \date 18/10/2026
   \version 0.1 - first draft
+  \param minefield The minefield, without any mine (flags are kept)
+  \param int_numOfMines Number of mines to place
+  \param int_x x coordinate of the first click
+  \param int_y y coordinate of the first click
+  \param gen Random number generator of the game
+  \brief Randomly places a given amount of mines, none on the first click
+  or around it
+  \remarks The first click then opens an area. When the other cells can't
+  hold all the mines, only the clicked cell is kept safe (or none, when
+  every cell is a mine)
+*/
+void placeMinesAround(board* minefield, int64_t int_numOfMines, int int_x, int int_y, rng* gen);
+
+/*!
+  \fn void initSurroundingMines(board* minefield)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 17/12/2020
+  \version 0.2 - packed cells
   \param minefield The minefield
-  \param dim_dimensions The dimensions of the minefield
   \brief Counts the amount of surrounding mines of each cell
   \remarks None
 */
-void initSurroundingMines(cell** minefield, dimensions dim_dimensions);
+void initSurroundingMines(board* minefield);
 
 /*!
-  \fn void reveal(cell** minefield, dimensions dim_dimensions, int int_x, int int_y)
+  \fn int64_t reveal(board* minefield, int int_x, int int_y)
   \author L.Draescher <draescherl@eisti.eu>
   \date 18/12/2020
-  \version 0.1 - first draft
+  \version 0.5 - stats
   \param minefield The minefield
-  \param dim_dimensions The dimensions of the minefield
   \param int_x x coordinate
   \param int_y y coordinate
+  \return The amount of cells revealed
   \brief Reveal necessary cells
-  \remarks None
+  \remarks Breadth-first flood fill on the work buffer of the minefield,
+  each cell is revealed at most once and the call stack is never used. If
+  the work buffer can't grow, the fill ends with passes over the whole
+  minefield instead. Measured with --stats (see stats.h)
 */
-void reveal(cell** minefield, dimensions dim_dimensions, int int_x, int int_y);
+int64_t reveal(board* minefield, int int_x, int int_y);
 
 /*!
-  \fn int click(cell** minefield, dimensions dim_dimensions, int int_x, int int_y, int int_action)
+  \fn int click(board* minefield, int int_x, int int_y, int int_action)
   \author L.Draescher <draescherl@eisti.eu>
   \date 18/12/2020
-  \version 0.1 - first draft
+  \version 0.6 - undo
   \param minefield The minefield
-  \param dim_dimensions The dimensions of the minefield
   \param int_x x coordinate to click
   \param int_y y coordinate to click
   \param int_action reveal or mark cell
   \return 0 if the user clicks on a mine, -1 if the cell is not clickable, 1 otherwise
   \brief Perform a user 'click'
-  \remarks action = 1 => reveal, action = 2 => mark
+  \remarks action = 1 => reveal, action = 2 => mark. The click is passed
+  to the onClick hook of the minefield, if it has one (see journal.h), and
+  the cells it changes to its undo history (see undo.h). Measured with
+  --stats (see stats.h)
 */
-int click(cell** minefield, dimensions dim_dimensions, int int_x, int int_y, int int_action);
+int click(board* minefield, int int_x, int int_y, int int_action);
 
 /*!
-  \fn int userHasWon(cell** minefield, dimensions dim_dimensions)
+  \fn int64_t clickBatch(board* minefield, boardMove* moves, int64_t int_count, batchResult* result)
   \author L.Draescher <draescherl@eisti.eu>
-  \date 18/12/2020
+  \date 18/10/2026
   \version 0.1 - first draft
+  \param minefield The minefield, with its mines
+  \param moves The moves, in the order they are played
+  \param int_count Amount of moves
+  \param result Where to store what the batch did
+  \return The amount of moves played (result->played)
+  \brief Plays moves in order like click, until a mine is revealed or the
+  minefield is won
+  \remarks The result of each move played is written in the move, the
+  moves after the end of the game are left alone. Unlike click, moves out
+  of the minefield or with an unknown action are rejected. Each move is
+  still passed to the onClick hook and to the undo history. The cells changed by the whole batch
+  are in the dirty list (see trackDirty), and the win is only checked
+  when the counters allow it, so a batch costs one call instead of a
+  click and a userHasWon per move. Measured with --stats (see stats.h)
+*/
+int64_t clickBatch(board* minefield, boardMove* moves, int64_t int_count, batchResult* result);
+
+/*!
+  \fn int userHasWon(board* minefield)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/12/2020
+  \version 0.3 - stats
   \param minefield The minefield
-  \param dim_dimensions The dimensions of the minefield
   \return 1 if the user has won, 0 otherwise
   \brief Checks if the user has won
-  \remarks None
+  \remarks Reads the live counters, O(1). Measured with --stats (see stats.h)
+*/
+int userHasWon(board* minefield);
+
+/*!
+  \fn void recountMinefield(board* minefield)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param minefield The minefield
+  \brief Rebuilds the live counters from the cells
+  \remarks Only needed when cells are changed without placeMines, click or reveal
 */
-int userHasWon(cell** minefield, dimensions dim_dimensions);
+void recountMinefield(board* minefield);
 
 
 #endif
\ No newline at end of file
@@ -0,0 +1,78 @@
+/*!
+  \file options.h
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \brief Header file for options.c
+  \remarks None
+*/
+
+#ifndef _OPTIONS_H_
+#define _OPTIONS_H_
+
+/* Additional librairies */
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include "utils.h"
+
+/* Global variables */
+
+
+/* Custom types */
+/*! Command line options of the program */
+typedef struct {
+  uint64_t seed;        /*!< seed of the random number generator */
+  boolean hasSeed;      /*!< true if the seed was given on the command line */
+  boolean frameStats;   /*!< true to print the size and time of every frame */
+  boolean stats;        /*!< true to print the measurements of the engine on stderr at exit */
+  boolean diff;         /*!< true to repaint only the cells that changed */
+  boolean practice;     /*!< true to let the player undo and redo the moves of the interactive game */
+  boolean headless;     /*!< true to play the moves of a stream without any display */
+  const char* moves;    /*!< file the moves are read from in headless mode, "-" for stdin */
+  dimensions dim;       /*!< dimensions of the minefield in headless and simulation modes */
+  int64_t mines;        /*!< amount of mines in headless and simulation modes */
+  boolean solve;        /*!< true to let the solver play in headless mode instead of reading moves */
+  int64_t games;        /*!< amount of games the solver or the simulation plays */
+  boolean simulate;     /*!< true to play many games on every core and print the win rate */
+  const char* strategy; /*!< name of the strategy the simulation plays with */
+  int threads;          /*!< amount of threads of the simulation, the tiled setup, the server and the load generator, 0 for one per core */
+  boolean tiled;        /*!< true to set the minefield of the headless mode up by tiles on several threads */
+  boolean noGuess;      /*!< true for minefields the solver clears without guessing */
+  const char* save;     /*!< snapshot file the game is saved to, NULL not to save it */
+  const char* load;     /*!< snapshot file the game is resumed from, NULL for a new game */
+  boolean verify;       /*!< true to check the checksum of the cells of the loaded snapshot, and every move of the replay */
+  const char* journal;  /*!< journal the moves are recorded to, NULL not to record them */
+  const char* replay;   /*!< journal to replay, NULL to play */
+  int64_t seek;         /*!< move the replay stops at, -1 for the end of the journal */
+  boolean infinite;     /*!< true to play the headless moves on an infinite minefield */
+  int density;          /*!< percent of cells holding a mine on the infinite minefield */
+  int64_t cache;        /*!< chunks of the infinite minefield kept in memory before the resolved ones are evicted */
+  const char* serve;    /*!< socket the server hosts games on, NULL not to serve */
+  const char* loadgen;  /*!< socket of the server to load, NULL not to load one */
+  int64_t clients;      /*!< connections the load generator opens, 0 for LOADGEN_CLIENTS */
+  int seconds;          /*!< duration of the server or of the load, 0 for until a signal or LOADGEN_SECONDS */
+} options;
+
+
+/* Function prototypes */
+/*!
+  \fn void parseOptions(int argc, char** argv, options* opt)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param argc Number of console arguments
+  \param argv Console parameters
+  \param opt The options to fill
+  \brief Reads the command line options
+  \remarks Prints the usage and kills the program on invalid arguments,
+  the headless and simulation modes need the dimensions and the amount of
+  mines, unless the headless mode resumes a snapshot or plays on an
+  infinite minefield. The server and the load generator play no game of
+  their own
+*/
+void parseOptions(int argc, char** argv, options* opt);
+
+
+#endif
@@ -0,0 +1,109 @@
+/*!
+  \file pool.h
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \brief Header file for pool.c
+  \remarks None
+*/
+
+#ifndef _POOL_H_
+#define _POOL_H_
+
+/* Additional librairies */
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "utils.h"
+#include "bitboard.h"
+
+/* Global variables */
+/*! Log2 of the smallest arena, in bytes */
+#define POOL_MIN_CLASS 10
+/*! Size classes : arenas of 2^POOL_MIN_CLASS to 2^(POOL_MIN_CLASS + POOL_CLASSES - 1) bytes */
+#define POOL_CLASSES 40
+/*! Flood fill work buffer of an arena : indices per cell of the perimeter
+  (width + height), the queue of a flood holds about two rings of cells */
+#define POOL_QUEUE_PERIMETER 4
+/*! Dirty list of an arena : one index per POOL_DIRTY_SHARE cells, a longer
+  list overflows and its consumer reads every cell instead */
+#define POOL_DIRTY_SHARE 16
+/*! Smallest dirty list of an arena */
+#define POOL_DIRTY_MIN 64
+
+
+/* Custom types */
+/*! Arenas of finished games, kept for the next ones instead of being freed */
+typedef struct {
+  void* free[POOL_CLASSES]; /*!< arenas ready to be taken, a list per size class */
+  int64_t allocated;    /*!< arenas allocated, the other takes reused one */
+  int64_t taken;        /*!< arenas taken */
+  size_t retained;      /*!< bytes of the arenas in the lists */
+} boardPool;
+
+
+/* Function prototypes */
+/*!
+  \fn void initPool(boardPool* pool)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param pool The pool to init
+  \brief Creates an empty pool
+  \remarks Allocates nothing. A pool must only be used by one thread at a time
+*/
+void initPool(boardPool* pool);
+
+/*!
+  \fn void emptyPool(boardPool* pool)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param pool The pool
+  \brief Frees the arenas kept by a pool
+  \remarks The arenas still taken are not affected
+*/
+void emptyPool(boardPool* pool);
+
+/*!
+  \fn int takeMinefield(boardPool* pool, board* minefield, bitboard* planes, dimensions dim_dimensions, size_t size_extra, void** ptr_extra)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.2 - capped buffers
+  \param pool The pool, NULL to allocate the arena
+  \param minefield The minefield to create
+  \param planes Where to store bit planes for the width of the minefield,
+  NULL if none are needed
+  \param dim_dimensions The dimensions of the minefield
+  \param size_extra Bytes the caller wants in the arena too, 0 for none
+  \param ptr_extra Where to store the address of those bytes (aligned on
+  CELL_ALIGNMENT), NULL if size_extra is 0
+  \return 0 on success, MEMORY_ALLOCATION_ERROR otherwise
+  \brief Creates a minefield, every cell hidden and without any mine, in a
+  single arena : the cells, a flood fill work buffer and a dirty list
+  (see POOL_QUEUE_PERIMETER and POOL_DIRTY_SHARE), the bit planes and the
+  extra bytes
+  \remarks The arena comes from the pool when it holds one of the right
+  size class : creating a game then calls neither malloc nor free. The
+  work buffers never grow : a flood that fills its buffer finishes with a
+  sweep of the minefield, and a dirty list that fills up overflows. The
+  bit planes must not be freed by
+  freeBitboard : they go with the arena
+*/
+int takeMinefield(boardPool* pool, board* minefield, bitboard* planes, dimensions dim_dimensions, size_t size_extra, void** ptr_extra);
+
+/*!
+  \fn void releaseMinefield(boardPool* pool, board* minefield)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param pool The pool, NULL to free the arena
+  \param minefield The minefield
+  \brief Gives the arena of a minefield back to a pool
+  \remarks A minefield that isn't in an arena is released by freeMinefield.
+  The minefield may be in the extra bytes of its own arena
+*/
+void releaseMinefield(boardPool* pool, board* minefield);
+
+
+#endif
@@ -0,0 +1,50 @@
+/*!
+  \file preset.h
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \brief Header file for preset.c
+  \remarks None
+*/
+
+#ifndef _PRESET_H_
+#define _PRESET_H_
+
+/* Additional librairies */
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "utils.h"
+
+/* Global variables */
+/*! Words of the bitboard of a preset, one bit per cell : up to 512 cells */
+#define PRESET_WORDS 8
+
+
+/* Custom types */
+/*! Kernels compiled for the dimensions of a preset (beginner, intermediate, expert) */
+typedef struct {
+  int width;            /*!< width of the minefield */
+  int height;           /*!< height of the minefield */
+  void (*countMines)(board* minefield); /*!< same as initSurroundingMinesBitboard */
+  int64_t (*floodCells)(board* minefield, int64_t int_start, uint64_t* ptr_revealed, int64_t* ptr_visited); /*!< see floodPreset in preset.c */
+} presetKernels;
+
+
+/* Function prototypes */
+/*!
+  \fn const presetKernels* findPreset(dimensions dim_dimensions)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param dim_dimensions The dimensions of a minefield
+  \return The kernels of these dimensions, NULL if they aren't a preset
+  \brief Picks the kernels compiled for the dimensions of a minefield
+  \remarks 9x9, 16x16 and 30x16 have kernels : the whole minefield is
+  one bitboard of at most 512 bits, and the loops, shifts and column
+  masks are constants. Other dimensions use the generic functions
+*/
+const presetKernels* findPreset(dimensions dim_dimensions);
+
+
+#endif
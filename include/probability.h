@@ -0,0 +1,77 @@
+/*!
+  \file probability.h
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \brief Header file for probability.c
+  \remarks None
+*/
+
+#ifndef _PROBABILITY_H_
+#define _PROBABILITY_H_
+
+/* Additional librairies */
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include "utils.h"
+
+/* Global variables */
+/*! The numbers and the flags can't all be right */
+#define PROBABILITY_INCONSISTENT -1
+/*! A group of frontier cells has too many states to be counted exactly */
+#define PROBABILITY_TOO_COMPLEX -2
+
+/*! Maximum amount of states kept for the frontier */
+#define PROBABILITY_MAX_STATES 1000000
+/*! Work (states and weights by amount of mines) of about a millisecond on 30x16, for the solver */
+#define PROBABILITY_QUICK_BUDGET 10000
+/*! Work of a few tenths of a second at most, for a player waiting for a hint */
+#define PROBABILITY_FULL_BUDGET 5000000
+
+
+/* Custom types */
+
+
+/* Function prototypes */
+/*!
+  \fn int computeProbabilities(board* minefield, double* ptr_prob, int64_t int_budget)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.2 - budget
+  \param minefield The minefield
+  \param ptr_prob Array of one probability per cell to fill, -1 for the
+  revealed and flagged cells
+  \param int_budget Most work to do, PROBABILITY_QUICK_BUDGET or PROBABILITY_FULL_BUDGET
+  \return 0 on success, PROBABILITY_INCONSISTENT or PROBABILITY_TOO_COMPLEX
+  \brief Computes the exact probability of every hidden cell to hold a mine,
+  from what the player sees
+  \remarks Flags are trusted. The hidden cells next to a number (the
+  frontier) are split into independent groups; the arrangements of each
+  group are counted by amount of mines with a dynamic programming over the
+  remaining needs of its numbers, then the groups and the other hidden
+  cells are weighted by the amount of ways to place the rest of the mines.
+  The cells whose value the numbers force are set aside first, and each
+  group is swept along its longer side. Past the budget, the counting
+  stops and PROBABILITY_TOO_COMPLEX is returned : the probabilities are
+  exact or not given at all
+*/
+int computeProbabilities(board* minefield, double* ptr_prob, int64_t int_budget);
+
+/*!
+  \fn int64_t safestCell(board* minefield, double* ptr_prob)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param minefield The minefield
+  \param ptr_prob The probabilities (see computeProbabilities)
+  \return Index of the hidden cell without a flag least likely to hold a
+  mine, -1 if there is none
+  \brief Picks the best cell to reveal
+  \remarks Ties go to the first cell
+*/
+int64_t safestCell(board* minefield, double* ptr_prob);
+
+
+#endif
@@ -0,0 +1,79 @@
+/*!
+  \file random.h
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \brief Header file for random.c
+  \remarks None
+*/
+
+#ifndef _RANDOM_H_
+#define _RANDOM_H_
+
+/* Additional librairies */
+#include <stdlib.h>
+#include <stdint.h>
+
+/* Global variables */
+
+
+/* Custom types */
+/*! State of a xoshiro256** pseudo random number generator */
+typedef struct {
+  uint64_t s[4];    /*!< 256 bits of state, never all zero */
+} rng;
+
+
+/* Function prototypes */
+/*!
+  \fn void seedRng(rng* gen, uint64_t int_seed)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param gen The generator to seed
+  \param int_seed Any 64-bit seed
+  \brief Seeds a generator, the same seed always gives the same sequence
+  \remarks The state is expanded from the seed with splitmix64
+*/
+void seedRng(rng* gen, uint64_t int_seed);
+
+/*!
+  \fn uint64_t nextRandom(rng* gen)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param gen The generator
+  \return 64 random bits
+  \brief Draws the next number of a generator
+  \remarks None
+*/
+uint64_t nextRandom(rng* gen);
+
+/*!
+  \fn uint64_t boundedRandom(rng* gen, uint64_t int_bound)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param gen The generator
+  \param int_bound Upper bound (excluded), greater than 0
+  \return A uniform number between 0 and int_bound-1
+  \brief Draws a number in a range without modulo bias
+  \remarks Lemire's multiply-and-shift method, rarely needs a second draw
+*/
+uint64_t boundedRandom(rng* gen, uint64_t int_bound);
+
+/*!
+  \fn uint64_t mixSeed(uint64_t int_seed, uint64_t int_value)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param int_seed A seed
+  \param int_value A value to mix in (game number, thread number...)
+  \return A new seed
+  \brief Derives an independent seed from a seed and a value
+  \remarks None
+*/
+uint64_t mixSeed(uint64_t int_seed, uint64_t int_value);
+
+
+#endif
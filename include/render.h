@@ -0,0 +1,152 @@
+/*!
+  \file render.h
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \brief Header file for render.c
+  \remarks None
+*/
+
+#ifndef _RENDER_H_
+#define _RENDER_H_
+
+/* Additional librairies */
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include "utils.h"
+
+/* Global variables */
+/*! Maximum amount of columns of the minimap */
+#define MINIMAP_WIDTH 32
+/*! Maximum amount of rows of the minimap */
+#define MINIMAP_HEIGHT 8
+
+
+/* Custom types */
+/*! Frame renderer : builds a whole frame in memory and writes it at once */
+typedef struct {
+  int fd;                 /*!< file descriptor the frames are written to */
+  char* buffer;           /*!< reusable frame buffer */
+  size_t size;            /*!< bytes used in the buffer */
+  size_t capacity;        /*!< bytes allocated for the buffer */
+  uint8_t glyph[256];     /*!< glyph of every possible cell (see cellDisplay) */
+  int64_t frames;         /*!< amount of frames written */
+  int64_t frameBytes;     /*!< bytes of the last frame */
+  int64_t frameNs;        /*!< nanoseconds spent building and writing the last frame */
+  int64_t totalBytes;     /*!< bytes of all the frames */
+  int64_t totalNs;        /*!< nanoseconds spent on all the frames */
+  boolean fitView;        /*!< true to fit the view to the terminal before every frame */
+  int footerLines;        /*!< terminal lines kept free below the frame when fitting the view */
+  int viewX;              /*!< first column of the view */
+  int viewY;              /*!< first row of the view */
+  int viewWidth;          /*!< columns in the view */
+  int viewHeight;         /*!< rows in the view */
+  boolean hasFrame;       /*!< true while the screen shows the cells recorded in shadow */
+  uint8_t* shadow;        /*!< glyph of every cell of the view currently on screen */
+  int64_t shadowSize;     /*!< capacity of the shadow */
+  int shadowX;            /*!< first column of the view on screen */
+  int shadowY;            /*!< first row of the view on screen */
+  int shadowWidth;        /*!< columns of the view on screen */
+  int shadowHeight;       /*!< rows of the view on screen */
+  int labelWidth;         /*!< width of the row numbers on screen, first glyph is right after */
+  int bottomLine;         /*!< first screen line below the frame */
+  int mapLine;            /*!< screen line of the minimap, 0 when it is not shown */
+  int mapWidth;           /*!< columns of the minimap */
+  int mapHeight;          /*!< rows of the minimap */
+  int blockWidth;         /*!< columns of the minefield summed up by a minimap character */
+  int blockHeight;        /*!< rows of the minefield summed up by a minimap character */
+  int64_t mapRevealed[MINIMAP_WIDTH*MINIMAP_HEIGHT];  /*!< revealed cells of every minimap block */
+  char mapShadow[MINIMAP_WIDTH*MINIMAP_HEIGHT];       /*!< minimap characters currently on screen */
+  dimensions mapDim;      /*!< dimensions of the minefield the minimap was made for */
+  boolean mapValid;       /*!< true while mapRevealed is up to date */
+  int64_t mapEpoch;       /*!< dirty list epoch already counted in the minimap */
+  int64_t mapSeen;        /*!< dirty list entries of that epoch already counted */
+} renderer;
+
+
+/* Function prototypes */
+/*!
+  \fn void initRenderer(renderer* screen, int int_fd)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param screen The renderer to init
+  \param int_fd File descriptor to write the frames to
+  \brief Creates a renderer and precomputes the glyph of every cell
+  \remarks The view is the whole minefield until fitView is set or the
+  view is moved
+*/
+void initRenderer(renderer* screen, int int_fd);
+
+/*!
+  \fn void freeRenderer(renderer* screen)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param screen The renderer to free
+  \brief Releases the frame buffer of a renderer
+  \remarks None
+*/
+void freeRenderer(renderer* screen);
+
+/*!
+  \fn void renderMinefield(renderer* screen, board* minefield)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param screen The renderer
+  \param minefield The minefield to print
+  \brief Prints the view of the minefield with a single write
+  \remarks Colour escapes are only emitted when the colour changes, so a
+  run of cells of the same colour shares one escape (separators included).
+  When the view is smaller than the minefield, a minimap of the whole
+  minefield follows. Updates the frame measurements of the renderer
+*/
+void renderMinefield(renderer* screen, board* minefield);
+
+/*!
+  \fn void renderMinefieldDiff(renderer* screen, board* minefield)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param screen The renderer
+  \param minefield The minefield to print, with its changes tracked (see trackDirty)
+  \brief Updates the minefield on screen, repainting only the cells of the dirty list
+  \remarks The first frame (or after an overflow of the dirty list, or when
+  the view moved) clears the screen and prints everything. Each repaint moves
+  the cursor to the cell and the cursor ends below the minefield with the
+  rest of the screen cleared. The caller clears the dirty list once it is
+  done with it
+*/
+void renderMinefieldDiff(renderer* screen, board* minefield);
+
+/*!
+  \fn void centreView(renderer* screen, board* minefield, int int_x, int int_y)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param screen The renderer
+  \param minefield The minefield
+  \param int_x x coordinate to centre on
+  \param int_y y coordinate to centre on
+  \brief Moves the view so that a cell is in its middle
+  \remarks The view stays inside the minefield
+*/
+void centreView(renderer* screen, board* minefield, int int_x, int int_y);
+
+/*!
+  \fn void forgetMinimap(renderer* screen)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param screen The renderer
+  \brief Makes the next frame count the revealed cells of the minimap again
+  \remarks The minimap follows the dirty list as if cells were only ever
+  revealed : the caller forgets it once cells were hidden again (undoMove)
+*/
+void forgetMinimap(renderer* screen);
+
+
+#endif
@@ -0,0 +1,72 @@
+/*!
+  \file replay.h
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \brief Header file for replay.c
+  \remarks None
+*/
+
+#ifndef _REPLAY_H_
+#define _REPLAY_H_
+
+/* Additional librairies */
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include "utils.h"
+#include "options.h"
+#include "journal.h"
+
+/* Global variables */
+
+
+/* Custom types */
+/*! Where a replay stopped */
+typedef struct {
+  int64_t from;         /*!< moves before the keyframe the replay started from, 0 without keyframe */
+  int64_t position;     /*!< moves played, the target unless the replay diverged */
+  int64_t diverged;     /*!< first move whose result or following keyframe differs from the journal, -1 if there is none */
+  int outcome;          /*!< OUTCOME_UNFINISHED, OUTCOME_WON or OUTCOME_LOST at the position */
+} replayResult;
+
+
+/* Function prototypes */
+/*!
+  \fn int replayJournal(journalReader* reader, board* minefield, options* opt, int64_t int_target, replayResult* result)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param reader The journal
+  \param minefield The minefield to create
+  \param opt The command line options (--load for the journals of a snapshot, --threads, --verify)
+  \param int_target Amount of moves to play
+  \param result Where to store where the replay stopped
+  \return 0 on success, FILE_ERROR if the minefield can't be created (it
+  is then released)
+  \brief Rebuilds the game of a journal as it was after int_target moves
+  \remarks Starts from the last keyframe before the target : the mines are
+  placed again from the seed, then the hidden and flag planes and the
+  counters of the keyframe are restored and the following moves are
+  played. With --verify, every move is played from the first one. Every
+  keyframe met on the way is checked against the minefield too
+*/
+int replayJournal(journalReader* reader, board* minefield, options* opt, int64_t int_target, replayResult* result);
+
+/*!
+  \fn int runReplay(options* opt)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param opt The command line options
+  \return 0 on success, MOVE_INPUT_ERROR if the replay diverged, the error
+  code otherwise
+  \brief Replays the journal of --replay up to --seek moves (all of them by
+  default) and prints the result as a line of JSON
+  \remarks With --save, the game at that move is saved to a snapshot
+*/
+int runReplay(options* opt);
+
+
+#endif
@@ -0,0 +1,131 @@
+/*!
+  \file server.h
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \brief Header file for server.c
+  \remarks None
+*/
+
+#ifndef _SERVER_H_
+#define _SERVER_H_
+
+/* Additional librairies */
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <pthread.h>
+#include "utils.h"
+#include "options.h"
+#include "random.h"
+#include "headless.h"
+#include "bitboard.h"
+#include "pool.h"
+
+/* Global variables */
+/*! Longest request line, newline included */
+#define SERVER_LINE 256
+/*! Most cells of a game, so that tens of thousands of sessions fit in memory */
+#define SERVER_MAX_CELLS 65536
+/*! Most moves of a "moves" request, each takes at least 6 bytes of the line */
+#define SERVER_MOVES (SERVER_LINE / 6)
+/*! Events an event loop handles per epoll_wait */
+#define SERVER_EVENTS 256
+/*! Connections an event loop accepts before handing the listening socket to another loop */
+#define SERVER_ACCEPTS 16
+
+
+/* Custom types */
+/*! A connection and the game it plays */
+typedef struct session {
+  int fd;               /*!< socket of the connection */
+  board minefield;      /*!< the game, with its dirty list, in an arena of the pool of the loop */
+  bitboard planes;      /*!< bit planes counting the mines on the first reveal, in the same arena */
+  boolean hasGame;      /*!< true once a new command created the minefield */
+  rng gen;              /*!< random number generator of the game */
+  int64_t mines;        /*!< amount of mines to place */
+  boolean placed;       /*!< true once the mines are placed (first reveal) */
+  int state;            /*!< OUTCOME_UNFINISHED, OUTCOME_WON or OUTCOME_LOST */
+  char in[SERVER_LINE]; /*!< bytes received, the last line may be incomplete */
+  int inCount;          /*!< bytes in the input buffer */
+  char* out;            /*!< replies not sent yet */
+  size_t outCount;      /*!< bytes in the output buffer */
+  size_t outSent;       /*!< bytes of the output buffer already sent */
+  size_t outSize;       /*!< capacity of the output buffer */
+  boolean writing;      /*!< true while the loop waits for the socket to accept the replies */
+  boolean closing;      /*!< true to close the connection once the replies are sent */
+  struct session* prev; /*!< previous connection of the loop */
+  struct session* next; /*!< next connection of the loop */
+} session;
+
+/*! What the event loops share */
+typedef struct {
+  int listener;         /*!< listening socket, in the epoll set of every loop */
+  int wake;             /*!< eventfd written once to stop every loop */
+  uint64_t seed;        /*!< game i without a seed of its own uses the stream mixSeed(seed, i) */
+  int64_t nextGame;     /*!< games created, claimed atomically */
+  int64_t open;         /*!< connections open, updated atomically */
+  int64_t peakOpen;     /*!< most connections open at once */
+} server;
+
+/*! An event loop : one per thread, owns the connections it accepted */
+typedef struct {
+  pthread_t thread;     /*!< thread of the loop */
+  server* srv;          /*!< shared state */
+  int epoll;            /*!< epoll set of the loop */
+  session* sessions;    /*!< connections of the loop, closed when it stops */
+  boardPool pool;       /*!< arenas of the games of the loop, reused from one game to the next */
+  int64_t accepted;     /*!< connections accepted */
+  int64_t commands;     /*!< request lines handled */
+  int64_t games;        /*!< games created */
+} serverLoop;
+
+
+/* Function prototypes */
+/*!
+  \fn int openEndpoint(const char* str_address, boolean bool_listen)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param str_address Path of a Unix-domain socket, or HOST:PORT (or :PORT
+  for 127.0.0.1) of a TCP socket
+  \param bool_listen true to listen on the address, false to connect to it
+  \return The socket, -1 on error (after a message on stderr)
+  \brief Opens the socket of the server or of a client
+  \remarks A listening socket is non-blocking. A stale Unix-domain socket
+  left by a previous server is replaced, any other file is not. TCP
+  sockets are opened with TCP_NODELAY
+*/
+int openEndpoint(const char* str_address, boolean bool_listen);
+
+/*!
+  \fn void raiseFileLimit(void)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \brief Raises the limit of open files to its hard limit
+  \remarks Every session is a socket, the usual limit of 1024 is far too low
+*/
+void raiseFileLimit(void);
+
+/*!
+  \fn int runServer(options* opt)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param opt The command line options
+  \return 0 on success, FILE_ERROR if the socket can't be opened
+  \brief Hosts games on the --serve socket until SIGINT, SIGTERM or the end
+  of --seconds, then prints the counters as a line of JSON
+  \remarks Runs an epoll event loop on each of the --threads threads :
+  they all watch the listening socket and a connection stays on the loop
+  that accepted it, with its game, so that nothing is locked. Each loop
+  has a pool of arenas : once warm, a new game allocates nothing. The
+  protocol is made of text lines, one reply line per request :
+  new W H MINES [SEED], click X Y, flag X Y, diff and quit
+*/
+int runServer(options* opt);
+
+
+#endif
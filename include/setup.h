@@ -0,0 +1,68 @@
+/*!
+  \file setup.h
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \brief Header file for setup.c
+  \remarks None
+*/
+
+#ifndef _SETUP_H_
+#define _SETUP_H_
+
+/* Additional librairies */
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <pthread.h>
+#include "utils.h"
+
+/* Global variables */
+/*! Cells of a tile, rounded to whole rows */
+#define SETUP_TILE_CELLS (1 << 20)
+
+
+/* Custom types */
+/*! Tiles of a minefield shared by the threads setting it up */
+typedef struct {
+  board* minefield;         /*!< the minefield */
+  uint64_t seed;            /*!< seed of the minefield, every tile has its own stream */
+  int tileRows;             /*!< rows of a tile, the last one may have less */
+  int64_t tiles;            /*!< amount of tiles */
+  int64_t* tileMines;       /*!< mines of every tile */
+  int64_t words;            /*!< 64-bit words in a packed row of mines */
+  uint64_t* firstRows;      /*!< mines of the first row of every tile, packed by packMineRow */
+  uint64_t* lastRows;       /*!< mines of the last row of every tile, firstRows if tiles have one row */
+  int64_t nextFill;         /*!< first tile no thread has filled yet */
+  int64_t nextCount;        /*!< first tile no thread has counted yet */
+  pthread_barrier_t filled; /*!< passed once every tile has its mines */
+} setupJob;
+
+
+/* Function prototypes */
+/*!
+  \fn void setupMinefieldTiled(board* minefield, dimensions dim_dimensions, int64_t int_mines, uint64_t int_seed, int int_threads)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.2 - halos
+  \param minefield The minefield to create
+  \param dim_dimensions The dimensions of the minefield
+  \param int_mines Amount of mines, at most the amount of cells
+  \param int_seed Seed of the minefield
+  \param int_threads Amount of threads, 0 for one per core
+  \brief Creates a minefield with its mines and counts, tile by tile on
+  several threads
+  \remarks The minefield is split in bands of rows. The amount of mines of
+  every tile is drawn first (the same way placing the mines one by one
+  would spread them), then every tile is cleared and gets its mines from
+  its own stream and packs its first and last rows of mines, then the
+  surrounding mines are counted, reading the rows packed by the tiles
+  around each tile rather than their cells. The minefield only depends on the seed and the
+  dimensions, not on the amount of threads, but differs from the one
+  placeMines gives for the same seed
+*/
+void setupMinefieldTiled(board* minefield, dimensions dim_dimensions, int64_t int_mines, uint64_t int_seed, int int_threads);
+
+
+#endif
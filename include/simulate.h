@@ -0,0 +1,109 @@
+/*!
+  \file simulate.h
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \brief Header file for simulate.c
+  \remarks None
+*/
+
+#ifndef _SIMULATE_H_
+#define _SIMULATE_H_
+
+/* Additional librairies */
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <pthread.h>
+#include "utils.h"
+#include "options.h"
+#include "bitboard.h"
+#include "random.h"
+#include "solver.h"
+
+/* Global variables */
+/*! Games a thread takes at once from the shared counter */
+#define SIMULATION_CHUNK 256
+
+/*! Quantile of the normal distribution for the 95 % confidence interval */
+#define SIMULATION_Z 1.959963984540054
+
+
+/* Custom types */
+/*! A way of playing : plays a whole minefield through click and fills the result */
+typedef void (*strategyFunction)(board* minefield, solver* solv, rng* gen, solverResult* result);
+
+/*! A strategy that can be picked on the command line */
+typedef struct {
+  const char* name;         /*!< name given to --strategy */
+  strategyFunction play;    /*!< function playing a game */
+} strategy;
+
+/*! Games shared by the threads of a simulation */
+typedef struct {
+  dimensions dim;           /*!< dimensions of the minefields */
+  int64_t mines;            /*!< amount of mines */
+  uint64_t seed;            /*!< seed of the simulation, every game has its own stream */
+  int64_t games;            /*!< amount of games to play */
+  int64_t nextGame;         /*!< first game no thread has taken yet */
+  const strategy* strat;    /*!< strategy of every game */
+} simulation;
+
+/*! Thread of a simulation, with its own minefield and counters */
+typedef struct {
+  pthread_t thread;         /*!< the thread */
+  simulation* sim;          /*!< the games to share */
+  board minefield;          /*!< minefield reused by every game of the thread */
+  bitboard planes;          /*!< scratch planes to count the surrounding mines */
+  solver solv;              /*!< solver reused by every game of the thread */
+  rng gen;                  /*!< stream of the current game */
+  int64_t games;            /*!< games played */
+  int64_t won;              /*!< games won */
+  int64_t clicks;           /*!< reveals and flags */
+  int64_t guesses;          /*!< reveals that could hit a mine */
+} simulationWorker;
+
+
+/* Function prototypes */
+/*!
+  \fn const strategy* findStrategy(const char* str_name)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param str_name Name of the strategy
+  \return The strategy, NULL if there is none with that name
+  \brief Looks a strategy up by name
+  \remarks "random" clicks random hidden cells, "solver" plays like --solve
+*/
+const strategy* findStrategy(const char* str_name);
+
+/*!
+  \fn void simulateGames(simulation* sim, simulationWorker* workers, int int_threads)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param sim The games to play
+  \param workers One worker per thread, their counters are filled
+  \param int_threads Amount of threads
+  \brief Plays every game of a simulation on several threads
+  \remarks Game i always uses the stream mixSeed(seed, i), so the results
+  don't depend on the amount of threads. The threads take the games by
+  chunks of SIMULATION_CHUNK and only share the counter of the next game
+*/
+void simulateGames(simulation* sim, simulationWorker* workers, int int_threads);
+
+/*!
+  \fn int runSimulation(options* opt)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param opt The command line options
+  \return Exit code of the program
+  \brief Runs the simulation mode and prints the win rate as a JSON line
+  \remarks The win rate comes with its 95 % Wilson confidence interval
+*/
+int runSimulation(options* opt);
+
+
+#endif
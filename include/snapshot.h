@@ -0,0 +1,88 @@
+/*!
+  \file snapshot.h
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \brief Header file for snapshot.c
+  \remarks None
+*/
+
+#ifndef _SNAPSHOT_H_
+#define _SNAPSHOT_H_
+
+/* Additional librairies */
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include "utils.h"
+
+/* Global variables */
+/*! First bytes of a snapshot file */
+#define SNAPSHOT_MAGIC "MINESNAP"
+/*! Version of the format, to increase with any change of the header or of the cell bits */
+#define SNAPSHOT_VERSION 1
+/*! Bytes of the header, the cells start on the next page */
+#define SNAPSHOT_HEADER_SIZE 4096
+/*! Bytes of the header covered by its checksum, the checksum follows them */
+#define SNAPSHOT_HEADER_USED 96
+/*! Bytes of cells hashed and written at once while saving */
+#define SNAPSHOT_CHUNK (1 << 20)
+
+
+/* Custom types */
+/*! Header of a snapshot, stored little-endian at the start of the file :
+  magic (8 bytes), version, header size, width, height (4 bytes each),
+  seed, the five counters, offset, size and checksum of the cells
+  (8 bytes each), then the checksum of everything before it */
+typedef struct {
+  uint32_t version;         /*!< SNAPSHOT_VERSION */
+  uint32_t headerSize;      /*!< SNAPSHOT_HEADER_SIZE */
+  dimensions dim;           /*!< dimensions of the minefield */
+  uint64_t seed;            /*!< seed the minefield was created with */
+  counters count;           /*!< counters of the minefield */
+  uint64_t cellsOffset;     /*!< offset of the cells in the file, a multiple of the page size */
+  uint64_t cellsSize;       /*!< bytes of cells, cellBytes(dim) */
+  uint64_t cellsChecksum;   /*!< checksum of the cells */
+} snapshotHeader;
+
+
+/* Function prototypes */
+/*!
+  \fn int saveSnapshot(board* minefield, uint64_t int_seed, const char* str_path)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param minefield The minefield to save
+  \param int_seed Seed the minefield was created with
+  \param str_path File to write
+  \return 0 on success, FILE_ERROR otherwise (with a message on stderr)
+  \brief Writes a minefield and its counters to a snapshot file
+  \remarks The cells are written straight from the minefield, hashed chunk
+  by chunk on the way, so saving doesn't need a second copy in memory. The
+  snapshot is written next to str_path, synced, then renamed over it : a
+  crash never leaves a half written snapshot, and a minefield loaded from
+  str_path can be saved back to it
+*/
+int saveSnapshot(board* minefield, uint64_t int_seed, const char* str_path);
+
+/*!
+  \fn int loadSnapshot(board* minefield, uint64_t* ptr_seed, const char* str_path, boolean bool_verify)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param minefield The minefield to create
+  \param ptr_seed Where to store the seed of the minefield
+  \param str_path File to read
+  \param bool_verify true to check the checksum of the cells
+  \return 0 on success, FILE_ERROR otherwise (with a message on stderr)
+  \brief Creates a minefield from a snapshot file
+  \remarks Only the header is read and checked : the cells are mapped
+  privately from the file, pages are read when the game first touches them
+  and the changes never go back to the file. Checking the cells reads the
+  whole file. The minefield is released by freeMinefield as usual
+*/
+int loadSnapshot(board* minefield, uint64_t* ptr_seed, const char* str_path, boolean bool_verify);
+
+
+#endif
@@ -0,0 +1,120 @@
+/*!
+  \file solver.h
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \brief Header file for solver.c
+  \remarks None
+*/
+
+#ifndef _SOLVER_H_
+#define _SOLVER_H_
+
+/* Additional librairies */
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include "utils.h"
+#include "random.h"
+
+/* Global variables */
+
+
+/* Custom types */
+/*! Work queue of the solver : the revealed cells whose surroundings changed */
+typedef struct {
+  dimensions dim;       /*!< dimensions of the minefields it can solve */
+  int64_t* queue;       /*!< ring buffer of cell indices */
+  int64_t head;         /*!< position of the first index in the ring buffer */
+  int64_t length;       /*!< amount of indices in the ring buffer */
+  uint8_t* queued;      /*!< 1 for every cell currently in the queue */
+  double* prob;         /*!< mine probability of every cell, used to guess */
+} solver;
+
+/*! Result of a game played by the solver */
+typedef struct {
+  boolean won;          /*!< true if every safe cell has been revealed */
+  int64_t guesses;      /*!< cells revealed while they could hold a mine, the first click excluded */
+  int64_t reveals;      /*!< cells clicked to reveal them, the first click included */
+  int64_t flags;        /*!< flags placed */
+} solverResult;
+
+
+/* Function prototypes */
+/*!
+  \fn void initSolver(solver* solv, dimensions dim_dimensions)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param solv The solver to init
+  \param dim_dimensions The dimensions of the minefields to solve
+  \brief Allocates the work queue of a solver
+  \remarks A solver can play any amount of minefields of these dimensions
+*/
+void initSolver(solver* solv, dimensions dim_dimensions);
+
+/*!
+  \fn void freeSolver(solver* solv)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param solv The solver to free
+  \brief Releases the work queue of a solver
+  \remarks None
+*/
+void freeSolver(solver* solv);
+
+/*!
+  \fn int64_t deduceMoves(solver* solv, board* minefield, int64_t* ptr_flags)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param solv The solver
+  \param minefield The minefield, with its changes tracked (see trackDirty)
+  \param ptr_flags Where to add the amount of flags placed, may be NULL
+  \return The amount of moves played, -1 if a mine has been revealed
+  \brief Flags and reveals through click every cell that can be deduced
+  from what the player sees, until nothing more can be deduced
+  \remarks Only the revealed numbers and the flags are read. The cells
+  changed since the last call are read from the dirty list, which is
+  cleared. Uses the single cell rule (the number is reached, or needs every
+  hidden neighbour) and the pair rule on numbers up to 2 cells apart
+  (1-2-1, subsets)
+*/
+int64_t deduceMoves(solver* solv, board* minefield, int64_t* ptr_flags);
+
+/*!
+  \fn int64_t pickUnknownCell(board* minefield, rng* gen)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param minefield The minefield, with at least a hidden cell without a flag
+  \param gen Random number generator
+  \return Index of a random hidden cell without a flag
+  \brief Picks a random cell to guess
+  \remarks A few random draws, then the first unknown cell from a random start
+*/
+int64_t pickUnknownCell(board* minefield, rng* gen);
+
+/*!
+  \fn void solveMinefield(solver* solv, board* minefield, int int_x, int int_y, rng* gen, solverResult* result)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.2 - budget
+  \param solv The solver
+  \param minefield The minefield, nothing revealed yet
+  \param int_x x coordinate of the first click
+  \param int_y y coordinate of the first click
+  \param gen Random number generator used to guess
+  \param result Where to store the result
+  \brief Plays a whole game, revealing the cell least likely to hold a
+  mine when nothing can be deduced
+  \remarks The changes of the minefield are tracked from then on. A cell
+  found safe by the probabilities is not a guess. When they can't be
+  computed within PROBABILITY_QUICK_BUDGET, a random hidden cell is guessed
+*/
+void solveMinefield(solver* solv, board* minefield, int int_x, int int_y, rng* gen, solverResult* result);
+
+
+#endif
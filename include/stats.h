@@ -0,0 +1,145 @@
+/*!
+  \file stats.h
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \brief Header file for stats.c
+  \remarks Compiled with NO_STATS (make STATS=0), the instrumentation
+  macros expand to nothing
+*/
+
+#ifndef _STATS_H_
+#define _STATS_H_
+
+/* Additional librairies */
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include "utils.h"
+
+/* Global variables */
+/*! Latency buckets : one per nanosecond below 32 ns, then 16 per power of two (6 % wide) */
+#define STATS_BUCKETS 640
+
+
+/* Custom types */
+/*! Log-bucketed latency histogram */
+typedef struct {
+  int64_t count;        /*!< latencies recorded */
+  int64_t totalNs;      /*!< sum of the latencies */
+  int64_t maxNs;        /*!< highest latency */
+  int64_t buckets[STATS_BUCKETS]; /*!< latencies per bucket (see latencyBucket in stats.c) */
+} latencyHistogram;
+
+/*! Measurements of the engine, for --stats */
+typedef struct {
+  latencyHistogram click;       /*!< latency of click */
+  latencyHistogram clickBatch;  /*!< latency of clickBatch */
+  latencyHistogram reveal;      /*!< latency of reveal */
+  latencyHistogram userHasWon;  /*!< latency of userHasWon */
+  latencyHistogram countFlags;  /*!< latency of countFlags */
+  latencyHistogram frame;       /*!< time to build and write a frame */
+  latencyHistogram moveToFrame; /*!< time from a move to the frame showing it */
+  int64_t cellsVisited;         /*!< empty cells whose neighbours reveal looked at */
+  int64_t cellsRevealed;        /*!< cells revealed by reveal */
+  int64_t bytesRendered;        /*!< bytes of the frames */
+  int64_t frames;               /*!< frames written */
+  int64_t moveStart;            /*!< time of the move waiting for its frame, 0 if there is none */
+} engineStats;
+
+/*! Measurements of the calling thread, NULL when they are not recorded */
+extern __thread engineStats* currentStats;
+
+#ifdef NO_STATS
+/*! Declares a clock, started only if the thread records measurements */
+#define STATS_CLOCK(var)
+/*! Records the time elapsed since a clock in a histogram of currentStats */
+#define STATS_LATENCY(hist, var)
+/*! Adds to a counter of currentStats */
+#define STATS_ADD(field, n)
+/*! Starts the clock of a move, stopped by the next frame */
+#define STATS_MOVE()
+/*! Records a frame of int_bytes started at var */
+#define STATS_FRAME(int_bytes, var)
+#else
+/*! Declares a clock, started only if the thread records measurements */
+#define STATS_CLOCK(var) int64_t var = (currentStats != NULL) ? nowNs() : 0;
+/*! Records the time elapsed since a clock in a histogram of currentStats */
+#define STATS_LATENCY(hist, var) do { if (currentStats != NULL) recordLatency(&currentStats->hist, nowNs() - (var)); } while (0)
+/*! Adds to a counter of currentStats */
+#define STATS_ADD(field, n) do { if (currentStats != NULL) currentStats->field += (n); } while (0)
+/*! Starts the clock of a move, stopped by the next frame */
+#define STATS_MOVE() do { if (currentStats != NULL) currentStats->moveStart = nowNs(); } while (0)
+/*! Records a frame of int_bytes started at var */
+#define STATS_FRAME(int_bytes, var) do { if (currentStats != NULL) recordFrame((int_bytes), (var)); } while (0)
+#endif
+
+
+/* Function prototypes */
+/*!
+  \fn void recordLatency(latencyHistogram* hist, int64_t int_ns)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param hist The histogram
+  \param int_ns Latency, in nanoseconds
+  \brief Adds a latency to a histogram
+  \remarks O(1), a few instructions
+*/
+void recordLatency(latencyHistogram* hist, int64_t int_ns);
+
+/*!
+  \fn void mergeHistogram(latencyHistogram* hist, const latencyHistogram* other)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param hist The histogram receiving the latencies
+  \param other The histogram to add
+  \brief Adds the latencies of a histogram to another one
+  \remarks None
+*/
+void mergeHistogram(latencyHistogram* hist, const latencyHistogram* other);
+
+/*!
+  \fn int64_t latencyPercentile(const latencyHistogram* hist, double int_quantile)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param hist The histogram
+  \param int_quantile Quantile, between 0 and 1
+  \return The latency of the quantile, in nanoseconds, 0 for an empty histogram
+  \brief Reads a quantile of a histogram
+  \remarks Rounded down to its bucket, at most 6 % below. The last bucket
+  holds the slowest latencies : its quantile is the highest latency
+*/
+int64_t latencyPercentile(const latencyHistogram* hist, double int_quantile);
+
+/*!
+  \fn void recordFrame(int64_t int_bytes, int64_t int_start)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param int_bytes Bytes of the frame
+  \param int_start Time the frame was started at (nowNs)
+  \brief Records a frame in currentStats, and the latency of the move it
+  shows if there is one
+  \remarks Called through STATS_FRAME
+*/
+void recordFrame(int64_t int_bytes, int64_t int_start);
+
+/*!
+  \fn void startStats(void)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \brief Records the measurements of the calling thread and prints them as
+  a line of JSON on stderr when the program exits
+  \remarks Only the calling thread is measured : the threads of the
+  simulation, the generator or the server are not. Without the
+  instrumentation (NO_STATS), prints a message instead
+*/
+void startStats(void);
+
+
+#endif
@@ -0,0 +1,150 @@
+/*!
+  \file undo.h
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \brief Header file for undo.c
+  \remarks None
+*/
+
+#ifndef _UNDO_H_
+#define _UNDO_H_
+
+/* Additional librairies */
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "utils.h"
+
+/* Global variables */
+/*! The cells of a reveal are stored as runs of consecutive indices */
+#define UNDO_RUNS 0
+/*! The cells of a reveal are stored as a bitmap from the lowest index */
+#define UNDO_BITMAP 1
+
+
+/* Custom types */
+/*! History of the clicks of a minefield, as the cells each one changed */
+typedef struct undoLog {
+  uint8_t* bytes;       /*!< records of the moves, one after the other */
+  size_t used;          /*!< bytes of the records */
+  size_t size;          /*!< capacity of the records */
+  size_t* offsets;      /*!< offset of each record */
+  int64_t moves;        /*!< moves recorded */
+  int64_t offsetsSize;  /*!< capacity of the offsets */
+  int64_t position;     /*!< moves applied, the moves after them can be redone */
+  int64_t* cells;       /*!< cells revealed by the move being played */
+  int64_t nCells;       /*!< amount of cells revealed by the move being played */
+  int64_t cellsSize;    /*!< capacity of the revealed cells */
+  int64_t* flagged;     /*!< revealed cells that had a flag */
+  int64_t nFlagged;     /*!< amount of revealed cells that had a flag */
+  int64_t flaggedSize;  /*!< capacity of the flagged cells */
+  int64_t* runs;        /*!< work buffer of the encoding : first index and length of each run */
+  int64_t runsSize;     /*!< capacity of the runs, in indices */
+  uint64_t* bits;       /*!< work buffer of the encoding : bitmap of the cells */
+  int64_t bitsSize;     /*!< capacity of the bitmap, in words */
+  boolean failed;       /*!< true if the cells of the move being played couldn't all be kept */
+} undoLog;
+
+
+/* Function prototypes */
+/*!
+  \fn void initUndo(undoLog* undo, board* minefield)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param undo The history to init
+  \param minefield The minefield whose clicks are recorded
+  \brief Creates an empty history and records the clicks of a minefield in it
+  \remarks Allocates nothing until the first click
+*/
+void initUndo(undoLog* undo, board* minefield);
+
+/*!
+  \fn void freeUndo(undoLog* undo, board* minefield)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param undo The history
+  \param minefield The minefield whose clicks are recorded
+  \brief Stops recording the clicks and frees the history
+  \remarks None
+*/
+void freeUndo(undoLog* undo, board* minefield);
+
+/*!
+  \fn void beginUndoMove(undoLog* undo)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param undo The history
+  \brief Starts collecting the cells changed by a click
+  \remarks Called by click and clickBatch
+*/
+void beginUndoMove(undoLog* undo);
+
+/*!
+  \fn void recordUndoCell(undoLog* undo, int64_t int_index, boolean bool_flag)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param undo The history
+  \param int_index Index of a cell the click reveals, or of the mine it sets off
+  \param bool_flag true if the cell had a flag
+  \brief Collects a cell changed by the click being played
+  \remarks Called by reveal for every cell, and by click for a mine that
+  wasn't set off yet
+*/
+void recordUndoCell(undoLog* undo, int64_t int_index, boolean bool_flag);
+
+/*!
+  \fn void endUndoMove(undoLog* undo, int64_t int_index, int int_action, int int_result)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param undo The history
+  \param int_index Index of the clicked cell
+  \param int_action 1 to reveal, 2 to mark
+  \param int_result Result of click
+  \brief Adds the click to the history, in place of the moves that could be
+  redone
+  \remarks A mark or a mine takes a few bytes. The cells of a reveal are
+  sorted into runs of consecutive indices, or put in a bitmap from the
+  lowest one when it is smaller, so time and memory only depend on the
+  cells the click revealed. If they couldn't be kept, the history is
+  emptied : the moves before can't be undone any more
+*/
+void endUndoMove(undoLog* undo, int64_t int_index, int int_action, int int_result);
+
+/*!
+  \fn int undoMove(undoLog* undo, board* minefield)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param undo The history
+  \param minefield The minefield
+  \return The result of the click undone (1, or 0 if it revealed a mine),
+  -1 if there is none
+  \brief Puts back the cells and the counters as they were before the last
+  click applied
+  \remarks Only the cells of the click are touched, and added to the dirty
+  list. The mines stay where they are
+*/
+int undoMove(undoLog* undo, board* minefield);
+
+/*!
+  \fn int redoMove(undoLog* undo, board* minefield)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param undo The history
+  \param minefield The minefield
+  \return The result of the click redone (1, or 0 if it revealed a mine),
+  -1 if there is none
+  \brief Plays again the first click undone
+  \remarks The cells are restored from the history without any flood fill
+*/
+int redoMove(undoLog* undo, board* minefield);
+
+
+#endif
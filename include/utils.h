@@ -14,12 +14,19 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#include <stdint.h>
 
 /* Global variables */
 /*! Memory allocation error code */
 #define MEMORY_ALLOCATION_ERROR -1
 /*! Int input error code */
 #define INT_INPUT_ERROR -2
+/*! Command line argument error code */
+#define ARGUMENT_ERROR -3
+/*! File error code */
+#define FILE_ERROR -4
+/*! Malformed move stream error code */
+#define MOVE_INPUT_ERROR -5
 
 /*! Clear screen macro */
 #define clrscr() printf("\e[1;1H\e[2J")
@@ -37,6 +44,25 @@
 /*! ANSI cyan colour */
 #define CYAN "\e[0;36m"
 
+/*! Alignment of the cell storage (one cache line) */
+#define CELL_ALIGNMENT 64
+
+/*! Mask of the amount of surrounding mines in a packed cell */
+#define CELL_COUNT 0x0F
+/*! Bit set if the cell has a mine on it */
+#define CELL_MINE 0x10
+/*! Bit set until the user clicks on the cell */
+#define CELL_HIDDEN 0x20
+/*! Bit set while the user has a flag on the cell */
+#define CELL_FLAG 0x40
+/*! Bit set when the cell has to be displayed as a bomb */
+#define CELL_BOMB 0x80
+
+/*! Index of the cell (x, y) in the row-major cell storage */
+#define CELL_INDEX(dim, x, y) ((int64_t)(y) * (dim).width + (x))
+/*! The cell (x, y) of a minefield */
+#define CELL_AT(minefield, x, y) ((minefield)->cells[CELL_INDEX((minefield)->dim, (x), (y))])
+
 
 /* Custom types */
 /*! Create a boolean type in C */
@@ -45,14 +71,10 @@ typedef enum{
   true = 1     /*!< True is 1 so I can do if(true) ... */
 } boolean;
 
-/*! Custom cell type for the game of minesweeper */
-typedef struct{
-  boolean hasMine;        /*!< true if cell has a mine on it */
-  boolean isHidden;       /*!< true until user clicks on it */
-  boolean hasFlag;        /*!< false until user puts a flag on it */
-  int surroundingMines;   /*!< Contains the amount of surrounding mines */
-  char toDisplay;         /*!< Contains the text to display on screen */
-} cell;
+/*! Custom cell type for the game of minesweeper, packed in one byte :
+  the low nibble holds the amount of surrounding mines and the high
+  nibble the CELL_MINE, CELL_HIDDEN, CELL_FLAG and CELL_BOMB bits */
+typedef uint8_t cell;
 
 /*! Type to store dimensions */
 typedef struct {
@@ -60,55 +82,299 @@ typedef struct {
   int height;   /*!< height of the minefield */
 } dimensions;
 
+/*! Live counters of a game, updated by every function that changes a cell */
+typedef struct {
+  int64_t mines;        /*!< mines in the minefield */
+  int64_t flags;        /*!< flags placed by the user */
+  int64_t validFlags;   /*!< flags placed on a mine */
+  int64_t hiddenSafe;   /*!< hidden cells without a mine */
+  int64_t hiddenMines;  /*!< hidden mines without a flag */
+} counters;
 
-/* Function prototypes */
+/*! Custom minefield type : every cell lives in a single aligned allocation */
+typedef struct board {
+  cell* cells;        /*!< width*height cells, row after row (see CELL_INDEX) */
+  dimensions dim;     /*!< dimensions of the minefield */
+  counters count;     /*!< counters of the cells, kept up to date incrementally */
+  int64_t* queue;     /*!< reusable work buffer of the flood fill (ring of cell indices) */
+  int64_t queueSize;  /*!< capacity of the work buffer */
+  int64_t* dirty;     /*!< indices of the cells changed since the last clearDirty */
+  int64_t dirtyCount; /*!< amount of indices in the dirty list */
+  int64_t dirtySize;  /*!< capacity of the dirty list */
+  int64_t dirtyLimit; /*!< maximum length of the dirty list, 0 when changes are not tracked */
+  boolean dirtyOverflow; /*!< true if more than dirtyLimit cells changed (the list is incomplete) */
+  int64_t dirtyEpoch; /*!< incremented by every clearDirty, tells consumers the list was emptied */
+  void* mapping;      /*!< file mapping holding the cells (see snapshot.h), NULL if they were allocated */
+  size_t mappingSize; /*!< bytes of the file mapping */
+  void* arena;        /*!< single allocation holding the cells and the work buffers (see pool.h), NULL otherwise */
+  struct journalWriter* journal; /*!< journal the clicks are appended to (see journal.h), NULL if they aren't recorded */
+  void (*onClick)(struct journalWriter* journal, struct board* minefield, int64_t int_index, int int_action, int int_result); /*!< called by click with the journal, NULL if the clicks aren't recorded */
+  struct undoLog* undo; /*!< history the clicks are added to (see undo.h), NULL if they can't be undone */
+} board;
+
+
+/* Inline functions */
 /*!
-  \fn void printMinefield(cell** minefield, dimensions dim_dimensions)
+  \fn static inline int64_t cellCount(dimensions dim_dimensions)
   \author L.Draescher <draescherl@eisti.eu>
-  \date 17/12/2020
+  \date 18/10/2026
   \version 0.1 - first draft
-  \param minefield The minefield to print
   \param dim_dimensions The dimensions of the minefield
-  \brief Prints the minefield to the terminal
+  \return The amount of cells in the minefield
+  \brief Computes width*height without overflowing an int
   \remarks None
 */
-void printMinefield(cell** minefield, dimensions dim_dimensions);
+static inline int64_t cellCount(dimensions dim_dimensions)
+{
+  return((int64_t)dim_dimensions.width * dim_dimensions.height);
+}
 
 /*!
-  \fn void initMinefield(cell** minefield, dimensions dim_dimensions)
+  \fn static inline size_t cellBytes(dimensions dim_dimensions)
   \author L.Draescher <draescherl@eisti.eu>
-  \date 15/12/2020
+  \date 18/10/2026
   \version 0.1 - first draft
-  \param minefield The minefield to init
   \param dim_dimensions The dimensions of the minefield
-  \brief Creates a minefield and initializes all the values
-  \remarks The minefield is square
+  \return The bytes allocated for the cells of the minefield
+  \brief Rounds the storage of the cells up to a whole number of cache lines
+  \remarks None
 */
-void initMinefield(cell** minefield, dimensions dim_dimensions);
+static inline size_t cellBytes(dimensions dim_dimensions)
+{
+  return(((size_t)cellCount(dim_dimensions) + CELL_ALIGNMENT - 1) & ~((size_t)CELL_ALIGNMENT - 1));
+}
 
 /*!
-  \fn int intInput(void)
+  \fn static inline uint64_t readLe64(const uint8_t* ptr_bytes)
   \author L.Draescher <draescherl@eisti.eu>
-  \date 13/10/2020
+  \date 18/10/2026
   \version 0.1 - first draft
-  \return The user's input
-  \brief This function makes sure the user inputs an int
+  \param ptr_bytes 8 bytes
+  \return The little-endian number they hold
+  \brief Reads a little-endian number whatever the endianness of the machine
+  \remarks Compiled to a single load on little-endian machines
+*/
+static inline uint64_t readLe64(const uint8_t* ptr_bytes)
+{
+  /* Variables */
+  uint64_t int_n;
+  int i;
+
+  int_n = 0;
+  for (i = 7; i >= 0; i--) int_n = (int_n << 8) | ptr_bytes[i];
+
+  return(int_n);
+}
+
+/*!
+  \fn static inline void writeLe64(uint8_t* ptr_bytes, uint64_t int_n)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param ptr_bytes 8 bytes to fill
+  \param int_n The number to write
+  \brief Writes a little-endian number whatever the endianness of the machine
   \remarks None
 */
-int intInput(void);
+static inline void writeLe64(uint8_t* ptr_bytes, uint64_t int_n)
+{
+  /* Variables */
+  int i;
+
+  for (i = 0; i < 8; i++) ptr_bytes[i] = (uint8_t)(int_n >> (8 * i));
+}
 
 /*!
-  \fn int countFlags(cell** minefield, dimensions dim_dimensions)
+  \fn static inline uint32_t readLe32(const uint8_t* ptr_bytes)
   \author L.Draescher <draescherl@eisti.eu>
-  \date 19/12/2020
+  \date 18/10/2026
   \version 0.1 - first draft
-  \param minefield The minefield
+  \param ptr_bytes 4 bytes
+  \return The little-endian number they hold
+  \brief Reads a little-endian number whatever the endianness of the machine
+  \remarks None
+*/
+static inline uint32_t readLe32(const uint8_t* ptr_bytes)
+{
+  return((uint32_t)ptr_bytes[0] | ((uint32_t)ptr_bytes[1] << 8) | ((uint32_t)ptr_bytes[2] << 16) | ((uint32_t)ptr_bytes[3] << 24));
+}
+
+/*!
+  \fn static inline void writeLe32(uint8_t* ptr_bytes, uint32_t int_n)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param ptr_bytes 4 bytes to fill
+  \param int_n The number to write
+  \brief Writes a little-endian number whatever the endianness of the machine
+  \remarks None
+*/
+static inline void writeLe32(uint8_t* ptr_bytes, uint32_t int_n)
+{
+  /* Variables */
+  int i;
+
+  for (i = 0; i < 4; i++) ptr_bytes[i] = (uint8_t)(int_n >> (8 * i));
+}
+
+/*!
+  \fn static inline char cellDisplay(cell cell_c)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param cell_c The cell
+  \return The text to display on screen for this cell
+  \brief Decodes the display state of a packed cell
+  \remarks 'b' bomb, 'f' flag, 'h' hidden, 'd' no adjacent mines, '1'..'8' otherwise
+*/
+static inline char cellDisplay(cell cell_c)
+{
+  if (cell_c & CELL_BOMB) return('b');
+  if (cell_c & CELL_FLAG) return('f');
+  if (cell_c & CELL_HIDDEN) return('h');
+  return( ((cell_c & CELL_COUNT) == 0) ? 'd' : (cell_c & CELL_COUNT) + '0' );
+}
+
+
+/* Function prototypes */
+/*!
+  \fn int newMinefield(board* minefield, dimensions dim_dimensions)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param minefield The minefield to create
   \param dim_dimensions The dimensions of the minefield
+  \return 0 on success, MEMORY_ALLOCATION_ERROR otherwise
+  \brief Creates a minefield without initializing its cells
+  \remarks The caller writes every cell (and the padding up to
+  CELL_ALIGNMENT), or calls resetMinefield. Never prints nor exits, see
+  allocMinefield in console.h for the program
+*/
+int newMinefield(board* minefield, dimensions dim_dimensions);
+
+/*!
+  \fn void attachMinefield(board* minefield, cell* ptr_cells, dimensions dim_dimensions)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param minefield The minefield to create
+  \param ptr_cells cellBytes(dim_dimensions) bytes aligned on CELL_ALIGNMENT
+  \param dim_dimensions The dimensions of the minefield
+  \brief Creates a minefield around cells already in memory
+  \remarks The counters are those of a minefield without any mine, the
+  caller sets them. freeMinefield frees the cells, unless mapping is set
+*/
+void attachMinefield(board* minefield, cell* ptr_cells, dimensions dim_dimensions);
+
+/*!
+  \fn void freeMinefield(board* minefield)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.2 - arenas
+  \param minefield The minefield to free
+  \brief Releases the memory of a minefield created by newMinefield
+  \remarks The cells of a minefield loaded from a snapshot are unmapped,
+  the arena of a minefield taken from a pool is freed at once (see
+  releaseMinefield to give it back to the pool instead)
+*/
+void freeMinefield(board* minefield);
+
+/*!
+  \fn void resetMinefield(board* minefield)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param minefield The minefield to reset
+  \brief Brings a minefield back to the state initMinefield leaves it in,
+  keeping its memory
+  \remarks The work buffers are kept, the dirty list is emptied and the
+  changes stay tracked with the same limit
+*/
+void resetMinefield(board* minefield);
+
+/*!
+  \fn void trackDirty(board* minefield, int64_t int_limit)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param minefield The minefield
+  \param int_limit Maximum length of the dirty list, 0 to stop tracking
+  \brief Starts (or stops) recording the cells changed by click and reveal
+  \remarks Clears the dirty list
+*/
+void trackDirty(board* minefield, int64_t int_limit);
+
+/*!
+  \fn void clearDirty(board* minefield)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param minefield The minefield
+  \brief Empties the dirty list, once every consumer has read it
+  \remarks None
+*/
+void clearDirty(board* minefield);
+
+/*!
+  \fn boolean growDirty(board* minefield)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.4 - capped arenas
+  \param minefield The minefield
+  \return false on allocation error, the capacity is then unchanged
+  \brief Doubles the capacity of the dirty list
+  \remarks The list of a minefield taken from a pool never grows : it
+  holds one index per POOL_DIRTY_SHARE cells (see pool.h) and overflows
+  once it is full
+*/
+boolean growDirty(board* minefield);
+
+/*!
+  \fn int64_t nowNs(void)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \return Current time in nanoseconds
+  \brief Reads the monotonic clock, used to measure durations
+  \remarks None
+*/
+int64_t nowNs(void);
+
+/*!
+  \fn int64_t countFlags(board* minefield)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 19/12/2020
+  \version 0.3 - stats
+  \param minefield The minefield
   \return Number of flags the user has placed
   \brief Counts and returns the amount of flags the user has placed
-  \remarks None
+  \remarks Reads the live counter, O(1). Measured with --stats (see stats.h)
+*/
+int64_t countFlags(board* minefield);
+
+
+/* Inline functions using the prototypes above */
+/*!
+  \fn static inline void markDirty(board* minefield, int64_t int_index)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param minefield The minefield
+  \param int_index Index of the cell that changed
+  \brief Adds a cell to the dirty list if changes are tracked
+  \remarks Past dirtyLimit cells, or if the list can't grow, only
+  dirtyOverflow is set : consumers then look at every cell
 */
-int countFlags(cell** minefield, dimensions dim_dimensions);
+static inline void markDirty(board* minefield, int64_t int_index)
+{
+  if (minefield->dirtyLimit == 0) return;
+  if ( (minefield->dirtyCount >= minefield->dirtyLimit) ||
+       ( (minefield->dirtyCount == minefield->dirtySize) && (growDirty(minefield) == false) ) ) {
+    minefield->dirtyOverflow = true;
+    return;
+  }
+  minefield->dirty[minefield->dirtyCount++] = int_index;
+}
 
 
 #endif
\ No newline at end of file
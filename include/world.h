@@ -0,0 +1,197 @@
+/*!
+  \file world.h
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \brief Header file for world.c
+  \remarks None
+*/
+
+#ifndef _WORLD_H_
+#define _WORLD_H_
+
+/* Additional librairies */
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include "utils.h"
+#include "options.h"
+#include "bitboard.h"
+#include "headless.h"
+
+/* Global variables */
+/*! Log2 of the side of a chunk */
+#define WORLD_CHUNK_BITS 6
+/*! Side of a chunk, in cells (one 64-bit word of mines per row) */
+#define WORLD_CHUNK (1 << WORLD_CHUNK_BITS)
+/*! Cells of a chunk */
+#define WORLD_CHUNK_CELLS (WORLD_CHUNK * WORLD_CHUNK)
+
+/*! Lowest density of mines, in percent : below it, the empty cells of the
+  infinite minefield form unbounded regions and a reveal could never end */
+#define WORLD_MIN_DENSITY 12
+/*! Highest density of mines, in percent */
+#define WORLD_MAX_DENSITY 90
+
+/*! Entry of a chunk evicted with every safe cell revealed and no flag */
+#define WORLD_RESOLVED 1
+/*! Entry of a chunk evicted with every safe cell revealed and a flag on every mine */
+#define WORLD_RESOLVED_FLAGGED 2
+
+/*! Default width of the view of the interactive game (--width) */
+#define WORLD_VIEW_WIDTH 30
+/*! Default height of the view of the interactive game (--height) */
+#define WORLD_VIEW_HEIGHT 16
+
+
+/* Custom types */
+/*! Chunk of WORLD_CHUNK x WORLD_CHUNK cells of the infinite minefield */
+typedef struct {
+  cell cells[WORLD_CHUNK_CELLS]; /*!< packed cells, row after row */
+  int64_t cx;           /*!< x coordinate of the chunk (x of its cells >> WORLD_CHUNK_BITS) */
+  int64_t cy;           /*!< y coordinate of the chunk */
+  int mines;            /*!< mines of the chunk */
+  int hiddenSafe;       /*!< hidden cells without a mine */
+  int flags;            /*!< flags placed on the chunk */
+  int validFlags;       /*!< flags placed on a mine */
+  boolean queued;       /*!< true while the chunk is in the eviction queue */
+} worldChunk;
+
+/*! Entry of the chunk table : a resident chunk or an evicted resolved one */
+typedef struct {
+  uint64_t key;         /*!< coordinates of the chunk (see chunkKey) */
+  worldChunk* chunk;    /*!< the chunk, NULL once it has been evicted (or for an empty entry) */
+  int resolved;         /*!< 0 for an empty or resident entry, WORLD_RESOLVED or WORLD_RESOLVED_FLAGGED once evicted */
+} worldEntry;
+
+/*! Infinite minefield : the mines of a chunk only depend on the seed and
+  its coordinates, chunks are created when a click or a view reaches them */
+typedef struct {
+  uint64_t seed;        /*!< seed of the minefield */
+  uint32_t threshold;   /*!< a cell holds a mine when its 16-bit draw is below it */
+  worldEntry* entries;  /*!< chunk table, open addressing with linear probing */
+  int64_t tableSize;    /*!< capacity of the table, a power of two */
+  int64_t used;         /*!< entries of the table, resident or evicted */
+  int64_t resident;     /*!< chunks in memory */
+  int64_t cacheLimit;   /*!< resident chunks above which the resolved ones are evicted */
+  worldChunk** queue;   /*!< resolved chunks, in the order they were resolved, the next ones to evict */
+  int64_t queueHead;    /*!< first chunk of the queue not looked at yet */
+  int64_t queueCount;   /*!< chunks in the queue, the ones before queueHead included */
+  int64_t queueSize;    /*!< capacity of the queue */
+  int64_t* stack;       /*!< coordinates (x, y) of the empty cells the flood fill still has to visit */
+  int64_t stackSize;    /*!< capacity of the stack, in coordinates */
+  board halo;           /*!< scratch minefield of a chunk and the cells around it, to count the mines */
+  bitboard planes;      /*!< bit planes of the scratch minefield */
+  int64_t revealed;     /*!< safe cells revealed */
+  int64_t flags;        /*!< flags placed */
+  int64_t validFlags;   /*!< flags placed on a mine */
+  int64_t created;      /*!< chunks created, again for the evicted ones */
+  int64_t evicted;      /*!< chunks evicted */
+  int64_t peakResident; /*!< most chunks in memory at once */
+} world;
+
+
+/* Function prototypes */
+/*!
+  \fn void initWorld(world* field, uint64_t int_seed, int int_density, int64_t int_cacheLimit)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param field The infinite minefield to init
+  \param int_seed Seed of the minefield
+  \param int_density Percent of cells holding a mine, WORLD_MIN_DENSITY to WORLD_MAX_DENSITY
+  \param int_cacheLimit Resident chunks above which the resolved ones are evicted
+  \brief Creates an infinite minefield, without any chunk
+  \remarks Kills the program on allocation error, like initMinefield
+*/
+void initWorld(world* field, uint64_t int_seed, int int_density, int64_t int_cacheLimit);
+
+/*!
+  \fn void freeWorld(world* field)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param field The infinite minefield
+  \brief Releases every chunk and the table of an infinite minefield
+  \remarks None
+*/
+void freeWorld(world* field);
+
+/*!
+  \fn cell worldCell(world* field, int64_t int_x, int64_t int_y)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param field The infinite minefield
+  \param int_x x coordinate of the cell
+  \param int_y y coordinate of the cell
+  \return The packed cell, as it would be displayed
+  \brief Reads a cell of the infinite minefield, for a view
+  \remarks Creates the chunk of the cell if no click reached it yet, see
+  playInfinite
+*/
+cell worldCell(world* field, int64_t int_x, int64_t int_y);
+
+/*!
+  \fn int worldClick(world* field, int64_t int_x, int64_t int_y, int int_action)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param field The infinite minefield
+  \param int_x x coordinate to click
+  \param int_y y coordinate to click
+  \param int_action 1 to reveal, 2 to mark
+  \return 0 if the user clicks on a mine, -1 if the cell is not clickable, 1 otherwise
+  \brief Performs a user 'click' on the infinite minefield, like click
+  \remarks The flood fill creates the chunks it reaches. Once the click is
+  done, if more than cacheLimit chunks are in memory, the resolved ones
+  (every safe cell revealed, and either no flag or a flag on every mine)
+  are evicted, oldest first : only their entry is kept and they are
+  created again, resolved, if a click or a view reaches them
+*/
+int worldClick(world* field, int64_t int_x, int64_t int_y, int int_action);
+
+/*!
+  \fn size_t worldBytes(world* field)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param field The infinite minefield
+  \return The bytes of the resident chunks and of the chunk table
+  \brief Measures the memory of an infinite minefield
+  \remarks None
+*/
+size_t worldBytes(world* field);
+
+/*!
+  \fn int runInfinite(options* opt, moveStream* stream)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param opt The command line options
+  \param stream The moves to play
+  \return 0 on success, the error code otherwise
+  \brief Plays the move stream of the headless mode on an infinite
+  minefield and prints the result as a line of JSON
+  \remarks Coordinates may be negative, the game only ends on a mine
+*/
+int runInfinite(options* opt, moveStream* stream);
+
+/*!
+  \fn int playInfinite(options* opt)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param opt The command line options
+  \return 0
+  \brief Plays the infinite minefield interactively, through a view of
+  --width x --height cells (30x16 by default)
+  \remarks The view reads its cells with worldCell, which creates the
+  chunks it reaches. Coordinates are entered in the view, the view moves
+  with action 3 like the view of the minefield of the classic game
+*/
+int playInfinite(options* opt);
+
+
+#endif
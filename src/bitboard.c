@@ -0,0 +1,337 @@
+/*!
+  \file bitboard.c
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \brief Bitboard engine
+  \remarks None
+
+  Counts the surrounding mines of a whole row at
+  once : the mines are stored as bit planes (one bit
+  per cell, 64 cells per word) and the eight
+  neighbours are summed with bitwise adders on
+  shifted words. On x86, the AVX2 version handles 4
+  words per step and is picked at run time when
+  available; other targets only build the scalar
+  version.
+
+*/
+
+#include "bitboard.h"
+#include "minesweeper.h"
+#include "preset.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+/*! The AVX2 version is compiled, and used if the processor has AVX2 */
+#define BITBOARD_AVX2
+#endif
+
+
+
+void packMineRow(board* minefield, int int_y, uint64_t* ptr_row, int64_t int_words)
+{
+  /* Variables */
+  int64_t int_x;
+  int64_t int_width;
+  uint64_t int_bytes;
+  cell* cell_row;
+
+  memset(ptr_row, 0, int_words * sizeof(uint64_t));
+  if ( (int_y < 0) || (int_y >= minefield->dim.height) ) return;
+
+  int_width = minefield->dim.width;
+  cell_row = &CELL_AT(minefield, 0, int_y);
+
+  /* 8 cells at a time : gather the mine bit of each byte */
+  for (int_x = 0; int_x + 8 <= int_width; int_x += 8) {
+    memcpy(&int_bytes, cell_row + int_x, sizeof(uint64_t));
+    int_bytes = (int_bytes >> 4) & SPREAD_MASK;
+    ptr_row[int_x >> 6] |= ((int_bytes * 0x0102040810204080ULL) >> 56) << (int_x & 63);
+  }
+
+  /* Remaining cells */
+  for (; int_x < int_width; int_x++) {
+    if (cell_row[int_x] & CELL_MINE) ptr_row[int_x >> 6] |= 1ULL << (int_x & 63);
+  }
+}
+
+/*!
+  \fn static void countWordsScalar(const uint64_t* ptr_up, const uint64_t* ptr_mid, const uint64_t* ptr_down, uint64_t* ptr_counts, int64_t int_words, int64_t int_from)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param ptr_up Mine bits of the row above
+  \param ptr_mid Mine bits of the current row
+  \param ptr_down Mine bits of the row below
+  \param ptr_counts 4 count planes of int_words words each
+  \param int_words Amount of words in a row
+  \param int_from First word to compute
+  \brief Sums the 8 neighbours of 64 cells per word with bitwise adders
+  \remarks Rows have a guard word at index -1 and int_words
+*/
+static void countWordsScalar(const uint64_t* ptr_up, const uint64_t* ptr_mid, const uint64_t* ptr_down, uint64_t* ptr_counts, int64_t int_words, int64_t int_from)
+{
+  /* Variables */
+  int64_t k;
+  uint64_t a0, a1, a2, b0, b1, b2, m0, m2;
+  uint64_t int_sUp, int_cUp, int_sDown, int_cDown, int_sMid, int_cMid;
+  uint64_t int_carry, int_t, int_u, int_v;
+
+  for (k = int_from; k < int_words; k++) {
+    /* Neighbours x-1, x and x+1 aligned on x */
+    a0 = (ptr_up[k] << 1)   | (ptr_up[k-1] >> 63);
+    a1 = ptr_up[k];
+    a2 = (ptr_up[k] >> 1)   | (ptr_up[k+1] << 63);
+    b0 = (ptr_down[k] << 1) | (ptr_down[k-1] >> 63);
+    b1 = ptr_down[k];
+    b2 = (ptr_down[k] >> 1) | (ptr_down[k+1] << 63);
+    m0 = (ptr_mid[k] << 1)  | (ptr_mid[k-1] >> 63);
+    m2 = (ptr_mid[k] >> 1)  | (ptr_mid[k+1] << 63);
+
+    /* Sum each row (0 to 3, or 0 to 2 for the current row) */
+    int_sUp   = a0 ^ a1 ^ a2;
+    int_cUp   = (a0 & a1) | (a2 & (a0 ^ a1));
+    int_sDown = b0 ^ b1 ^ b2;
+    int_cDown = (b0 & b1) | (b2 & (b0 ^ b1));
+    int_sMid  = m0 ^ m2;
+    int_cMid  = m0 & m2;
+
+    /* Add the three rows together (0 to 8) */
+    int_carry = (int_sUp & int_sDown) | (int_sMid & (int_sUp ^ int_sDown));
+    int_t     = int_cUp ^ int_cDown ^ int_cMid;
+    int_u     = (int_cUp & int_cDown) | (int_cMid & (int_cUp ^ int_cDown));
+    int_v     = int_t & int_carry;
+
+    ptr_counts[k]               = int_sUp ^ int_sDown ^ int_sMid;
+    ptr_counts[k + int_words]   = int_t ^ int_carry;
+    ptr_counts[k + 2*int_words] = int_u ^ int_v;
+    ptr_counts[k + 3*int_words] = int_u & int_v;
+  }
+}
+
+#ifdef BITBOARD_AVX2
+/*!
+  \fn static int64_t countWordsAvx2(const uint64_t* ptr_up, const uint64_t* ptr_mid, const uint64_t* ptr_down, uint64_t* ptr_counts, int64_t int_words)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param ptr_up Mine bits of the row above
+  \param ptr_mid Mine bits of the current row
+  \param ptr_down Mine bits of the row below
+  \param ptr_counts 4 count planes of int_words words each
+  \param int_words Amount of words in a row
+  \return The amount of words computed (a multiple of 4)
+  \brief Same as countWordsScalar, 4 words at a time
+  \remarks The neighbouring words are plain unaligned loads thanks to the guard words
+*/
+__attribute__((target("avx2")))
+static int64_t countWordsAvx2(const uint64_t* ptr_up, const uint64_t* ptr_mid, const uint64_t* ptr_down, uint64_t* ptr_counts, int64_t int_words)
+{
+  /* Variables */
+  int64_t k;
+  __m256i a0, a1, a2, b0, b1, b2, m0, m1, m2;
+  __m256i v_sUp, v_cUp, v_sDown, v_cDown, v_sMid, v_cMid;
+  __m256i v_carry, v_t, v_u, v_v;
+
+/* Neighbour x-1 (resp. x+1) of 4 words of a row aligned on x */
+#define LEFT(row, k, mid)  _mm256_or_si256(_mm256_slli_epi64(mid, 1), _mm256_srli_epi64(_mm256_loadu_si256((const __m256i*)((row) + (k) - 1)), 63))
+#define RIGHT(row, k, mid) _mm256_or_si256(_mm256_srli_epi64(mid, 1), _mm256_slli_epi64(_mm256_loadu_si256((const __m256i*)((row) + (k) + 1)), 63))
+
+  for (k = 0; k + 4 <= int_words; k += 4) {
+    a1 = _mm256_loadu_si256((const __m256i*)(ptr_up + k));
+    b1 = _mm256_loadu_si256((const __m256i*)(ptr_down + k));
+    m1 = _mm256_loadu_si256((const __m256i*)(ptr_mid + k));
+    a0 = LEFT(ptr_up, k, a1);
+    a2 = RIGHT(ptr_up, k, a1);
+    b0 = LEFT(ptr_down, k, b1);
+    b2 = RIGHT(ptr_down, k, b1);
+    m0 = LEFT(ptr_mid, k, m1);
+    m2 = RIGHT(ptr_mid, k, m1);
+
+    v_sUp   = _mm256_xor_si256(_mm256_xor_si256(a0, a1), a2);
+    v_cUp   = _mm256_or_si256(_mm256_and_si256(a0, a1), _mm256_and_si256(a2, _mm256_xor_si256(a0, a1)));
+    v_sDown = _mm256_xor_si256(_mm256_xor_si256(b0, b1), b2);
+    v_cDown = _mm256_or_si256(_mm256_and_si256(b0, b1), _mm256_and_si256(b2, _mm256_xor_si256(b0, b1)));
+    v_sMid  = _mm256_xor_si256(m0, m2);
+    v_cMid  = _mm256_and_si256(m0, m2);
+
+    v_carry = _mm256_or_si256(_mm256_and_si256(v_sUp, v_sDown), _mm256_and_si256(v_sMid, _mm256_xor_si256(v_sUp, v_sDown)));
+    v_t     = _mm256_xor_si256(_mm256_xor_si256(v_cUp, v_cDown), v_cMid);
+    v_u     = _mm256_or_si256(_mm256_and_si256(v_cUp, v_cDown), _mm256_and_si256(v_cMid, _mm256_xor_si256(v_cUp, v_cDown)));
+    v_v     = _mm256_and_si256(v_t, v_carry);
+
+    _mm256_storeu_si256((__m256i*)(ptr_counts + k),               _mm256_xor_si256(_mm256_xor_si256(v_sUp, v_sDown), v_sMid));
+    _mm256_storeu_si256((__m256i*)(ptr_counts + k + int_words),   _mm256_xor_si256(v_t, v_carry));
+    _mm256_storeu_si256((__m256i*)(ptr_counts + k + 2*int_words), _mm256_xor_si256(v_u, v_v));
+    _mm256_storeu_si256((__m256i*)(ptr_counts + k + 3*int_words), _mm256_and_si256(v_u, v_v));
+  }
+
+#undef LEFT
+#undef RIGHT
+
+  return(k);
+}
+#endif
+
+/*!
+  \fn static void writeCountRow(board* minefield, int int_y, const uint64_t* ptr_counts, int64_t int_words)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param minefield The minefield
+  \param int_y Row to write
+  \param ptr_counts 4 count planes of int_words words each
+  \param int_words Amount of words in a row
+  \brief Stores the count planes of a row in the CELL_COUNT nibble of its cells
+  \remarks None
+*/
+static void writeCountRow(board* minefield, int int_y, const uint64_t* ptr_counts, int64_t int_words)
+{
+  /* Variables */
+  int64_t int_x;
+  int64_t int_width;
+  int int_shift;
+  uint64_t int_bytes;
+  uint64_t int_nibbles;
+  cell* cell_row;
+
+  int_width = minefield->dim.width;
+  cell_row = &CELL_AT(minefield, 0, int_y);
+
+  /* 8 cells at a time */
+  for (int_x = 0; int_x + 8 <= int_width; int_x += 8) {
+    int_shift = int_x & 63;
+    int_nibbles =  spreadBits((ptr_counts[int_x >> 6] >> int_shift) & 0xFF)
+                | (spreadBits((ptr_counts[(int_x >> 6) + int_words] >> int_shift) & 0xFF) << 1)
+                | (spreadBits((ptr_counts[(int_x >> 6) + 2*int_words] >> int_shift) & 0xFF) << 2)
+                | (spreadBits((ptr_counts[(int_x >> 6) + 3*int_words] >> int_shift) & 0xFF) << 3);
+
+    memcpy(&int_bytes, cell_row + int_x, sizeof(uint64_t));
+    int_bytes = (int_bytes & ~(SPREAD_MASK * CELL_COUNT)) | int_nibbles;
+    memcpy(cell_row + int_x, &int_bytes, sizeof(uint64_t));
+  }
+
+  /* Remaining cells */
+  for (; int_x < int_width; int_x++) {
+    int_shift = int_x & 63;
+    cell_row[int_x] = (cell_row[int_x] & ~CELL_COUNT)
+                    | ( ((ptr_counts[int_x >> 6] >> int_shift) & 1)
+                      | (((ptr_counts[(int_x >> 6) + int_words] >> int_shift) & 1) << 1)
+                      | (((ptr_counts[(int_x >> 6) + 2*int_words] >> int_shift) & 1) << 2)
+                      | (((ptr_counts[(int_x >> 6) + 3*int_words] >> int_shift) & 1) << 3) );
+  }
+}
+
+int newBitboard(bitboard* planes, dimensions dim_dimensions)
+{
+  planes->words = (dim_dimensions.width + 63) / 64;
+
+  /* Each mine row has a guard word on both sides */
+  planes->mines  = calloc(3 * (planes->words + 2), sizeof(uint64_t));
+  planes->counts = calloc(4 * planes->words + 4, sizeof(uint64_t));
+
+  if ( (planes->mines == NULL) || (planes->counts == NULL) ) {
+    freeBitboard(planes);
+    return(MEMORY_ALLOCATION_ERROR);
+  }
+
+  return(0);
+}
+
+void freeBitboard(bitboard* planes)
+{
+  free(planes->mines);
+  free(planes->counts);
+  planes->mines  = NULL;
+  planes->counts = NULL;
+}
+
+void countSurroundingMinesRows(board* minefield, bitboard* planes, int int_y0, int int_y1)
+{
+  /* Variables */
+  const presetKernels* kernels;
+
+  /* A whole preset minefield has its own kernel */
+  kernels = findPreset(minefield->dim);
+  if ( (kernels != NULL) && (int_y0 == 0) && (int_y1 == minefield->dim.height) ) {
+    kernels->countMines(minefield);
+    return;
+  }
+
+  countSurroundingMinesHalo(minefield, planes, int_y0, int_y1, NULL, NULL);
+}
+
+void countSurroundingMinesHalo(board* minefield, bitboard* planes, int int_y0, int int_y1, const uint64_t* ptr_above, const uint64_t* ptr_below)
+{
+  /* Variables */
+  int int_y;
+  int64_t int_words;
+  int64_t int_stride;
+  int64_t int_done;
+#ifdef BITBOARD_AVX2
+  int int_hasAvx2;
+#endif
+  uint64_t* ptr_rows[3];
+  uint64_t* ptr_swap;
+
+  int_words  = planes->words;
+  int_stride = int_words + 2;
+#ifdef BITBOARD_AVX2
+  int_hasAvx2 = __builtin_cpu_supports("avx2");
+#endif
+
+  /* Rolling window of 3 rows, skipping the leading guard word */
+  ptr_rows[0] = planes->mines + 1;
+  ptr_rows[1] = planes->mines + 1 + int_stride;
+  ptr_rows[2] = planes->mines + 1 + 2*int_stride;
+  if (ptr_above != NULL) {
+    memcpy(ptr_rows[0], ptr_above, int_words * sizeof(uint64_t));
+  } else {
+    packMineRow(minefield, int_y0 - 1, ptr_rows[0], int_words);
+  }
+  packMineRow(minefield, int_y0, ptr_rows[1], int_words);
+
+  for (int_y = int_y0; int_y < int_y1; int_y++) {
+    if ( (int_y + 1 == int_y1) && (ptr_below != NULL) ) {
+      memcpy(ptr_rows[2], ptr_below, int_words * sizeof(uint64_t));
+    } else {
+      packMineRow(minefield, int_y + 1, ptr_rows[2], int_words);
+    }
+
+    int_done = 0;
+#ifdef BITBOARD_AVX2
+    if (int_hasAvx2) int_done = countWordsAvx2(ptr_rows[0], ptr_rows[1], ptr_rows[2], planes->counts, int_words);
+#endif
+    countWordsScalar(ptr_rows[0], ptr_rows[1], ptr_rows[2], planes->counts, int_words, int_done);
+    writeCountRow(minefield, int_y, planes->counts, int_words);
+
+    /* Slide the window down by one row */
+    ptr_swap    = ptr_rows[0];
+    ptr_rows[0] = ptr_rows[1];
+    ptr_rows[1] = ptr_rows[2];
+    ptr_rows[2] = ptr_swap;
+  }
+}
+
+void initSurroundingMinesBitboard(board* minefield)
+{
+  /* Variables */
+  bitboard planes;
+  const presetKernels* kernels;
+
+  /* The presets don't need the bit planes */
+  kernels = findPreset(minefield->dim);
+  if (kernels != NULL) {
+    kernels->countMines(minefield);
+    return;
+  }
+
+  /* Slower, but without any allocation */
+  if (newBitboard(&planes, minefield->dim) != 0) {
+    initSurroundingMines(minefield);
+    return;
+  }
+  countSurroundingMinesRows(minefield, &planes, 0, minefield->dim.height);
+  freeBitboard(&planes);
+}
@@ -0,0 +1,94 @@
+/*!
+  \file console.c
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \brief Console helpers
+  \remarks None
+
+  Wraps the library for the program : reads
+  the user's input, prints the minefield and
+  kills the program when memory runs out.
+
+*/
+
+#include "console.h"
+#include "render.h"
+
+#include <unistd.h>
+
+
+
+void printMinefield(board* minefield)
+{
+  /* Variables */
+  renderer screen;
+
+  initRenderer(&screen, STDOUT_FILENO);
+  renderMinefield(&screen, minefield);
+  freeRenderer(&screen);
+}
+
+void allocMinefield(board* minefield, dimensions dim_dimensions)
+{
+  /* Kill the program if allocation error */
+  if (newMinefield(minefield, dim_dimensions) != 0) {
+    fprintf(stderr, "Memory allocation error.\n");
+    exit(MEMORY_ALLOCATION_ERROR);
+  }
+}
+
+void initMinefield(board* minefield, dimensions dim_dimensions)
+{
+  allocMinefield(minefield, dim_dimensions);
+
+  /* Init all cells : no mine, hidden, no flag, no surrounding mines */
+  memset(minefield->cells, CELL_HIDDEN, cellBytes(dim_dimensions));
+}
+
+int intInput(void)
+{
+  /* Variables */
+  int int_input;
+  int int_correct;
+  int int_c;
+
+  int_correct = scanf("%d", &int_input);
+  if (int_correct != 1) {
+    fprintf(stderr, "The value is not an int.\n");
+    exit(INT_INPUT_ERROR);
+  }
+
+  /* Empty buffer */
+  while ( ((int_c = getchar()) != '\n') && (int_c != EOF) ) { }
+
+  return (int_input);
+}
+
+int64_t int64Input(void)
+{
+  /* Variables */
+  long long ll_input;
+  int int_correct;
+  int int_c;
+
+  int_correct = scanf("%lld", &ll_input);
+  if (int_correct != 1) {
+    fprintf(stderr, "The value is not an int.\n");
+    exit(INT_INPUT_ERROR);
+  }
+
+  /* Empty buffer */
+  while ( ((int_c = getchar()) != '\n') && (int_c != EOF) ) { }
+
+  return ((int64_t)ll_input);
+}
+
+void initBitboard(bitboard* planes, dimensions dim_dimensions)
+{
+  /* Kill the program if allocation error */
+  if (newBitboard(planes, dim_dimensions) != 0) {
+    fprintf(stderr, "Memory allocation error.\n");
+    exit(MEMORY_ALLOCATION_ERROR);
+  }
+}
@@ -0,0 +1,216 @@
+/*!
+  \file generator.c
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \brief Minefields without guesses
+  \remarks None
+
+  Draws minefields that are safe on the first click
+  until the solver can clear one without guessing.
+  The candidates are played on several threads at
+  once, the first one in order that passes is kept.
+
+*/
+
+#include "generator.h"
+#include "console.h"
+#include "minesweeper.h"
+#include "bitboard.h"
+#include "random.h"
+#include "solver.h"
+
+#include <unistd.h>
+
+
+/* Custom types */
+/*! Thread trying candidates */
+typedef struct {
+  pthread_t thread;     /*!< the thread */
+  generatorJob* job;    /*!< the candidates to share */
+} generatorWorker;
+
+
+
+/*!
+  \fn static void* runGeneratorWorker(void* ptr_worker)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param ptr_worker The generatorWorker of the thread
+  \return NULL
+  \brief Plays candidates until one before them has passed
+  \remarks Every candidate before the one kept is played by some thread,
+  so the one kept doesn't depend on the amount of threads
+*/
+static void* runGeneratorWorker(void* ptr_worker)
+{
+  /* Variables */
+  generatorJob* job;
+  board minefield;
+  bitboard planes;
+  solver solv;
+  solverResult result;
+  rng gen;
+  int64_t i;
+  int64_t int_best;
+
+  job = ((generatorWorker*)ptr_worker)->job;
+  initMinefield(&minefield, job->dim);
+  initBitboard(&planes, job->dim);
+  initSolver(&solv, job->dim);
+
+  for (;;) {
+    i = __atomic_fetch_add(&job->next, 1, __ATOMIC_RELAXED);
+    if ( (i >= GENERATOR_MAX_ATTEMPTS) || (i > __atomic_load_n(&job->best, __ATOMIC_RELAXED)) ) break;
+
+    seedRng(&gen, mixSeed(job->seed, i));
+    resetMinefield(&minefield);
+    placeMinesAround(&minefield, job->mines, job->x, job->y, &gen);
+    countSurroundingMinesRows(&minefield, &planes, 0, job->dim.height);
+    solveMinefield(&solv, &minefield, job->x, job->y, &gen, &result);
+    __atomic_fetch_add(&job->tried, 1, __ATOMIC_RELAXED);
+
+    /* Keep the first candidate that passed */
+    if ( (result.won) && (result.guesses == 0) ) {
+      int_best = __atomic_load_n(&job->best, __ATOMIC_RELAXED);
+      while ( (i < int_best) && !__atomic_compare_exchange_n(&job->best, &int_best, i, false, __ATOMIC_RELAXED, __ATOMIC_RELAXED) ) { }
+    }
+  }
+
+  freeSolver(&solv);
+  freeBitboard(&planes);
+  freeMinefield(&minefield);
+
+  return(NULL);
+}
+
+boolean generateNoGuess(board* minefield, int64_t int_mines, int int_x, int int_y, uint64_t int_seed, int int_threads, generatorStats* stats)
+{
+  /* Variables */
+  generatorJob job;
+  generatorWorker* workers;
+  rng gen;
+  int64_t int_start;
+  int i;
+
+  int_start = nowNs();
+  job.dim = minefield->dim;
+  job.mines = int_mines;
+  job.x = int_x;
+  job.y = int_y;
+  job.seed = int_seed;
+  job.next = 0;
+  job.best = INT64_MAX;
+  job.tried = 0;
+
+  /* One thread per core by default */
+  if (int_threads == 0) int_threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+  if (int_threads < 1) int_threads = 1;
+  workers = malloc(int_threads * sizeof(generatorWorker));
+
+  /* Kill the program if allocation error */
+  if (workers == NULL) {
+    fprintf(stderr, "Memory allocation error.\n");
+    exit(MEMORY_ALLOCATION_ERROR);
+  }
+
+  for (i = 0; i < int_threads; i++) {
+    workers[i].job = &job;
+    if (pthread_create(&workers[i].thread, NULL, runGeneratorWorker, &workers[i]) != 0) {
+      fprintf(stderr, "Can't start a thread.\n");
+      exit(MEMORY_ALLOCATION_ERROR);
+    }
+  }
+  for (i = 0; i < int_threads; i++) pthread_join(workers[i].thread, NULL);
+  free(workers);
+
+  /* Place the mines of the candidate kept on the minefield of the caller */
+  seedRng(&gen, mixSeed(int_seed, (job.best == INT64_MAX) ? 0 : job.best));
+  placeMinesAround(minefield, int_mines, int_x, int_y, &gen);
+  initSurroundingMinesBitboard(minefield);
+
+  if (stats != NULL) {
+    stats->found = (job.best != INT64_MAX);
+    stats->attempts = stats->found ? job.best + 1 : GENERATOR_MAX_ATTEMPTS;
+    stats->tried = job.tried;
+    stats->ns = nowNs() - int_start;
+  }
+
+  return(job.best != INT64_MAX);
+}
+
+/*!
+  \fn static int compareInt64(const void* ptr_a, const void* ptr_b)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param ptr_a First number
+  \param ptr_b Second number
+  \return Negative, zero or positive like strcmp
+  \brief Orders numbers for qsort
+  \remarks None
+*/
+static int compareInt64(const void* ptr_a, const void* ptr_b)
+{
+  /* Variables */
+  int64_t int_a;
+  int64_t int_b;
+
+  int_a = *(const int64_t*)ptr_a;
+  int_b = *(const int64_t*)ptr_b;
+
+  return( (int_a > int_b) - (int_a < int_b) );
+}
+
+int runGenerator(options* opt)
+{
+  /* Variables */
+  board minefield;
+  generatorStats stats;
+  int64_t* ptr_attempts;
+  int64_t i;
+  int64_t int_found;
+  int64_t int_attempts;
+  int64_t int_tried;
+  int64_t int_ns;
+
+  ptr_attempts = malloc(opt->games * sizeof(int64_t));
+
+  /* Kill the program if allocation error */
+  if (ptr_attempts == NULL) {
+    fprintf(stderr, "Memory allocation error.\n");
+    exit(MEMORY_ALLOCATION_ERROR);
+  }
+
+  int_found = 0;
+  int_attempts = 0;
+  int_tried = 0;
+  int_ns = 0;
+  initMinefield(&minefield, opt->dim);
+  for (i = 0; i < opt->games; i++) {
+    resetMinefield(&minefield);
+    generateNoGuess(&minefield, opt->mines, opt->dim.width / 2, opt->dim.height / 2, mixSeed(opt->seed, i), opt->threads, &stats);
+    int_found += stats.found;
+    int_attempts += stats.attempts;
+    int_tried += stats.tried;
+    int_ns += stats.ns;
+    ptr_attempts[i] = stats.attempts;
+  }
+  freeMinefield(&minefield);
+
+  /* Spread of the attempts */
+  qsort(ptr_attempts, opt->games, sizeof(int64_t), compareInt64);
+
+  printf("{\"mode\":\"generate\",\"width\":%d,\"height\":%d,\"mines\":%lld,\"seed\":%llu,\"boards\":%lld,"
+         "\"found\":%lld,\"attempts_mean\":%.2f,\"attempts_p50\":%lld,\"attempts_p90\":%lld,\"attempts_p99\":%lld,"
+         "\"attempts_max\":%lld,\"tried\":%lld,\"ns_per_board\":%.0f}\n",
+         opt->dim.width, opt->dim.height, (long long)opt->mines, (unsigned long long)opt->seed,
+         (long long)opt->games, (long long)int_found, (double)int_attempts / opt->games,
+         (long long)ptr_attempts[opt->games / 2], (long long)ptr_attempts[opt->games * 9 / 10],
+         (long long)ptr_attempts[opt->games * 99 / 100], (long long)ptr_attempts[opt->games - 1],
+         (long long)int_tried, (double)int_ns / opt->games);
+  free(ptr_attempts);
+
+  return(0);
+}
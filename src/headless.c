@@ -0,0 +1,355 @@
+/*!
+  \file headless.c
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \brief Headless mode
+  \remarks None
+
+  Plays a stream of moves (or lets the solver play)
+  without any display and prints the result in a
+  machine readable way, to load test the engine or
+  check it against recorded games.
+
+*/
+
+#include "headless.h"
+#include "console.h"
+#include "minesweeper.h"
+#include "bitboard.h"
+#include "random.h"
+#include "solver.h"
+#include "setup.h"
+#include "generator.h"
+#include "snapshot.h"
+#include "journal.h"
+#include "world.h"
+
+
+
+/*!
+  \fn static int peekByte(moveStream* stream)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param stream The move stream
+  \return The next byte of the stream, EOF at the end
+  \brief Looks at the next byte of a stream, refilling the buffer if needed
+  \remarks None
+*/
+static int peekByte(moveStream* stream)
+{
+  if (stream->pos == stream->size) {
+    if (stream->end) return(EOF);
+    stream->size = fread(stream->buffer, 1, MOVE_BUFFER_SIZE, stream->file);
+    stream->pos = 0;
+    if (stream->size < MOVE_BUFFER_SIZE) stream->end = true;
+    if (stream->size == 0) return(EOF);
+  }
+
+  return((unsigned char)stream->buffer[stream->pos]);
+}
+
+/*!
+  \fn static int readNumber(moveStream* stream, int64_t* ptr_n)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.2 - saturated
+  \param stream The move stream
+  \param ptr_n Where to store the number
+  \return 1 if a number has been read, 0 at the end of the stream, -1 if
+  the next word is not a number
+  \brief Skips the separators and reads a number
+  \remarks Numbers too big for a coordinate saturate at INT32_MAX (or
+  -INT32_MAX), the move is then rejected like any move out of the
+  minefield
+*/
+static int readNumber(moveStream* stream, int64_t* ptr_n)
+{
+  /* Variables */
+  int int_c;
+  int int_sign;
+  int64_t int_n;
+
+  /* Separators and comments */
+  for (;;) {
+    int_c = peekByte(stream);
+    if (int_c == '#') {
+      while ( ((int_c = peekByte(stream)) != EOF) && (int_c != '\n') ) stream->pos++;
+    }
+    if (int_c == EOF) return(0);
+    if ( (int_c != ' ') && (int_c != '\t') && (int_c != '\r') && (int_c != '\n') && (int_c != ',') ) break;
+    if (int_c == '\n') stream->line++;
+    stream->pos++;
+  }
+
+  int_sign = 1;
+  if (int_c == '-') {
+    int_sign = -1;
+    stream->pos++;
+    int_c = peekByte(stream);
+  }
+  if ( (int_c < '0') || (int_c > '9') ) return(-1);
+
+  int_n = 0;
+  while ( (int_c >= '0') && (int_c <= '9') ) {
+    int_n = (int_n > (INT32_MAX - (int_c - '0')) / 10) ? INT32_MAX : 10 * int_n + (int_c - '0');
+    stream->pos++;
+    int_c = peekByte(stream);
+  }
+
+  /* A number must end with a separator */
+  if ( (int_c != EOF) && (int_c != ' ') && (int_c != '\t') && (int_c != '\r') &&
+       (int_c != '\n') && (int_c != ',') && (int_c != '#') ) return(-1);
+
+  *ptr_n = int_sign * int_n;
+  return(1);
+}
+
+void initMoveStream(moveStream* stream, FILE* file)
+{
+  stream->file = file;
+  stream->size = 0;
+  stream->pos = 0;
+  stream->end = false;
+  stream->line = 1;
+}
+
+int readMove(moveStream* stream, int64_t* ptr_x, int64_t* ptr_y, int64_t* ptr_action)
+{
+  /* Variables */
+  int int_res;
+
+  int_res = readNumber(stream, ptr_x);
+  if (int_res != 1) return(int_res);
+
+  /* A move cut in the middle is malformed */
+  if (readNumber(stream, ptr_y) != 1) return(-1);
+  if (readNumber(stream, ptr_action) != 1) return(-1);
+
+  return(1);
+}
+
+void playHeadless(board* minefield, moveStream* stream, headlessResult* result)
+{
+  /* Variables */
+  boardMove moves[MOVE_BATCH];
+  batchResult batch;
+  int64_t int_start;
+  int64_t int_x;
+  int64_t int_y;
+  int64_t int_action;
+  int64_t int_hidden;
+  int64_t int_count;
+  int int_read;
+
+  int_start = nowNs();
+  result->outcome = OUTCOME_UNFINISHED;
+  result->moves = 0;
+  result->rejected = 0;
+  result->errorLine = 0;
+  int_hidden = minefield->count.hiddenSafe;
+
+  int_read = 1;
+  while ( (int_read == 1) && (result->outcome == OUTCOME_UNFINISHED) ) {
+    /* Numbers saturate at INT32_MAX (see readNumber), the moves the interactive prompts
+    wouldn't accept are rejected by the batch */
+    int_count = 0;
+    while ( (int_count < MOVE_BATCH) && ( (int_read = readMove(stream, &int_x, &int_y, &int_action)) == 1 ) ) {
+      moves[int_count].x = (int)int_x;
+      moves[int_count].y = (int)int_y;
+      moves[int_count].action = (int)int_action;
+      int_count++;
+    }
+
+    clickBatch(minefield, moves, int_count, &batch);
+    result->moves += batch.applied;
+    result->rejected += batch.rejected;
+    if (batch.lost) {
+      result->outcome = OUTCOME_LOST;
+    } else if (batch.won) {
+      result->outcome = OUTCOME_WON;
+    }
+  }
+  if ( (int_read == -1) && (result->outcome == OUTCOME_UNFINISHED) ) result->errorLine = stream->line;
+
+  result->revealed = int_hidden - minefield->count.hiddenSafe;
+  result->playNs = nowNs() - int_start;
+}
+
+/*!
+  \fn static int runSolver(options* opt)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param opt The command line options
+  \return 0 on success
+  \brief Lets the solver play the games of the options and prints the
+  totals as a line of JSON
+  \remarks Game i uses the seed mixSeed(seed, i) and starts in the centre
+*/
+static int runSolver(options* opt)
+{
+  /* Variables */
+  board minefield;
+  rng gen;
+  solver solv;
+  solverResult result;
+  int64_t i;
+  int64_t int_start;
+  int64_t int_setupNs;
+  int64_t int_solveNs;
+  int64_t int_won;
+  int64_t int_noGuess;
+  int64_t int_firstClick;
+  int64_t int_guesses;
+
+  int_setupNs = 0;
+  int_solveNs = 0;
+  int_won = 0;
+  int_noGuess = 0;
+  int_firstClick = 0;
+  int_guesses = 0;
+  initSolver(&solv, opt->dim);
+
+  for (i = 0; i < opt->games; i++) {
+    int_start = nowNs();
+    seedRng(&gen, mixSeed(opt->seed, i));
+    initMinefield(&minefield, opt->dim);
+    placeMines(&minefield, opt->mines, &gen);
+    initSurroundingMinesBitboard(&minefield);
+    int_setupNs += nowNs() - int_start;
+
+    int_start = nowNs();
+    solveMinefield(&solv, &minefield, opt->dim.width / 2, opt->dim.height / 2, &gen, &result);
+    int_solveNs += nowNs() - int_start;
+
+    int_won += result.won;
+    int_noGuess += result.won && (result.guesses == 0);
+    int_firstClick += (result.won == false) && (result.guesses == 0);
+    int_guesses += result.guesses;
+    freeMinefield(&minefield);
+  }
+  freeSolver(&solv);
+
+  printf("{\"mode\":\"solve\",\"width\":%d,\"height\":%d,\"mines\":%lld,\"seed\":%llu,\"games\":%lld,"
+         "\"won\":%lld,\"won_without_guess\":%lld,\"lost_on_first_click\":%lld,\"guesses\":%lld,"
+         "\"setup_ns\":%lld,\"solve_ns\":%lld,\"games_per_second\":%.0f}\n",
+         opt->dim.width, opt->dim.height, (long long)opt->mines, (unsigned long long)opt->seed,
+         (long long)opt->games, (long long)int_won, (long long)int_noGuess, (long long)int_firstClick,
+         (long long)int_guesses, (long long)int_setupNs, (long long)int_solveNs,
+         (int_setupNs + int_solveNs > 0) ? 1e9 * opt->games / (int_setupNs + int_solveNs) : 0.0);
+
+  return(0);
+}
+
+int runHeadless(options* opt)
+{
+  /* Variables */
+  board minefield;
+  rng gen;
+  moveStream* stream;
+  FILE* file;
+  headlessResult result;
+  journalWriter journal;
+  int64_t int_start;
+  int64_t int_saveNs;
+  int int_res;
+  static const char* const OUTCOMES[] = { "unfinished", "won", "lost" };
+
+  if (opt->solve) return(runSolver(opt));
+  if (opt->noGuess) return(runGenerator(opt));
+
+  /* Moves */
+  if (strcmp(opt->moves, "-") == 0) {
+    file = stdin;
+  } else {
+    file = fopen(opt->moves, "r");
+    if (file == NULL) {
+      fprintf(stderr, "Can't open the moves file %s.\n", opt->moves);
+      return(FILE_ERROR);
+    }
+  }
+
+  /* The read buffer is too big for the stack */
+  stream = malloc(sizeof(moveStream));
+
+  /* Kill the program if allocation error */
+  if (stream == NULL) {
+    fprintf(stderr, "Memory allocation error.\n");
+    exit(MEMORY_ALLOCATION_ERROR);
+  }
+  initMoveStream(stream, file);
+
+  /* Chunks are created as the moves reach them */
+  if (opt->infinite) {
+    int_res = runInfinite(opt, stream);
+    free(stream);
+    if (file != stdin) fclose(file);
+    return(int_res);
+  }
+
+  /* Minefield */
+  int_start = nowNs();
+  if (opt->load != NULL) {
+    int_res = loadSnapshot(&minefield, &opt->seed, opt->load, opt->verify);
+    if (int_res != 0) {
+      free(stream);
+      if (file != stdin) fclose(file);
+      return(int_res);
+    }
+    opt->dim = minefield.dim;
+    opt->mines = minefield.count.mines;
+  } else if (opt->tiled) {
+    setupMinefieldTiled(&minefield, opt->dim, opt->mines, opt->seed, opt->threads);
+  } else {
+    seedRng(&gen, opt->seed);
+    initMinefield(&minefield, opt->dim);
+    placeMines(&minefield, opt->mines, &gen);
+    initSurroundingMinesBitboard(&minefield);
+  }
+  result.setupNs = nowNs() - int_start;
+
+  /* Record the moves, after the way the mines were placed */
+  if (opt->journal != NULL) {
+    int_res = openJournal(&journal, opt->journal, &minefield, opt->mines, opt->seed);
+    if (int_res != 0) {
+      freeMinefield(&minefield);
+      free(stream);
+      if (file != stdin) fclose(file);
+      return(int_res);
+    }
+    journalSetup(&journal, &minefield, (opt->load != NULL) ? SETUP_SNAPSHOT : (opt->tiled) ? SETUP_TILED : SETUP_PLACE, 0, 0);
+  }
+
+  int_res = 0;
+  playHeadless(&minefield, stream, &result);
+  if ( (opt->journal != NULL) && (closeJournal(&journal, &minefield) != 0) ) int_res = FILE_ERROR;
+
+  /* Snapshot of the game, for the next run */
+  int_saveNs = 0;
+  if (opt->save != NULL) {
+    int_start = nowNs();
+    if (saveSnapshot(&minefield, opt->seed, opt->save) != 0) int_res = FILE_ERROR;
+    int_saveNs = nowNs() - int_start;
+  }
+
+  printf("{\"outcome\":\"%s\",\"width\":%d,\"height\":%d,\"mines\":%lld,\"seed\":%llu,"
+         "\"moves\":%lld,\"rejected\":%lld,\"revealed\":%lld,\"setup_ns\":%lld,\"play_ns\":%lld,"
+         "\"moves_per_second\":%.0f",
+         OUTCOMES[result.outcome], opt->dim.width, opt->dim.height, (long long)opt->mines,
+         (unsigned long long)opt->seed, (long long)result.moves, (long long)result.rejected,
+         (long long)result.revealed, (long long)result.setupNs, (long long)result.playNs,
+         (result.playNs > 0) ? 1e9 * (result.moves + result.rejected) / result.playNs : 0.0);
+  if (opt->save != NULL) printf(",\"save_ns\":%lld", (long long)int_saveNs);
+  if (result.errorLine != 0) printf(",\"error_line\":%lld", (long long)result.errorLine);
+  printf("}\n");
+
+  /* Free memory */
+  freeMinefield(&minefield);
+  free(stream);
+  if (file != stdin) fclose(file);
+
+  if (int_res != 0) return(int_res);
+  return( (result.errorLine != 0) ? MOVE_INPUT_ERROR : 0 );
+}
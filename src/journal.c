@@ -0,0 +1,408 @@
+/*!
+  \file journal.c
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \brief Move journals
+  \remarks None
+
+  Records every click of a game in a compact binary
+  journal, with the seed and how the mines were
+  placed, and reads it back for the replays. Keyframes
+  of the hidden and flag planes are written now and
+  then, so a replay can start close to any move.
+
+*/
+
+#include "journal.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+
+
+/*!
+  \fn static inline void putVarint(journalWriter* journal, uint64_t int_value)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param journal The journal
+  \param int_value The number to append
+  \brief Appends a number to the buffer, 7 bits per byte, the high bit set
+  on every byte but the last
+  \remarks Flushes the buffer first if the number may not fit
+*/
+static inline void putVarint(journalWriter* journal, uint64_t int_value)
+{
+  if (journal->used + 10 > JOURNAL_BUFFER_SIZE) flushJournal(journal);
+
+  while (int_value >= 0x80) {
+    journal->buffer[journal->used++] = (uint8_t)(int_value | 0x80);
+    int_value >>= 7;
+  }
+  journal->buffer[journal->used++] = (uint8_t)int_value;
+}
+
+/*!
+  \fn static inline boolean getVarint(const uint8_t* ptr_data, size_t size_data, size_t* ptr_offset, uint64_t* ptr_value)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param ptr_data The journal
+  \param size_data Bytes of the journal
+  \param ptr_offset Offset of the number, moved after it
+  \param ptr_value Where to store the number
+  \return false if the number is cut by the end of the journal or too long
+  \brief Reads a number written by putVarint
+  \remarks None
+*/
+static inline boolean getVarint(const uint8_t* ptr_data, size_t size_data, size_t* ptr_offset, uint64_t* ptr_value)
+{
+  /* Variables */
+  uint64_t int_value;
+  size_t size_offset;
+  int int_shift;
+
+  int_value = 0;
+  size_offset = *ptr_offset;
+  for (int_shift = 0; int_shift < 64; int_shift += 7) {
+    if (size_offset >= size_data) return(false);
+    int_value |= (uint64_t)(ptr_data[size_offset] & 0x7F) << int_shift;
+    if ((ptr_data[size_offset++] & 0x80) == 0) {
+      *ptr_offset = size_offset;
+      *ptr_value = int_value;
+      return(true);
+    }
+  }
+
+  return(false);
+}
+
+/*!
+  \fn static size_t planeBytes(dimensions dim_dimensions)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param dim_dimensions The dimensions of the minefield
+  \return Bytes of a plane of one bit per cell
+  \brief Size of a plane of a keyframe
+  \remarks None
+*/
+static size_t planeBytes(dimensions dim_dimensions)
+{
+  return(((size_t)cellCount(dim_dimensions) + 7) / 8);
+}
+
+/*!
+  \fn static void putPlane(journalWriter* journal, board* minefield, cell cell_bit)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param journal The journal
+  \param minefield The minefield
+  \param cell_bit CELL_HIDDEN or CELL_FLAG
+  \brief Appends one bit of every cell, 8 cells per byte
+  \remarks None
+*/
+static void putPlane(journalWriter* journal, board* minefield, cell cell_bit)
+{
+  /* Variables */
+  int64_t i;
+  int64_t int_nCells;
+  int j;
+  uint8_t int_byte;
+
+  int_nCells = cellCount(minefield->dim);
+  for (i = 0; i < int_nCells; i += 8) {
+    int_byte = 0;
+    for (j = 0; (j < 8) && (i + j < int_nCells); j++) {
+      if (minefield->cells[i + j] & cell_bit) int_byte |= 1 << j;
+    }
+    if (journal->used == JOURNAL_BUFFER_SIZE) flushJournal(journal);
+    journal->buffer[journal->used++] = int_byte;
+  }
+}
+
+/*!
+  \fn static void putKeyframe(journalWriter* journal, board* minefield)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param journal The journal
+  \param minefield The minefield
+  \brief Appends a keyframe : the amount of moves, the counters, then the
+  hidden and flag planes
+  \remarks The mines and the surrounding counts never change once placed,
+  the replay gets them back from the setup
+*/
+static void putKeyframe(journalWriter* journal, board* minefield)
+{
+  putVarint(journal, (JOURNAL_KEYFRAME << 2) | JOURNAL_RECORD);
+  putVarint(journal, journal->moves);
+  putVarint(journal, minefield->count.mines);
+  putVarint(journal, minefield->count.flags);
+  putVarint(journal, minefield->count.validFlags);
+  putVarint(journal, minefield->count.hiddenSafe);
+  putVarint(journal, minefield->count.hiddenMines);
+  putPlane(journal, minefield, CELL_HIDDEN);
+  putPlane(journal, minefield, CELL_FLAG);
+
+  /* The next move is encoded from scratch */
+  journal->lastIndex = 0;
+  journal->work = 0;
+}
+
+int openJournal(journalWriter* journal, const char* str_path, board* minefield, int64_t int_mines, uint64_t int_seed)
+{
+  journal->fd = open(str_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (journal->fd < 0) {
+    fprintf(stderr, "Can't write the journal %s.\n", str_path);
+    return(FILE_ERROR);
+  }
+  journal->buffer = malloc(JOURNAL_BUFFER_SIZE);
+
+  /* Kill the program if allocation error */
+  if (journal->buffer == NULL) {
+    fprintf(stderr, "Memory allocation error.\n");
+    exit(MEMORY_ALLOCATION_ERROR);
+  }
+
+  memset(journal->buffer, 0, JOURNAL_HEADER_SIZE);
+  memcpy(journal->buffer, JOURNAL_MAGIC, 8);
+  writeLe32(journal->buffer + 8, JOURNAL_VERSION);
+  writeLe32(journal->buffer + 12, (uint32_t)minefield->dim.width);
+  writeLe32(journal->buffer + 16, (uint32_t)minefield->dim.height);
+  writeLe64(journal->buffer + 24, (uint64_t)int_mines);
+  writeLe64(journal->buffer + 32, int_seed);
+  journal->used = JOURNAL_HEADER_SIZE;
+  journal->failed = false;
+
+  journal->moves = 0;
+  journal->lastIndex = 0;
+  journal->placed = false;
+  journal->work = 0;
+  journal->keyframeWork = (cellCount(minefield->dim) > JOURNAL_KEYFRAME_WORK) ? cellCount(minefield->dim) : JOURNAL_KEYFRAME_WORK;
+  journal->hiddenSafe = minefield->count.hiddenSafe;
+  minefield->journal = journal;
+  minefield->onClick = appendMove;
+
+  return(0);
+}
+
+void journalSetup(journalWriter* journal, board* minefield, int int_setup, int int_x, int int_y)
+{
+  putVarint(journal, (JOURNAL_SETUP << 2) | JOURNAL_RECORD);
+  putVarint(journal, int_setup);
+  putVarint(journal, int_x);
+  putVarint(journal, int_y);
+  journal->placed = true;
+  journal->hiddenSafe = minefield->count.hiddenSafe;
+}
+
+void appendMove(journalWriter* journal, board* minefield, int64_t int_index, int int_action, int int_result)
+{
+  /* Variables */
+  int64_t int_delta;
+  uint64_t int_zigzag;
+
+  int_delta = int_index - journal->lastIndex;
+  int_zigzag = ((uint64_t)int_delta << 1) ^ (uint64_t)(int_delta >> 63);
+  putVarint(journal, (int_zigzag << 3) | ((uint64_t)(int_action - 1) << 2) | (uint64_t)(int_result + 1));
+  journal->lastIndex = int_index;
+  journal->moves++;
+
+  /* The work since the last keyframe bounds the cost of a seek */
+  journal->work += 1 + journal->hiddenSafe - minefield->count.hiddenSafe;
+  journal->hiddenSafe = minefield->count.hiddenSafe;
+  if ( (journal->placed) && (journal->work >= journal->keyframeWork) ) putKeyframe(journal, minefield);
+}
+
+boolean flushJournal(journalWriter* journal)
+{
+  /* Variables */
+  size_t size_done;
+  ssize_t int_written;
+
+  size_done = 0;
+  while ( (journal->failed == false) && (size_done < journal->used) ) {
+    int_written = write(journal->fd, journal->buffer + size_done, journal->used - size_done);
+    if ( (int_written < 0) && (errno != EINTR) ) journal->failed = true;
+    if (int_written > 0) size_done += int_written;
+  }
+  journal->used = 0;
+
+  return(journal->failed == false);
+}
+
+int closeJournal(journalWriter* journal, board* minefield)
+{
+  /* Variables */
+  boolean bool_ok;
+
+  bool_ok = flushJournal(journal);
+  bool_ok = (close(journal->fd) == 0) && (bool_ok);
+  free(journal->buffer);
+  journal->buffer = NULL;
+  minefield->journal = NULL;
+  minefield->onClick = NULL;
+
+  if (bool_ok == false) {
+    fprintf(stderr, "Can't write the journal.\n");
+    return(FILE_ERROR);
+  }
+
+  return(0);
+}
+
+size_t readRecord(journalReader* reader, size_t size_offset, int64_t* ptr_lastIndex, journalRecord* record)
+{
+  /* Variables */
+  uint64_t int_value;
+  uint64_t ptr_values[6];
+  int64_t int_delta;
+  int i;
+
+  if (getVarint(reader->data, reader->size, &size_offset, &int_value) == false) return(0);
+
+  /* Move */
+  if ((int_value & JOURNAL_RECORD) != JOURNAL_RECORD) {
+    int_delta = (int64_t)(int_value >> 4) ^ -(int64_t)((int_value >> 3) & 1);
+    record->type = -1;
+    record->index = *ptr_lastIndex + int_delta;
+    record->action = (int)((int_value >> 2) & 1) + 1;
+    record->result = (int)(int_value & 3) - 1;
+    if ( (record->index < 0) || (record->index >= cellCount(reader->dim)) ) return(0);
+    *ptr_lastIndex = record->index;
+    return(size_offset);
+  }
+
+  /* Setup or keyframe, with a fixed amount of numbers */
+  record->type = (int)(int_value >> 2);
+  if ( (record->type != JOURNAL_SETUP) && (record->type != JOURNAL_KEYFRAME) ) return(0);
+  for (i = 0; i < ( (record->type == JOURNAL_SETUP) ? 3 : 6 ); i++) {
+    if (getVarint(reader->data, reader->size, &size_offset, &ptr_values[i]) == false) return(0);
+  }
+
+  if (record->type == JOURNAL_SETUP) {
+    record->setup = (int)ptr_values[0];
+    record->x = (int)ptr_values[1];
+    record->y = (int)ptr_values[2];
+    if ( (record->setup < SETUP_PLACE) || (record->setup > SETUP_SNAPSHOT) ) return(0);
+    if ( (record->x >= reader->dim.width) || (record->y >= reader->dim.height) ) return(0);
+    return(size_offset);
+  }
+
+  record->move = (int64_t)ptr_values[0];
+  record->count.mines = (int64_t)ptr_values[1];
+  record->count.flags = (int64_t)ptr_values[2];
+  record->count.validFlags = (int64_t)ptr_values[3];
+  record->count.hiddenSafe = (int64_t)ptr_values[4];
+  record->count.hiddenMines = (int64_t)ptr_values[5];
+  record->planes = reader->data + size_offset;
+  if (reader->size - size_offset < 2 * planeBytes(reader->dim)) return(0);
+  *ptr_lastIndex = 0;
+
+  return(size_offset + 2 * planeBytes(reader->dim));
+}
+
+int openReplay(journalReader* reader, const char* str_path)
+{
+  /* Variables */
+  struct stat file_stat;
+  journalRecord record;
+  journalKeyframe* ptr_keyframes;
+  int64_t int_lastIndex;
+  int64_t int_size;
+  size_t size_offset;
+  size_t size_next;
+  int int_fd;
+
+  int_fd = open(str_path, O_RDONLY);
+  if (int_fd < 0) {
+    fprintf(stderr, "Can't open the journal %s.\n", str_path);
+    return(FILE_ERROR);
+  }
+  if ( (fstat(int_fd, &file_stat) != 0) || (file_stat.st_size < JOURNAL_HEADER_SIZE) ) {
+    fprintf(stderr, "%s is not a journal.\n", str_path);
+    close(int_fd);
+    return(FILE_ERROR);
+  }
+
+  reader->size = file_stat.st_size;
+  reader->data = mmap(NULL, reader->size, PROT_READ, MAP_PRIVATE, int_fd, 0);
+  close(int_fd);
+  if (reader->data == MAP_FAILED) {
+    fprintf(stderr, "Can't map the journal %s.\n", str_path);
+    return(FILE_ERROR);
+  }
+
+  /* Header */
+  reader->dim.width = (int)readLe32(reader->data + 12);
+  reader->dim.height = (int)readLe32(reader->data + 16);
+  reader->mines = (int64_t)readLe64(reader->data + 24);
+  reader->seed = readLe64(reader->data + 32);
+  if ( (memcmp(reader->data, JOURNAL_MAGIC, 8) != 0) || (readLe32(reader->data + 8) != JOURNAL_VERSION) ||
+       (reader->dim.width <= 0) || (reader->dim.height <= 0) ||
+       (reader->mines <= 0) || (reader->mines > cellCount(reader->dim)) ) {
+    fprintf(stderr, "%s is not a journal this program can read.\n", str_path);
+    munmap(reader->data, reader->size);
+    return(FILE_ERROR);
+  }
+
+  /* Records, until the end or the first one cut */
+  reader->moves = 0;
+  reader->setup = -1;
+  reader->keyframes = NULL;
+  reader->nKeyframes = 0;
+  int_size = 0;
+  int_lastIndex = 0;
+  size_offset = JOURNAL_HEADER_SIZE;
+  while (size_offset < reader->size) {
+    /* Moves are only counted : their type is in the low bits of the first byte, their end is the first byte below 0x80 */
+    if ((reader->data[size_offset] & JOURNAL_RECORD) != JOURNAL_RECORD) {
+      for (size_next = size_offset; (size_next < reader->size) && (reader->data[size_next] & 0x80); size_next++) { }
+      if (size_next == reader->size) break;
+      reader->moves++;
+      size_offset = size_next + 1;
+      continue;
+    }
+
+    size_next = readRecord(reader, size_offset, &int_lastIndex, &record);
+    if (size_next == 0) break;
+    if ( (record.type == JOURNAL_SETUP) && (reader->setup == -1) ) {
+      reader->setup = record.setup;
+      reader->setupX = record.x;
+      reader->setupY = record.y;
+    } else if (record.type == JOURNAL_KEYFRAME) {
+      if (reader->nKeyframes == int_size) {
+        int_size = (int_size == 0) ? 64 : 2 * int_size;
+        ptr_keyframes = realloc(reader->keyframes, int_size * sizeof(journalKeyframe));
+
+        /* Kill the program if allocation error */
+        if (ptr_keyframes == NULL) {
+          fprintf(stderr, "Memory allocation error.\n");
+          exit(MEMORY_ALLOCATION_ERROR);
+        }
+        reader->keyframes = ptr_keyframes;
+      }
+      reader->keyframes[reader->nKeyframes].move = reader->moves;
+      reader->keyframes[reader->nKeyframes].offset = size_offset;
+      reader->nKeyframes++;
+    }
+    size_offset = size_next;
+  }
+  reader->end = size_offset;
+
+  return(0);
+}
+
+void closeReplay(journalReader* reader)
+{
+  munmap(reader->data, reader->size);
+  free(reader->keyframes);
+  reader->data = NULL;
+  reader->keyframes = NULL;
+}
@@ -0,0 +1,158 @@
+/*!
+  \file libminesweeper.c
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \brief Library interface
+  \remarks None
+
+  Wraps a minefield, its random number generator
+  and its state in an opaque handle, so that a
+  process can host any amount of games. Nothing
+  here prints, reads or exits, and there is no
+  global state : errors are returned. The handle
+  lives in the arena of its minefield (see pool.h).
+
+*/
+
+#include "libminesweeper.h"
+#include "minesweeper.h"
+#include "bitboard.h"
+#include "random.h"
+#include "pool.h"
+
+/*! A game : everything the library knows about it, at the start of the arena of its minefield */
+struct mineGame {
+  board minefield;      /*!< the minefield, without any mine until the first reveal */
+  bitboard planes;      /*!< bit planes counting the mines on the first reveal, in the arena */
+  minePool* pool;       /*!< pool the arena goes back to, NULL to free it */
+  rng gen;              /*!< random number generator of the minefield */
+  int64_t mines;        /*!< amount of mines to place */
+  int64_t moves;        /*!< clicks applied */
+  boolean placed;       /*!< true once the mines are placed */
+  int state;            /*!< MINE_PLAYING, MINE_WON or MINE_LOST */
+};
+
+/*! Arenas of finished games */
+struct minePool {
+  boardPool arenas;     /*!< the arenas, by size class */
+};
+
+
+
+int mineCreate(mineGame** ptr_game, int int_width, int int_height, int64_t int_mines, uint64_t int_seed)
+{
+  return(mineCreateFrom(NULL, ptr_game, int_width, int_height, int_mines, int_seed));
+}
+
+int mineCreateFrom(minePool* pool, mineGame** ptr_game, int int_width, int int_height, int64_t int_mines, uint64_t int_seed)
+{
+  /* Variables */
+  mineGame* game;
+  board minefield;
+  bitboard planes;
+  void* ptr_extra;
+  dimensions dim_dimensions;
+
+  *ptr_game = NULL;
+  if ( (int_width < 1) || (int_height < 1) ) return(MINE_ERROR_ARGUMENT);
+  dim_dimensions.width = int_width;
+  dim_dimensions.height = int_height;
+  if ( (int_mines < 1) || (int_mines >= cellCount(dim_dimensions)) ) return(MINE_ERROR_ARGUMENT);
+
+  /* The handle is the first thing in the arena */
+  if (takeMinefield( (pool != NULL) ? &pool->arenas : NULL, &minefield, &planes, dim_dimensions, sizeof(mineGame), &ptr_extra) != 0) return(MINE_ERROR_MEMORY);
+  game = ptr_extra;
+  game->minefield = minefield;
+  game->planes = planes;
+  game->pool = pool;
+
+  seedRng(&game->gen, int_seed);
+  game->mines = int_mines;
+  game->moves = 0;
+  game->placed = false;
+  game->state = MINE_PLAYING;
+  *ptr_game = game;
+
+  return(0);
+}
+
+int mineClick(mineGame* game, int int_x, int int_y, int int_action)
+{
+  /* Variables */
+  int int_res;
+
+  if ( (game->state != MINE_PLAYING) || (int_x < 0) || (int_x >= game->minefield.dim.width) ||
+       (int_y < 0) || (int_y >= game->minefield.dim.height) ||
+       ( (int_action != MINE_REVEAL) && (int_action != MINE_MARK) ) ) return(MINE_ERROR_ARGUMENT);
+
+  /* The first reveal is always safe */
+  if ( (game->placed == false) && (int_action == MINE_REVEAL) ) {
+    placeMinesAround(&game->minefield, game->mines, int_x, int_y, &game->gen);
+    countSurroundingMinesRows(&game->minefield, &game->planes, 0, game->minefield.dim.height);
+    game->placed = true;
+  }
+
+  int_res = click(&game->minefield, int_x, int_y, int_action);
+  if (int_res == -1) return(MINE_REJECTED);
+  game->moves++;
+
+  if (int_res == 0) {
+    game->state = MINE_LOST;
+  } else if ( (game->placed) && (userHasWon(&game->minefield)) ) {
+    game->state = MINE_WON;
+  }
+
+  return(game->state);
+}
+
+int mineCell(const mineGame* game, int int_x, int int_y)
+{
+  /* Variables */
+  cell cell_c;
+
+  if ( (int_x < 0) || (int_x >= game->minefield.dim.width) || (int_y < 0) || (int_y >= game->minefield.dim.height) ) return(MINE_ERROR_ARGUMENT);
+
+  cell_c = CELL_AT(&game->minefield, int_x, int_y);
+  if (cell_c & CELL_BOMB) return(MINE_CELL_BOMB);
+  if (cell_c & CELL_FLAG) return(MINE_CELL_FLAG);
+  if (cell_c & CELL_HIDDEN) return( ( (game->state != MINE_PLAYING) && (cell_c & CELL_MINE) ) ? MINE_CELL_MINE : MINE_CELL_HIDDEN );
+
+  return(cell_c & CELL_COUNT);
+}
+
+void mineQuery(const mineGame* game, mineStatus* status)
+{
+  status->width = game->minefield.dim.width;
+  status->height = game->minefield.dim.height;
+  status->mines = game->mines;
+  status->flags = game->minefield.count.flags;
+  status->hiddenSafe = (game->placed) ? game->minefield.count.hiddenSafe : cellCount(game->minefield.dim) - game->mines;
+  status->moves = game->moves;
+  status->state = game->state;
+}
+
+void mineDestroy(mineGame* game)
+{
+  if (game == NULL) return;
+
+  /* The game goes with its arena */
+  releaseMinefield( (game->pool != NULL) ? &game->pool->arenas : NULL, &game->minefield);
+}
+
+int minePoolCreate(minePool** ptr_pool)
+{
+  *ptr_pool = malloc(sizeof(minePool));
+  if (*ptr_pool == NULL) return(MINE_ERROR_MEMORY);
+  initPool(&(*ptr_pool)->arenas);
+
+  return(0);
+}
+
+void minePoolDestroy(minePool* pool)
+{
+  if (pool == NULL) return;
+
+  emptyPool(&pool->arenas);
+  free(pool);
+}
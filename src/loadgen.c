@@ -0,0 +1,423 @@
+/*!
+  \file loadgen.c
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \brief Load generator of the server
+  \remarks None
+
+  Opens many connections to a server started with
+  --serve, plays random games on all of them at
+  once and measures the throughput and the latency
+  of the requests.
+
+*/
+
+#include "loadgen.h"
+#include "server.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+
+/*! Time given to the requests in flight at the end of the load, in nanoseconds */
+#define LOADGEN_GRACE_NS 1000000000LL
+
+
+
+/*!
+  \fn static void closeClient(loadClient* client)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param client The client
+  \brief Closes the connection of a client and releases its buffers
+  \remarks Does nothing if it is already closed
+*/
+static void closeClient(loadClient* client)
+{
+  if (client->fd < 0) return;
+
+  close(client->fd);
+  client->fd = -1;
+  free(client->revealed);
+  free(client->in);
+  client->revealed = NULL;
+  client->in = NULL;
+}
+
+/*!
+  \fn static void sendRequest(loadWorker* worker, loadClient* client, const char* str_request, int int_pending)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param worker The worker of the client
+  \param client The client
+  \param str_request Request, newline included
+  \param int_pending LOADGEN_NEW, LOADGEN_CLICK or LOADGEN_DIFF
+  \brief Sends a request and starts its clock
+  \remarks A request always fits in the empty send buffer of the socket :
+  the client is closed, with an error, if it doesn't
+*/
+static void sendRequest(loadWorker* worker, loadClient* client, const char* str_request, int int_pending)
+{
+  /* Variables */
+  size_t size_request;
+
+  size_request = strlen(str_request);
+  client->pending = int_pending;
+  client->sentAt = nowNs();
+  if (send(client->fd, str_request, size_request, MSG_NOSIGNAL) != (ssize_t)size_request) {
+    worker->errors++;
+    closeClient(client);
+  }
+}
+
+/*!
+  \fn static void sendNew(loadWorker* worker, loadClient* client)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param worker The worker of the client
+  \param client The client
+  \brief Starts a new game
+  \remarks The server picks the seed
+*/
+static void sendNew(loadWorker* worker, loadClient* client)
+{
+  /* Variables */
+  char str_request[80];
+
+  sprintf(str_request, "new %d %d %lld\n", worker->dim.width, worker->dim.height, (long long)worker->mines);
+  sendRequest(worker, client, str_request, LOADGEN_NEW);
+}
+
+/*!
+  \fn static void sendClick(loadWorker* worker, loadClient* client)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param worker The worker of the client
+  \param client The client
+  \brief Reveals a random cell the client doesn't know revealed
+  \remarks Starts a new game if every cell is known revealed
+*/
+static void sendClick(loadWorker* worker, loadClient* client)
+{
+  /* Variables */
+  char str_request[64];
+  int64_t int_cells;
+  int64_t int_index;
+  int64_t i;
+
+  int_cells = cellCount(worker->dim);
+  int_index = (int64_t)boundedRandom(&client->gen, (uint64_t)int_cells);
+  for (i = 0; (i < int_cells) && (client->revealed[int_index]); i++) int_index = (int_index + 1 == int_cells) ? 0 : int_index + 1;
+  if (i == int_cells) {
+    sendNew(worker, client);
+    return;
+  }
+
+  sprintf(str_request, "click %lld %lld\n", (long long)(int_index % worker->dim.width), (long long)(int_index / worker->dim.width));
+  sendRequest(worker, client, str_request, LOADGEN_CLICK);
+}
+
+/*!
+  \fn static void readDiff(loadWorker* worker, loadClient* client, const char* str_line)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param worker The worker of the client
+  \param client The client
+  \param str_line Reply "diff N X Y C ..."
+  \brief Marks the cells of a diff that are revealed
+  \remarks None
+*/
+static void readDiff(loadWorker* worker, loadClient* client, const char* str_line)
+{
+  /* Variables */
+  char* str_end;
+  long long int_x;
+  long long int_y;
+  long long int_cells;
+  long long i;
+
+  int_cells = strtoll(str_line + 5, &str_end, 10);
+  for (i = 0; i < int_cells; i++) {
+    int_x = strtoll(str_end, &str_end, 10);
+    int_y = strtoll(str_end, &str_end, 10);
+    while (*str_end == ' ') str_end++;
+    if ( (int_x < 0) || (int_x >= worker->dim.width) || (int_y < 0) || (int_y >= worker->dim.height) || (*str_end == '\0') ) {
+      worker->errors++;
+      return;
+    }
+    if ( (*str_end != 'h') && (*str_end != 'f') ) client->revealed[int_y * worker->dim.width + int_x] = 1;
+    str_end++;
+  }
+}
+
+/*!
+  \fn static void handleReply(loadWorker* worker, loadClient* client, const char* str_line, int64_t int_deadline)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param worker The worker of the client
+  \param client The client
+  \param str_line Reply to the pending request, without its newline
+  \param int_deadline End of the load, in nanoseconds
+  \brief Records the latency of a reply and sends the next request
+  \remarks Past the deadline, the client is closed instead
+*/
+static void handleReply(loadWorker* worker, loadClient* client, const char* str_line, int64_t int_deadline)
+{
+  /* Variables */
+  int64_t int_now;
+  int64_t int_latency;
+
+  int_now = nowNs();
+  int_latency = int_now - client->sentAt;
+  recordLatency(&worker->latency, int_latency);
+  worker->requests++;
+  if (client->pending == LOADGEN_CLICK) worker->moves++;
+
+  if (strncmp(str_line, "error", 5) == 0) worker->errors++;
+  if (int_now >= int_deadline) {
+    closeClient(client);
+    return;
+  }
+
+  if (strncmp(str_line, "error", 5) == 0) {
+    sendNew(worker, client);
+  } else if (client->pending == LOADGEN_NEW) {
+    memset(client->revealed, 0, (size_t)cellCount(worker->dim));
+    sendClick(worker, client);
+  } else if (client->pending == LOADGEN_DIFF) {
+    readDiff(worker, client, str_line);
+    sendClick(worker, client);
+  } else if (strcmp(str_line, "ok playing") == 0) {
+    sendRequest(worker, client, "diff\n", LOADGEN_DIFF);
+  } else if ( (strcmp(str_line, "ok won") == 0) || (strcmp(str_line, "ok lost") == 0) ) {
+    worker->games++;
+    worker->won += (str_line[3] == 'w');
+    sendNew(worker, client);
+  } else {
+    sendClick(worker, client);
+  }
+}
+
+/*!
+  \fn static void* runLoadWorker(void* ptr_worker)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param ptr_worker The loadWorker of the thread
+  \return NULL
+  \brief Connects the clients of a worker and plays until the deadline
+  \remarks The clock starts once every client is connected
+*/
+static void* runLoadWorker(void* ptr_worker)
+{
+  /* Variables */
+  loadWorker* worker;
+  loadClient* clients;
+  loadClient* client;
+  struct epoll_event events[SERVER_EVENTS];
+  struct epoll_event event;
+  int64_t int_inSize;
+  int64_t int_start;
+  int64_t int_deadline;
+  int64_t int_last;
+  int64_t int_open;
+  ssize_t int_bytes;
+  char* ptr_end;
+  int int_epoll;
+  int int_events;
+  int64_t i;
+
+  worker = ptr_worker;
+  int_inSize = 64 + cellCount(worker->dim) * 16;
+  clients = calloc(worker->count, sizeof(loadClient));
+  int_epoll = epoll_create1(EPOLL_CLOEXEC);
+
+  /* Kill the program if allocation error */
+  if ( (clients == NULL) || (int_epoll < 0) ) {
+    fprintf(stderr, "Memory allocation error.\n");
+    exit(MEMORY_ALLOCATION_ERROR);
+  }
+
+  int_open = 0;
+  for (i = 0; i < worker->count; i++) {
+    client = &clients[i];
+    client->fd = (int_open == i) ? openEndpoint(worker->opt->loadgen, false) : -1;
+    if (client->fd < 0) continue;
+    client->revealed = malloc(cellCount(worker->dim));
+    client->in = malloc(int_inSize);
+    if ( (client->revealed == NULL) || (client->in == NULL) ) {
+      fprintf(stderr, "Memory allocation error.\n");
+      exit(MEMORY_ALLOCATION_ERROR);
+    }
+    seedRng(&client->gen, mixSeed(worker->opt->seed, worker->first + i));
+    fcntl(client->fd, F_SETFL, fcntl(client->fd, F_GETFL) | O_NONBLOCK);
+    event.events = EPOLLIN;
+    event.data.ptr = client;
+    epoll_ctl(int_epoll, EPOLL_CTL_ADD, client->fd, &event);
+    int_open++;
+  }
+  /* Stop at the first refused connection */
+  worker->connected = int_open;
+  worker->errors += worker->count - int_open;
+
+  int_start = nowNs();
+  int_deadline = int_start + worker->seconds * 1000000000LL;
+  int_last = int_start;
+  for (i = 0; i < worker->count; i++) {
+    if (clients[i].fd >= 0) sendNew(worker, &clients[i]);
+  }
+
+  while (nowNs() < int_deadline + LOADGEN_GRACE_NS) {
+    int_events = epoll_wait(int_epoll, events, SERVER_EVENTS, 100);
+    if ( (int_events <= 0) && (nowNs() >= int_deadline) ) {
+      for (i = 0; (i < worker->count) && (clients[i].fd < 0); i++);
+      if (i == worker->count) break;
+    }
+
+    for (i = 0; i < int_events; i++) {
+      client = events[i].data.ptr;
+      if (client->fd < 0) continue;
+      int_bytes = read(client->fd, client->in + client->inCount, int_inSize - client->inCount);
+      if ( (int_bytes == 0) || ( (int_bytes < 0) && (errno != EAGAIN) && (errno != EINTR) ) ) {
+        worker->errors++;
+        closeClient(client);
+        continue;
+      }
+      if (int_bytes < 0) continue;
+      client->inCount += int_bytes;
+
+      /* Only one request is in flight : one reply line at most */
+      ptr_end = memchr(client->in, '\n', client->inCount);
+      if (ptr_end == NULL) {
+        if (client->inCount == int_inSize) {
+          worker->errors++;
+          closeClient(client);
+        }
+        continue;
+      }
+      *ptr_end = '\0';
+      client->inCount = 0;
+      handleReply(worker, client, client->in, int_deadline);
+      int_last = nowNs();
+    }
+  }
+
+  /* Requests still in flight after the grace time */
+  for (i = 0; i < worker->count; i++) {
+    if (clients[i].fd >= 0) {
+      worker->errors++;
+      closeClient(&clients[i]);
+    }
+  }
+  worker->elapsedNs = int_last - int_start;
+  close(int_epoll);
+  free(clients);
+
+  return(NULL);
+}
+
+int runLoadgen(options* opt)
+{
+  /* Variables */
+  loadWorker* workers;
+  latencyHistogram* latency;
+  dimensions dim_dimensions;
+  int64_t int_mines;
+  int64_t int_clients;
+  int64_t int_seconds;
+  int64_t int_connected;
+  int64_t int_requests;
+  int64_t int_moves;
+  int64_t int_games;
+  int64_t int_won;
+  int64_t int_errors;
+  int64_t int_elapsedNs;
+  int int_threads;
+  int i;
+
+  /* Expert minefield by default */
+  dim_dimensions = opt->dim;
+  int_mines = opt->mines;
+  if ( (dim_dimensions.width == 0) || (dim_dimensions.height == 0) || (int_mines == 0) ) {
+    dim_dimensions.width = 30;
+    dim_dimensions.height = 16;
+    int_mines = 99;
+  }
+  int_clients = (opt->clients > 0) ? opt->clients : LOADGEN_CLIENTS;
+  int_seconds = (opt->seconds > 0) ? opt->seconds : LOADGEN_SECONDS;
+  raiseFileLimit();
+
+  /* One thread per core by default, and no thread without a client */
+  int_threads = opt->threads;
+  if (int_threads == 0) int_threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+  if (int_threads < 1) int_threads = 1;
+  if (int_threads > int_clients) int_threads = (int)int_clients;
+  workers = calloc(int_threads, sizeof(loadWorker));
+  latency = calloc(1, sizeof(latencyHistogram));
+
+  /* Kill the program if allocation error */
+  if ( (workers == NULL) || (latency == NULL) ) {
+    fprintf(stderr, "Memory allocation error.\n");
+    exit(MEMORY_ALLOCATION_ERROR);
+  }
+
+  for (i = 0; i < int_threads; i++) {
+    workers[i].opt = opt;
+    workers[i].dim = dim_dimensions;
+    workers[i].mines = int_mines;
+    workers[i].first = int_clients * i / int_threads;
+    workers[i].count = int_clients * (i + 1) / int_threads - workers[i].first;
+    workers[i].seconds = int_seconds;
+    if (pthread_create(&workers[i].thread, NULL, runLoadWorker, &workers[i]) != 0) {
+      fprintf(stderr, "Can't start a thread.\n");
+      exit(MEMORY_ALLOCATION_ERROR);
+    }
+  }
+
+  int_connected = 0;
+  int_requests = 0;
+  int_moves = 0;
+  int_games = 0;
+  int_won = 0;
+  int_errors = 0;
+  int_elapsedNs = 0;
+  for (i = 0; i < int_threads; i++) {
+    pthread_join(workers[i].thread, NULL);
+    int_connected += workers[i].connected;
+    int_requests += workers[i].requests;
+    int_moves += workers[i].moves;
+    int_games += workers[i].games;
+    int_won += workers[i].won;
+    int_errors += workers[i].errors;
+    if (workers[i].elapsedNs > int_elapsedNs) int_elapsedNs = workers[i].elapsedNs;
+    mergeHistogram(latency, &workers[i].latency);
+  }
+
+  printf("{\"mode\":\"loadgen\",\"address\":\"%s\",\"threads\":%d,\"clients\":%lld,\"connected\":%lld,"
+         "\"width\":%d,\"height\":%d,\"mines\":%lld,\"requests\":%lld,\"moves\":%lld,\"games\":%lld,\"won\":%lld,"
+         "\"errors\":%lld,\"elapsed_ns\":%lld,\"requests_per_second\":%.0f,\"moves_per_second\":%.0f,"
+         "\"latency_p50_us\":%lld,\"latency_p90_us\":%lld,\"latency_p99_us\":%lld,\"latency_p999_us\":%lld,\"latency_max_us\":%lld}\n",
+         opt->loadgen, int_threads, (long long)int_clients, (long long)int_connected,
+         dim_dimensions.width, dim_dimensions.height, (long long)int_mines, (long long)int_requests,
+         (long long)int_moves, (long long)int_games, (long long)int_won, (long long)int_errors, (long long)int_elapsedNs,
+         (int_elapsedNs > 0) ? 1e9 * int_requests / int_elapsedNs : 0.0,
+         (int_elapsedNs > 0) ? 1e9 * int_moves / int_elapsedNs : 0.0,
+         (long long)(latencyPercentile(latency, 0.5) / 1000),
+         (long long)(latencyPercentile(latency, 0.9) / 1000),
+         (long long)(latencyPercentile(latency, 0.99) / 1000),
+         (long long)(latencyPercentile(latency, 0.999) / 1000),
+         (long long)(latency->maxNs / 1000));
+  free(latency);
+  free(workers);
+
+  return( (int_connected == 0) ? FILE_ERROR : 0 );
+}
@@ -12,22 +12,39 @@
 */
 
 /* Additional librairies */
-#include <time.h>
 #include "utils.h"
+#include "console.h"
 #include "minesweeper.h"
+#include "bitboard.h"
+#include "options.h"
+#include "render.h"
+#include "headless.h"
+#include "simulate.h"
+#include "probability.h"
+#include "generator.h"
+#include "snapshot.h"
+#include "journal.h"
+#include "replay.h"
+#include "server.h"
+#include "loadgen.h"
+#include "stats.h"
+#include "undo.h"
+#include "world.h"
+
+#include <unistd.h>
 
 /*!
-  \fn dimensions createMinefield(cell*** minefield)
+  \fn dimensions createMinefield(board* minefield)
   \author L.Draescher <draescherl@eisti.eu>
   \date 19/12/2020
-  \version 0.1 - first draft
+  \version 0.2 - packed cells
   \param minefield The minefield to create
   \return The dimensions of the minefield
   \brief Prompts the user for the dimensions of the minefield, allocates 
   the right amount of memory and returns the dimensions
   \remarks None
 */
-dimensions createMinefield(cell*** minefield)
+dimensions createMinefield(board* minefield)
 {
   /* Variables */
   dimensions dim_res;
@@ -37,19 +54,13 @@ dimensions createMinefield(cell*** minefield)
     printf("Width of the minefield (>0)  : ");
     dim_res.width = intInput();
   } while (dim_res.width <= 0);
-  
-  *minefield = malloc(dim_res.width * sizeof(cell*));
-  if (*minefield == NULL) {
-    fprintf(stderr, "Memory allocation error.\n");
-    exit(MEMORY_ALLOCATION_ERROR);
-  }
 
   /* Prompt for height of the minefield */
   do {
     printf("Height of the minefield (>0) : ");
     dim_res.height = intInput();
   } while (dim_res.height <= 0);
-  initMinefield(*minefield, dim_res);
+  initMinefield(minefield, dim_res);
 
   return(dim_res);
 }
@@ -57,34 +68,74 @@ dimensions createMinefield(cell*** minefield)
 
 
 /*!
-  \fn int initMines(cell** minefield, dimensions dim_dimensions)
+  \fn int64_t initMines(board* minefield)
   \author L.Draescher <draescherl@eisti.eu>
   \date 19/12/2020
-  \version 0.1 - first draft
+  \version 0.4 - mines placed on the first click
   \param minefield The minefield
-  \param dim_dimensions The dimensions of the minefield
   \return The amount of mines the user wants
-  \brief Prompts the user for the amount of mines, places
-  them and returns the number
-  \remarks None
+  \brief Prompts the user for the amount of mines and returns the number
+  \remarks The mines are placed on the first click (see placeFirstMines)
 */
-int initMines(cell** minefield, dimensions dim_dimensions)
+int64_t initMines(board* minefield)
 {
   /* Variables */
-  int int_mines;
+  int64_t int_mines;
+  int64_t int_nCells;
 
+  int_nCells = cellCount(minefield->dim);
   do {
-    printf("Amount of mines (between 1 and %d) : ", dim_dimensions.height * dim_dimensions.width);
-    int_mines = intInput();
-  } while ( (int_mines <= 0) || (int_mines > dim_dimensions.height * dim_dimensions.width) );
-  placeMines(minefield, dim_dimensions, int_mines);
-  initSurroundingMines(minefield, dim_dimensions);
+    printf("Amount of mines (between 1 and %lld) : ", (long long)int_nCells);
+    int_mines = int64Input();
+  } while ( (int_mines <= 0) || (int_mines > int_nCells) );
 
   return(int_mines);
 }
 
 
 
+/*!
+  \fn void placeFirstMines(board* minefield, options* opt, rng* gen, int64_t int_mines, int int_x, int int_y, char* str_status, size_t size_status)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param minefield The minefield, without any mine
+  \param opt The command line options
+  \param gen Random number generator of the game
+  \param int_mines Amount of mines
+  \param int_x x coordinate of the first cell revealed
+  \param int_y y coordinate of the first cell revealed
+  \param str_status Buffer receiving a message for the player
+  \param size_status Size of the buffer
+  \brief Places the mines once the first cell to reveal is known, none on it
+  or around it
+  \remarks With --no-guess, the minefield can also be cleared without guessing
+*/
+void placeFirstMines(board* minefield, options* opt, rng* gen, int64_t int_mines, int int_x, int int_y, char* str_status, size_t size_status)
+{
+  /* Variables */
+  generatorStats stats;
+
+  if (opt->noGuess) {
+    generateNoGuess(minefield, int_mines, int_x, int_y, opt->seed, opt->threads, &stats);
+    if (stats.found) {
+      snprintf(str_status, size_status, "No guess needed : minefield found after %lld attempts in %lld ms.\n",
+               (long long)stats.attempts, (long long)(stats.ns / 1000000));
+    } else {
+      snprintf(str_status, size_status, "No minefield without guesses found after %lld attempts, good luck.\n",
+               (long long)stats.attempts);
+    }
+  } else {
+    placeMinesAround(minefield, int_mines, int_x, int_y, gen);
+    initSurroundingMinesBitboard(minefield);
+  }
+
+  /* The replays place them the same way */
+  if (minefield->journal != NULL) journalSetup(minefield->journal, minefield, (opt->noGuess) ? SETUP_NO_GUESS : SETUP_AROUND, int_x, int_y);
+}
+
+
+
 /*!
   \fn void helpMessage(void)
   \author L.Draescher <draescherl@eisti.eu>
@@ -116,6 +167,12 @@ void helpMessage(void)
   printf("\t\tTo reveal, enter 1. Revealing will show you the amount of adjacent mines.\n");
   printf("\t\tTo mark, enter 2. Marking will put a flag on the cell.\n");
   printf("\t\t\tNote : marking is a toggle, this means that if you want to unmark a cell, all you need to do is \"mark\" it again.\n");
+  printf("\tIf the minefield doesn't fit in the terminal, only a part of it is shown with a map of the rest below.\n");
+  printf("\t\tTo move the view, enter 3 : the selected cell becomes the centre of the view.\n");
+  printf("\tStarted with --save FILE, the game offers 5 to save it and quit. Resume it later with --load FILE.\n");
+  printf("\tStarted with --practice, the game offers 6 to undo the last move, a mine included, and 7 to redo it.\n");
+  printf("\tThe first cell you reveal and its neighbours never hold a mine. Start the game with --no-guess to get a minefield that can be cleared without guessing.\n");
+  printf("\tIf you are stuck, enter 4 : the game tells you how likely the selected cell is to hold a mine, and which cell is the safest.\n");
   
   printf("\nEnding : \n\n");
 
@@ -132,32 +189,121 @@ void helpMessage(void)
 
 
 /*!
-  \fn int playGameRound(cell** minefield, dimensions dim_dimensions, int int_mines)
+  \fn void writeHint(board* minefield, int int_x, int int_y, char* str_hint, size_t size_hint)
   \author L.Draescher <draescherl@eisti.eu>
-  \date 20/12/2020
-  \version 0.1 - first draft
+  \date 18/10/2026
+  \version 0.2 - budget
   \param minefield The minefield
-  \param dim_dimensions The dimensions of the minefield
+  \param int_x x coordinate of the selected cell
+  \param int_y y coordinate of the selected cell
+  \param str_hint Buffer receiving the hint
+  \param size_hint Size of the buffer
+  \brief Writes the probability of the selected cell to hold a mine and the safest cell
+  \remarks The probabilities only use what the player sees, flags included.
+  The player is waiting, so they get the larger budget
+*/
+void writeHint(board* minefield, int int_x, int int_y, char* str_hint, size_t size_hint)
+{
+  /* Variables */
+  double* ptr_prob;
+  int64_t int_index;
+  int64_t int_safest;
+  int int_res;
+
+  ptr_prob = malloc(cellCount(minefield->dim) * sizeof(double));
+
+  /* Kill the program if allocation error */
+  if (ptr_prob == NULL) {
+    fprintf(stderr, "Memory allocation error.\n");
+    exit(MEMORY_ALLOCATION_ERROR);
+  }
+
+  int_res = computeProbabilities(minefield, ptr_prob, PROBABILITY_FULL_BUDGET);
+  int_index = (int64_t)int_y * minefield->dim.width + int_x;
+  if (int_res == PROBABILITY_INCONSISTENT) {
+    snprintf(str_hint, size_hint, "Hint : some flags are wrong, the numbers can't all be right.\n");
+  } else if (int_res == PROBABILITY_TOO_COMPLEX) {
+    snprintf(str_hint, size_hint, "Hint : too many possibilities to count, try again later.\n");
+  } else {
+    int_safest = safestCell(minefield, ptr_prob);
+    if (ptr_prob[int_index] < 0) {
+      snprintf(str_hint, size_hint, "Hint : (%d, %d) is not hidden", int_x, int_y);
+    } else {
+      snprintf(str_hint, size_hint, "Hint : (%d, %d) has a mine with probability %.1f %%", int_x, int_y, 100.0 * ptr_prob[int_index]);
+    }
+    if (int_safest >= 0) {
+      snprintf(str_hint + strlen(str_hint), size_hint - strlen(str_hint), ", the safest cell is (%d, %d) with %.1f %%.\n",
+               (int)(int_safest % minefield->dim.width), (int)(int_safest / minefield->dim.width), 100.0 * ptr_prob[int_safest]);
+    } else {
+      snprintf(str_hint + strlen(str_hint), size_hint - strlen(str_hint), ".\n");
+    }
+  }
+
+  free(ptr_prob);
+}
+
+
+
+/*!
+  \fn int playGameRound(board* minefield, renderer* screen, options* opt, int64_t int_mines, rng* gen)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 20/12/2020
+  \version 0.10 - minimap after undo
+  \param minefield The minefield, without any mine yet unless it was loaded
+  \param screen The renderer
+  \param opt The command line options
   \param int_mines The amount of mines in the minefield
-  \return 1 if the user has won, 0 otherwise
+  \param gen Random number generator of the game
+  \return 1 if the user has won, -1 if the game has been saved, 0 otherwise
   \brief Plays the game
-  \remarks None
+  \remarks With --save, the player can save the game and quit. With
+  --practice, the moves can be undone and redone, and a mine only ends the
+  game if the player plays on instead of undoing it
 */
-int playGameRound(cell** minefield, dimensions dim_dimensions, int int_mines)
+int playGameRound(board* minefield, renderer* screen, options* opt, int64_t int_mines, rng* gen)
 {
   /* Variables */
   int int_x;
   int int_y;
   int int_action;
+  int int_maxAction;
   int int_hasNotClickedOnMine;
   int int_hasWon;
   int int_res;
+  int int_lastAction;
+  boolean bool_placed;
+  boolean bool_saved;
+  boolean bool_exploded;
+  char str_hint[256];
+
+  /* Record the cells changed by each move (for the repaints and the minimap),
+  past half the minefield a full frame is cheaper than going through them */
+  trackDirty(minefield, cellCount(minefield->dim) / 2 + 1);
+
+  /* Only show what fits in the terminal, leaving room for the prompts */
+  screen->fitView = true;
+  screen->footerLines = (opt->frameStats) ? 6 : 5;
 
   /* Keep playing until the game has ended */
   int_hasNotClickedOnMine = 1;
+  bool_placed = (minefield->count.mines > 0);
+  bool_saved = false;
+  bool_exploded = false;
+  str_hint[0] = '\0';
+  int_lastAction = (opt->practice) ? 7 : (opt->save != NULL) ? 5 : 4;
   do {
-    printMinefield(minefield, dim_dimensions);
-    printf("Flags : %d/%d\n", countFlags(minefield, dim_dimensions), int_mines);
+    if (opt->diff) {
+      renderMinefieldDiff(screen, minefield);
+    } else {
+      renderMinefield(screen, minefield);
+    }
+    clearDirty(minefield);
+    printf("Flags : %lld/%lld\n", (long long)countFlags(minefield), (long long)int_mines);
+    if (opt->frameStats) {
+      printf("Frame : %lld bytes in %lld us\n", (long long)screen->frameBytes, (long long)(screen->frameNs / 1000));
+    }
+    printf("%s", str_hint);
+    str_hint[0] = '\0';
 
     /* Prevent user from clicking on a cell that has already been revealed */
     do {
@@ -166,77 +312,145 @@ int playGameRound(cell** minefield, dimensions dim_dimensions, int int_mines)
 
       /* Keep asking until x coordinate is in the minefield */
       do {
-        printf("x coordinate (between 0 and %d) : ", dim_dimensions.width-1);
+        printf("x coordinate (between 0 and %d) : ", minefield->dim.width-1);
         int_x = intInput();
-      } while ( (int_x < 0) || (int_x > dim_dimensions.width-1) );
+      } while ( (int_x < 0) || (int_x > minefield->dim.width-1) );
 
       /* Keep asking until y coordinate is in the minefield */
       do {
-        printf("y coordinate (between 0 and %d) : ", dim_dimensions.height-1);
+        printf("y coordinate (between 0 and %d) : ", minefield->dim.height-1);
         int_y = intInput();
-      } while ( (int_y < 0) || (int_y > dim_dimensions.height-1) );
+      } while ( (int_y < 0) || (int_y > minefield->dim.height-1) );
 
-      /* Keep asking until user has entered a valid action */
+      /* Keep asking until user has entered a valid action, the view can only move when it is partial */
+      int_maxAction = ( (screen->viewWidth < minefield->dim.width) || (screen->viewHeight < minefield->dim.height) ) ? 3 : 2;
       do {
-        printf("Do you want to reveal (1) or mark (2) ? ");
+        if (int_maxAction == 3) {
+          printf("Do you want to reveal (1), mark (2), move the view here (3)");
+        } else {
+          printf("Do you want to reveal (1), mark (2)");
+        }
+        if (opt->practice) {
+          printf(", get a hint (4)%s, undo (6) or redo (7) ? ", (opt->save != NULL) ? ", save and quit (5)" : "");
+        } else if (opt->save != NULL) {
+          printf(", get a hint (4) or save and quit (5) ? ");
+        } else {
+          printf(" or get a hint (4) ? ");
+        }
         int_action = intInput();
-      } while ( (int_action < 1) || (int_action > 2) );
-      
-      int_hasNotClickedOnMine = click(minefield, dim_dimensions, int_x, int_y, int_action);
+      } while ( (int_action < 1) || (int_action > int_lastAction) || ( (int_action == 3) && (int_maxAction == 2) ) ||
+                ( (int_action == 5) && (opt->save == NULL) ) );
+
+      /* Moving the view, asking for a hint or saving is not a move */
+      if ( (int_action == 5) && (bool_placed == false) ) {
+        snprintf(str_hint, sizeof(str_hint), "There is nothing to save before the first cell is revealed.\n");
+        int_hasNotClickedOnMine = 1;
+      } else if ( (int_action == 5) && (bool_exploded) ) {
+        snprintf(str_hint, sizeof(str_hint), "Undo (6) the mine before saving.\n");
+        int_hasNotClickedOnMine = 1;
+      } else if (int_action == 5) {
+        bool_saved = (saveSnapshot(minefield, opt->seed, opt->save) == 0);
+        if (bool_saved == false) snprintf(str_hint, sizeof(str_hint), "The game couldn't be saved to %s.\n", opt->save);
+        int_hasNotClickedOnMine = 1;
+      } else if (int_action == 3) {
+        centreView(screen, minefield, int_x, int_y);
+        int_hasNotClickedOnMine = 1;
+      } else if ( (int_action == 4) && (bool_placed == false) ) {
+        snprintf(str_hint, sizeof(str_hint), "Hint : the first cell you reveal never holds a mine.\n");
+        int_hasNotClickedOnMine = 1;
+      } else if (int_action == 4) {
+        writeHint(minefield, int_x, int_y, str_hint, sizeof(str_hint));
+        int_hasNotClickedOnMine = 1;
+      } else if ( (int_action == 6) || (int_action == 7) ) {
+        /* Practice : the cells of the move are put back, the mine of the last move included */
+        int_res = (int_action == 6) ? undoMove(minefield->undo, minefield) : redoMove(minefield->undo, minefield);
+        if (int_res == -1) snprintf(str_hint, sizeof(str_hint), "There is no move to %s.\n", (int_action == 6) ? "undo" : "redo");
+
+        /* The minimap only follows cells being revealed */
+        if ( (int_action == 6) && (int_res != -1) ) forgetMinimap(screen);
+        if (int_res != -1) bool_exploded = (int_action == 7) && (int_res == 0);
+        if (bool_exploded) snprintf(str_hint, sizeof(str_hint), "BOOM ! Undo (6) to take the move back, any other move ends the game.\n");
+        int_hasNotClickedOnMine = 1;
+      } else if (bool_exploded) {
+        /* Practice : the player went on after the mine */
+        int_hasNotClickedOnMine = 0;
+      } else {
+        /* With --stats, the move is timed until the frame that shows it */
+        STATS_MOVE();
+
+        /* The mines are only placed once the first cell to reveal is known */
+        if ( (int_action == 1) && (bool_placed == false) ) {
+          placeFirstMines(minefield, opt, gen, int_mines, int_x, int_y, str_hint, sizeof(str_hint));
+          bool_placed = true;
+        }
+        int_hasNotClickedOnMine = click(minefield, int_x, int_y, int_action);
+
+        /* Moves come slowly, write them right away */
+        if (minefield->journal != NULL) flushJournal(minefield->journal);
+
+        /* Practice : the mine stays on screen until the move is undone */
+        if ( (opt->practice) && (int_hasNotClickedOnMine == 0) ) {
+          snprintf(str_hint, sizeof(str_hint), "BOOM ! Undo (6) to take the move back, any other move ends the game.\n");
+          bool_exploded = true;
+          int_hasNotClickedOnMine = 1;
+        }
+      }
     } while (int_hasNotClickedOnMine == -1);
     
-    int_hasWon = userHasWon(minefield, dim_dimensions);
-    clrscr();
-  } while ( (int_hasNotClickedOnMine == 1) && (int_hasWon == 0) );
+    /* Without any mine yet, there is nothing to win */
+    int_hasWon = ( (bool_placed) && (bool_exploded == false) ) ? userHasWon(minefield) : 0;
 
-  int_res = (int_hasWon == 1) ? 1:0;
+    /* The differential renderer keeps the minefield on screen until the end */
+    if ( (opt->diff == false) || (int_hasNotClickedOnMine != 1) || (int_hasWon == 1) || (bool_saved) ) clrscr();
+  } while ( (int_hasNotClickedOnMine == 1) && (int_hasWon == 0) && (bool_saved == false) );
+
+  int_res = (bool_saved) ? -1 : (int_hasWon == 1) ? 1:0;
   return(int_res);
 }
 
 
 
 /*!
-  \fn void winScreen(cell** minefield, dimensions dim_dimensions)
+  \fn void winScreen(board* minefield, renderer* screen)
   \author L.Draescher <draescherl@eisti.eu>
   \date 20/12/2020
-  \version 0.1 - first draft
+  \version 0.3 - buffered renderer
   \param minefield The minefield
-  \param dim_dimensions The dimensions of the minefield
+  \param screen The renderer
   \brief Display win screen
   \remarks None
 */
-void winScreen(cell** minefield, dimensions dim_dimensions)
+void winScreen(board* minefield, renderer* screen)
 {
-  printMinefield(minefield, dim_dimensions);
+  renderMinefield(screen, minefield);
   printf("Congratulations, you have found all the mines ! \n");
 }
 
 
 
 /*!
-  \fn void loseScreen(cell** minefield, dimensions dim_dimensions)
+  \fn void loseScreen(board* minefield, renderer* screen)
   \author L.Draescher <draescherl@eisti.eu>
   \date 20/12/2020
-  \version 0.1 - first draft
+  \version 0.3 - buffered renderer
   \param minefield The minefield
-  \param dim_dimensions The dimensions of the minefield
+  \param screen The renderer
   \brief Display lose screen
   \remarks None
 */
-void loseScreen(cell** minefield, dimensions dim_dimensions)
+void loseScreen(board* minefield, renderer* screen)
 {
   /* Variables */
-  int i;
-  int j;
+  int64_t i;
+  int64_t int_nCells;
 
-  /* Change toDisplay in order to show all the bomb locations */
-  for (i = 0; i < dim_dimensions.width; i++) {
-    for (j = 0; j < dim_dimensions.height; j++) {
-      if (minefield[i][j].hasMine) minefield[i][j].toDisplay = 'b';
-    }
+  /* Change the display in order to show all the bomb locations */
+  int_nCells = cellCount(minefield->dim);
+  for (i = 0; i < int_nCells; i++) {
+    if (minefield->cells[i] & CELL_MINE) minefield->cells[i] |= CELL_BOMB;
   }
 
-  printMinefield(minefield, dim_dimensions);
+  renderMinefield(screen, minefield);
   printf("BOOM ! You just stepped on a mine.\n");
 }
 
@@ -246,46 +460,90 @@ void loseScreen(cell** minefield, dimensions dim_dimensions)
   \fn int main(int argc, char** argv)
   \author L.Draescher <draescherl@eisti.eu>
   \date 15/12/2020
-  \version 0.1 - first draft
+  \version 0.9 - infinite view
   \param argc Number of console arguments
   \param argv Console parameters
-  \return 0 on success
+  \return 0 on success, the error code of the headless, simulation, server or load generator mode otherwise
   \brief Main program
   \remarks None
 */
 int main(int argc, char** argv) {
-  /* Generate seed */
-  srand(time(NULL));
-
   /* Variables */
-  cell** minefield;
-  dimensions dim_dimensions;
-  int int_mines;
-  int i;
+  board minefield;
+  int64_t int_mines;
   int int_end;
+  options opt;
+  rng gen;
+  renderer screen;
+  journalWriter journal;
+  undoLog undo;
+
+  /* Generate seed */
+  parseOptions(argc, argv, &opt);
+  if (opt.stats) startStats();
+
+  /* Scripted game, without any prompt */
+  if (opt.headless) return(runHeadless(&opt));
+
+  /* Infinite minefield, through a view */
+  if (opt.infinite) return(playInfinite(&opt));
+
+  /* Many games on every core */
+  if (opt.simulate) return(runSimulation(&opt));
+
+  /* Recorded game */
+  if (opt.replay != NULL) return(runReplay(&opt));
+
+  /* Games of other processes, over a socket */
+  if (opt.serve != NULL) return(runServer(&opt));
+  if (opt.loadgen != NULL) return(runLoadgen(&opt));
+
+  /* Resume a saved game, before anything is displayed in case the snapshot can't be read */
+  if ( (opt.load != NULL) && (loadSnapshot(&minefield, &opt.seed, opt.load, opt.verify) != 0) ) return(FILE_ERROR);
+
+  seedRng(&gen, opt.seed);
+  initRenderer(&screen, STDOUT_FILENO);
 
   /* Help message */
   helpMessage();
   clrscr();
 
   /* Start game */
-  dim_dimensions = createMinefield(&minefield);
-  int_mines = initMines(minefield, dim_dimensions);
+  if (opt.load != NULL) {
+    int_mines = minefield.count.mines;
+  } else {
+    createMinefield(&minefield);
+    int_mines = initMines(&minefield);
+  }
   clrscr();
 
+  /* Keep the cells changed by each move to undo it */
+  if (opt.practice) initUndo(&undo, &minefield);
+
+  /* Record the moves, the mines of a new game are recorded once placed */
+  if (opt.journal != NULL) {
+    if (openJournal(&journal, opt.journal, &minefield, int_mines, opt.seed) != 0) return(FILE_ERROR);
+    if (opt.load != NULL) journalSetup(&journal, &minefield, SETUP_SNAPSHOT, 0, 0);
+  }
+
   /* Play */
-  int_end = playGameRound(minefield, dim_dimensions, int_mines);
+  int_end = playGameRound(&minefield, &screen, &opt, int_mines, &gen);
 
   /* End screens */
-  if (int_end == 1) {
-    winScreen(minefield, dim_dimensions);
+  if (int_end == -1) {
+    printf("Game saved, resume it with --load %s\n", opt.save);
+  } else if (int_end == 1) {
+    winScreen(&minefield, &screen);
   } else {
-    loseScreen(minefield, dim_dimensions);
+    loseScreen(&minefield, &screen);
   }
+  printf("Seed : %llu\n", (unsigned long long)opt.seed);
 
   /* Free memory */
-  for (i = 0; i < dim_dimensions.width; i++) free(minefield[i]);
-  free(minefield);
+  if (opt.journal != NULL) closeJournal(&journal, &minefield);
+  if (opt.practice) freeUndo(&undo, &minefield);
+  freeMinefield(&minefield);
+  freeRenderer(&screen);
 
   return(0);
 }
\ No newline at end of file
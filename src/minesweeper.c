@@ -7,56 +7,58 @@
   \remarks None
 
   File to store all the methods to implement
-  a game of minesweeper.
+  a game of minesweeper. Part of the library :
+  nothing is printed and nothing exits.
 
 */
 
 #include "minesweeper.h"
+#include "stats.h"
+#include "undo.h"
+#include "preset.h"
 
 
 
 /*!
-  \fn int cellHasMine(cell** minefield, dimensions dim_dimensions, int int_x, int int_y)
+  \fn int cellHasMine(board* minefield, int int_x, int int_y)
   \author L.Draescher <draescherl@eisti.eu>
   \date 17/12/2020
-  \version 0.1 - first draft
+  \version 0.2 - packed cells
   \param minefield The minefield
-  \param dim_dimensions The dimensions of the minefield
   \param int_x x coordinate
   \param int_y y coordinate
   \return 1 if there is a mine in the cell, 0 otherwise
   \brief Checks if there is a mine in a given cell
   \remarks None
 */
-int cellHasMine(cell** minefield, dimensions dim_dimensions, int int_x, int int_y)
+int cellHasMine(board* minefield, int int_x, int int_y)
 {
   /* If x coordinate is invalid */
-  if ( (int_x < 0) || (int_x > dim_dimensions.width-1) ) {
+  if ( (int_x < 0) || (int_x > minefield->dim.width-1) ) {
     return(0);
   }
 
   /* If y coordinate is invalid */
-  if ( (int_y < 0) || (int_y > dim_dimensions.width-1) ) {
+  if ( (int_y < 0) || (int_y > minefield->dim.height-1) ) {
     return(0);
   }
 
-  return(minefield[int_x][int_y].hasMine);
+  return( (CELL_AT(minefield, int_x, int_y) & CELL_MINE) != 0 );
 }
 
 /*!
-  \fn int surroundingMines(cell** minefield, dimensions dim_dimensions, int int_x, int int_y)
+  \fn int surroundingMines(board* minefield, int int_x, int int_y)
   \author L.Draescher <draescherl@eisti.eu>
   \date 17/12/2020
-  \version 0.1 - first draft
+  \version 0.2 - packed cells
   \param minefield The minefield
-  \param dim_dimensions The dimensions of the minefield
   \param int_x x coordinate
   \param int_y y coordinate
   \return Amount of surrounding mines
   \brief Counts the amount of surrounding mines
   \remarks None
 */
-int surroundingMines(cell** minefield, dimensions dim_dimensions, int int_x, int int_y)
+int surroundingMines(board* minefield, int int_x, int int_y)
 {
   /* Variables */
   int north;
@@ -70,14 +72,14 @@ int surroundingMines(cell** minefield, dimensions dim_dimensions, int int_x, int
   int mines;
 
   /* Count the amount of surrounding mines */
-  north     = cellHasMine(minefield, dim_dimensions, int_x,   int_y-1);
-  northEast = cellHasMine(minefield, dim_dimensions, int_x+1, int_y-1);
-  east      = cellHasMine(minefield, dim_dimensions, int_x+1, int_y);
-  southEast = cellHasMine(minefield, dim_dimensions, int_x+1, int_y+1);
-  south     = cellHasMine(minefield, dim_dimensions, int_x,   int_y+1);
-  southWest = cellHasMine(minefield, dim_dimensions, int_x-1, int_y+1);
-  west      = cellHasMine(minefield, dim_dimensions, int_x-1, int_y);
-  northWest = cellHasMine(minefield, dim_dimensions, int_x-1, int_y-1);
+  north     = cellHasMine(minefield, int_x,   int_y-1);
+  northEast = cellHasMine(minefield, int_x+1, int_y-1);
+  east      = cellHasMine(minefield, int_x+1, int_y);
+  southEast = cellHasMine(minefield, int_x+1, int_y+1);
+  south     = cellHasMine(minefield, int_x,   int_y+1);
+  southWest = cellHasMine(minefield, int_x-1, int_y+1);
+  west      = cellHasMine(minefield, int_x-1, int_y);
+  northWest = cellHasMine(minefield, int_x-1, int_y-1);
   mines =   north
           + northEast
           + east
@@ -90,178 +92,565 @@ int surroundingMines(cell** minefield, dimensions dim_dimensions, int int_x, int
   return(mines);
 }
 
-void placeMines(cell** minefield, dimensions dim_dimensions, int int_numOfMines)
+/*!
+  \fn static void addMine(board* minefield, cell* cell_c)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param minefield The minefield
+  \param cell_c The cell, without a mine
+  \brief Puts a mine on a cell and updates the counters
+  \remarks None
+*/
+static void addMine(board* minefield, cell* cell_c)
+{
+  *cell_c |= CELL_MINE;
+  minefield->count.mines++;
+
+  if (*cell_c & CELL_HIDDEN) {
+    minefield->count.hiddenSafe--;
+    if (*cell_c & CELL_FLAG) {
+      minefield->count.validFlags++;
+    } else {
+      minefield->count.hiddenMines++;
+    }
+  }
+}
+
+/*!
+  \fn static void removeMine(board* minefield, cell* cell_c)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param minefield The minefield
+  \param cell_c The cell, with a mine
+  \brief Removes the mine of a cell and updates the counters
+  \remarks None
+*/
+static void removeMine(board* minefield, cell* cell_c)
+{
+  *cell_c &= ~CELL_MINE;
+  minefield->count.mines--;
+
+  if (*cell_c & CELL_HIDDEN) {
+    minefield->count.hiddenSafe++;
+    if (*cell_c & CELL_FLAG) {
+      minefield->count.validFlags--;
+    } else {
+      minefield->count.hiddenMines--;
+    }
+  }
+}
+
+/*!
+  \fn static void revealCell(board* minefield, cell* cell_c)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.2 - undo
+  \param minefield The minefield
+  \param cell_c The cell, hidden and without a mine
+  \brief Removes the hidden attribute and the flag of a cell and updates the counters
+  \remarks The display becomes the amount of surrounding mines. The cell
+  is added to the undo history if the minefield has one
+*/
+static void revealCell(board* minefield, cell* cell_c)
+{
+  if (minefield->undo != NULL) recordUndoCell(minefield->undo, cell_c - minefield->cells, (*cell_c & CELL_FLAG) != 0);
+  minefield->count.hiddenSafe--;
+  if (*cell_c & CELL_FLAG) minefield->count.flags--;
+  *cell_c &= ~(CELL_HIDDEN | CELL_FLAG);
+  markDirty(minefield, cell_c - minefield->cells);
+}
+
+/*!
+  \fn static inline int64_t allowedCell(int64_t int_rank, const int64_t* ptr_excluded, int int_nExcluded)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param int_rank Rank of the cell among the cells that may hold a mine
+  \param ptr_excluded Sorted indices of the cells that can't hold a mine
+  \param int_nExcluded Amount of excluded cells
+  \return Index of the cell
+  \brief Skips the excluded cells
+  \remarks None
+*/
+static inline int64_t allowedCell(int64_t int_rank, const int64_t* ptr_excluded, int int_nExcluded)
 {
   /* Variables */
-  int i;
-  int int_randX;
-  int int_randY;
+  int j;
+
+  for (j = 0; j < int_nExcluded; j++) {
+    if (ptr_excluded[j] <= int_rank) int_rank++;
+  }
+
+  return(int_rank);
+}
+
+/*!
+  \fn static void placeMinesExcept(board* minefield, int64_t int_numOfMines, const int64_t* ptr_excluded, int int_nExcluded, rng* gen)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param minefield The minefield, without any mine
+  \param int_numOfMines Number of mines to place, at most the cells left
+  \param ptr_excluded Sorted indices of the cells that can't hold a mine
+  \param int_nExcluded Amount of excluded cells
+  \param gen Random number generator of the game
+  \brief Randomly places a given amount of mines outside of some cells
+  \remarks Floyd's sampling over the ranks of the other cells
+*/
+static void placeMinesExcept(board* minefield, int64_t int_numOfMines, const int64_t* ptr_excluded, int int_nExcluded, rng* gen)
+{
+  /* Variables */
+  int64_t i;
+  int64_t int_nCells;
+  int64_t int_index;
+  int64_t int_nDraws;
+  cell int_picked;
+
+  /* Above half the cells, fill the minefield and draw the safe cells
+  instead, so there are never more than half as many draws as cells */
+  int_nCells = cellCount(minefield->dim) - int_nExcluded;
+  int_nDraws = int_numOfMines;
+  int_picked = CELL_MINE;
+  if (2 * int_numOfMines > int_nCells) {
+    for (i = 0; i < int_nCells; i++) addMine(minefield, &minefield->cells[allowedCell(i, ptr_excluded, int_nExcluded)]);
+    int_nDraws = int_nCells - int_numOfMines;
+    int_picked = 0;
+  }
 
-  for (i = 0; i < int_numOfMines; i++) {
-    /* Prevent two mines from being placed in the same cell */
-    do {
-      int_randX = rand() % dim_dimensions.width;
-      int_randY = rand() % dim_dimensions.height;
-    } while (minefield[int_randX][int_randY].hasMine);
+  /* Floyd's algorithm : the cell drawn among the i+1 first ones is
+  new, or it was already picked and cell i is taken instead */
+  for (i = int_nCells - int_nDraws; i < int_nCells; i++) {
+    int_index = allowedCell(boundedRandom(gen, i + 1), ptr_excluded, int_nExcluded);
+    if ((minefield->cells[int_index] & CELL_MINE) == int_picked) int_index = allowedCell(i, ptr_excluded, int_nExcluded);
 
-    /* Place mine */
-    minefield[int_randX][int_randY].hasMine = true;
+    /* Place (or remove) mine */
+    if (int_picked) {
+      addMine(minefield, &minefield->cells[int_index]);
+    } else {
+      removeMine(minefield, &minefield->cells[int_index]);
+    }
 
     // For debug purposes :
-    // minefield[int_randX][int_randY].toDisplay = 'X';
+    // minefield->cells[int_index] |= CELL_BOMB;
+  }
+}
+
+void placeMines(board* minefield, int64_t int_numOfMines, rng* gen)
+{
+  placeMinesExcept(minefield, int_numOfMines, NULL, 0, gen);
+}
+
+void placeMinesAround(board* minefield, int64_t int_numOfMines, int int_x, int int_y, rng* gen)
+{
+  /* Variables */
+  int64_t ptr_excluded[9];
+  int64_t int_room;
+  int int_nExcluded;
+  int int_dx;
+  int int_dy;
+
+  /* The clicked cell and its neighbours, row after row so they are sorted */
+  int_nExcluded = 0;
+  for (int_dy = -1; int_dy <= 1; int_dy++) {
+    if ( (int_y + int_dy < 0) || (int_y + int_dy >= minefield->dim.height) ) continue;
+    for (int_dx = -1; int_dx <= 1; int_dx++) {
+      if ( (int_x + int_dx < 0) || (int_x + int_dx >= minefield->dim.width) ) continue;
+      ptr_excluded[int_nExcluded++] = CELL_INDEX(minefield->dim, int_x + int_dx, int_y + int_dy);
+    }
+  }
+
+  /* Not enough room : only the clicked cell, or nothing, stays safe */
+  int_room = cellCount(minefield->dim) - int_numOfMines;
+  if (int_room < int_nExcluded) {
+    int_nExcluded = (int_room >= 1) ? 1 : 0;
+    ptr_excluded[0] = CELL_INDEX(minefield->dim, int_x, int_y);
   }
+
+  placeMinesExcept(minefield, int_numOfMines, ptr_excluded, int_nExcluded, gen);
 }
 
-void initSurroundingMines(cell** minefield, dimensions dim_dimensions)
+void initSurroundingMines(board* minefield)
 {
   /* Variables */
   int i;
   int j;
   int int_mines;
 
-  for (i = 0; i < dim_dimensions.width; i++) {
-    for (j = 0; j < dim_dimensions.height; j++) {
-      int_mines = surroundingMines(minefield, dim_dimensions, i, j);
-      if (int_mines > 0) {
-        minefield[i][j].surroundingMines = int_mines;
+  for (j = 0; j < minefield->dim.height; j++) {
+    for (i = 0; i < minefield->dim.width; i++) {
+      int_mines = surroundingMines(minefield, i, j);
+      CELL_AT(minefield, i, j) = (CELL_AT(minefield, i, j) & ~CELL_COUNT) | int_mines;
+    }
+  }
+}
+
+/*!
+  \fn static boolean growQueue(board* minefield, int64_t int_head, int64_t int_length)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.3 - capped arenas
+  \param minefield The minefield
+  \param int_head Position of the first queued cell
+  \param int_length Amount of queued cells
+  \return false on allocation error, the work buffer is then unchanged
+  \brief Doubles the flood fill work buffer, queued cells end up at the start
+  \remarks The buffer of a minefield taken from a pool can't grow : it
+  holds about twice the largest queue of a flood (see POOL_QUEUE_PERIMETER in pool.h),
+  the flood finishes with sweepReveal in the rare case it is full
+*/
+static boolean growQueue(board* minefield, int64_t int_head, int64_t int_length)
+{
+  /* Variables */
+  int64_t int_newSize;
+  int64_t* ptr_queue;
+  int64_t int_first;
+
+  if (minefield->arena != NULL) return(false);
+  int_newSize = (minefield->queueSize == 0) ? 1024 : 2 * minefield->queueSize;
+  ptr_queue = malloc(int_newSize * sizeof(int64_t));
+  if (ptr_queue == NULL) return(false);
+
+  /* Unwrap the ring */
+  if (int_length > 0) {
+    int_first = minefield->queueSize - int_head;
+    if (int_first > int_length) int_first = int_length;
+    memcpy(ptr_queue, minefield->queue + int_head, int_first * sizeof(int64_t));
+    memcpy(ptr_queue + int_first, minefield->queue, (int_length - int_first) * sizeof(int64_t));
+  }
+
+  free(minefield->queue);
+  minefield->queue = ptr_queue;
+  minefield->queueSize = int_newSize;
 
-        // For debug purposes :
-        // if (minefield[i][j].hasMine == false) minefield[i][j].toDisplay = int_mines + '0';
+  return(true);
+}
+
+/*!
+  \fn static int64_t sweepReveal(board* minefield)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param minefield The minefield
+  \return The amount of cells revealed
+  \brief Reveals the hidden neighbours of every revealed empty cell, until
+  there are none left
+  \remarks Flood fill without any work buffer, for when it can't be
+  allocated : each pass reads every cell
+*/
+static int64_t sweepReveal(board* minefield)
+{
+  /* Variables */
+  int i;
+  int j;
+  int int_x;
+  int int_y;
+  int64_t int_revealed;
+  boolean bool_changed;
+  cell* cell_c;
+
+  int_revealed = 0;
+  do {
+    bool_changed = false;
+    for (int_y = 0; int_y < minefield->dim.height; int_y++) {
+      for (int_x = 0; int_x < minefield->dim.width; int_x++) {
+        if ((CELL_AT(minefield, int_x, int_y) & (CELL_HIDDEN | CELL_MINE | CELL_COUNT)) != 0) continue;
+        for (j = -1; j <= 1; j++) {
+          for (i = -1; i <= 1; i++) {
+            if ( (int_x + i < 0) || (int_x + i >= minefield->dim.width) || (int_y + j < 0) || (int_y + j >= minefield->dim.height) ) continue;
+            cell_c = &CELL_AT(minefield, int_x + i, int_y + j);
+            if ((*cell_c & CELL_HIDDEN) == 0) continue;
+            revealCell(minefield, cell_c);
+            int_revealed++;
+            bool_changed = true;
+          }
+        }
       }
     }
-  }
+  } while (bool_changed);
+
+  return(int_revealed);
 }
 
-void reveal(cell** minefield, dimensions dim_dimensions, int int_x, int int_y)
+/*!
+  \fn static int64_t floodReveal(board* minefield, int int_x, int int_y, int64_t* ptr_visited)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.2 - presets
+  \param minefield The minefield
+  \param int_x x coordinate
+  \param int_y y coordinate
+  \param ptr_visited Where to store the number of empty cells whose
+  neighbours were looked at
+  \return The number of cells revealed
+  \brief Body of reveal
+  \remarks Moved out of reveal so that reveal can be measured (see stats.h).
+  A preset minefield is flooded by its kernel (see preset.h), which finds
+  every cell to reveal at once
+*/
+static int64_t floodReveal(board* minefield, int int_x, int int_y, int64_t* ptr_visited)
 {
   /* Variables */
-  int int_surroundingMines;
   int i;
   int j;
   int int_newX;
   int int_newY;
+  int64_t int_index;
+  int64_t int_head;
+  int64_t int_length;
+  int64_t int_revealed;
+  int64_t int_width;
+  uint64_t int_bits;
+  uint64_t ptr_bits[PRESET_WORDS];
+  cell* cell_c;
+  const presetKernels* kernels;
+
+  int_width = minefield->dim.width;
+  cell_c = &CELL_AT(minefield, int_x, int_y);
+  *ptr_visited = 0;
 
   /* Stop if a cell has a mine on it (theoretically
   this should never happen) */
-  if (minefield[int_x][int_y].hasMine == false) {
-    /* Save the number of surrounding mines */
-    int_surroundingMines = minefield[int_x][int_y].surroundingMines;
-
-    /* Remove the hidden attribute of the cell */
-    minefield[int_x][int_y].isHidden = false;
-
-    /* Remove the flag if there is one */
-    minefield[int_x][int_y].hasFlag = false;
-
-    /* Update display */
-    minefield[int_x][int_y].toDisplay = (int_surroundingMines == 0) ? 'd' : int_surroundingMines + '0';
-        
-    /* Stop the recursion if the cell has at least one mine around it */
-    if (int_surroundingMines == 0) {
-      /* The two for loops are to test all directions around the current cell */
+  if (*cell_c & CELL_MINE) return(0);
+
+  /* Remove the hidden attribute and the flag if there is one, which
+  also updates the display to the amount of surrounding mines */
+  int_revealed = 0;
+  if (*cell_c & CELL_HIDDEN) {
+    revealCell(minefield, cell_c);
+    int_revealed = 1;
+  }
+
+  /* Stop if the cell has at least one mine around it */
+  if ((*cell_c & CELL_COUNT) != 0) return(int_revealed);
+
+  /* The kernel of a preset finds every cell to reveal at once */
+  kernels = findPreset(minefield->dim);
+  if (kernels != NULL) {
+    int_revealed += kernels->floodCells(minefield, CELL_INDEX(minefield->dim, int_x, int_y), ptr_bits, ptr_visited);
+    for (i = 0; i < PRESET_WORDS; i++) {
+      for (int_bits = ptr_bits[i]; int_bits != 0; int_bits &= int_bits - 1) {
+        revealCell(minefield, &minefield->cells[64 * i + __builtin_ctzll(int_bits)]);
+      }
+    }
+    return(int_revealed);
+  }
+
+  if ( (minefield->queueSize == 0) && (growQueue(minefield, 0, 0) == false) ) return(int_revealed + sweepReveal(minefield));
+  int_head = 0;
+  int_length = 1;
+  minefield->queue[0] = CELL_INDEX(minefield->dim, int_x, int_y);
+
+  /* Every queued cell is revealed and has no adjacent mines */
+  while (int_length > 0) {
+    int_index = minefield->queue[int_head];
+    int_head = (int_head + 1 == minefield->queueSize) ? 0 : int_head + 1;
+    int_length--;
+    (*ptr_visited)++;
+    int_y = int_index / int_width;
+    int_x = int_index - int_y * int_width;
+
+    /* The two for loops are to test all directions around the current cell */
+    for (j = -1; j <= 1; j++) {
       for (i = -1; i <= 1; i++) {
-        for (j = -1; j <= 1; j++) {
-          /* Save new coordinates in variables */
-          int_newX = int_x + i;
-          int_newY = int_y + j;
-
-          /* First line : prevent unnecessary computation 
-          (i and j = 0 means we are on the original cell) 
-          Second and third lines : ignore outside of the minefield */
-          if ( 
-            ((i != 0) || (j != 0)) &&
-            (int_newX >= 0) && (int_newX < dim_dimensions.width) && 
-            (int_newY >= 0) && (int_newY < dim_dimensions.height)
-          ) {
-            /* If the new cell is hidden, recursively call
-            the function */
-            if (minefield[int_newX][int_newY].isHidden) {
-              reveal(minefield, dim_dimensions, int_newX, int_newY);
-            }
+        /* Save new coordinates in variables */
+        int_newX = int_x + i;
+        int_newY = int_y + j;
+
+        /* Ignore outside of the minefield (the current cell is
+        already revealed so it is skipped below) */
+        if ( 
+          (int_newX < 0) || (int_newX >= minefield->dim.width) || 
+          (int_newY < 0) || (int_newY >= minefield->dim.height)
+        ) continue;
+
+        /* Neighbours of an empty cell can't have a mine, reveal
+        every hidden one and queue it if it is empty as well */
+        cell_c = &CELL_AT(minefield, int_newX, int_newY);
+        if ((*cell_c & CELL_HIDDEN) == 0) continue;
+        revealCell(minefield, cell_c);
+        int_revealed++;
+
+        if ((*cell_c & CELL_COUNT) == 0) {
+          if (int_length == minefield->queueSize) {
+            /* Every queued cell is revealed and empty, the sweep finds them */
+            if (growQueue(minefield, int_head, int_length) == false) return(int_revealed + sweepReveal(minefield));
+            int_head = 0;
           }
+          int_index = int_head + int_length;
+          if (int_index >= minefield->queueSize) int_index -= minefield->queueSize;
+          minefield->queue[int_index] = CELL_INDEX(minefield->dim, int_newX, int_newY);
+          int_length++;
         }
       }
     }
   }
+
+  return(int_revealed);
 }
 
-int click(cell** minefield, dimensions dim_dimensions, int int_x, int int_y, int int_action)
+int64_t reveal(board* minefield, int int_x, int int_y)
+{
+  /* Variables */
+  int64_t int_revealed;
+  int64_t int_visited;
+  STATS_CLOCK(int_start)
+
+  int_revealed = floodReveal(minefield, int_x, int_y, &int_visited);
+  STATS_ADD(cellsVisited, int_visited);
+  STATS_ADD(cellsRevealed, int_revealed);
+  STATS_LATENCY(reveal, int_start);
+
+  return(int_revealed);
+}
+
+/*!
+  \fn static int applyClick(board* minefield, int int_x, int int_y, int int_action)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/12/2020
+  \version 0.3 - undo
+  \param minefield The minefield
+  \param int_x x coordinate to click
+  \param int_y y coordinate to click
+  \param int_action reveal or mark cell
+  \return 0 if the user clicks on a mine, -1 if the cell is not clickable, 1 otherwise
+  \brief Perform a user 'click', without recording it
+  \remarks action = 1 => reveal, action = 2 => mark
+*/
+static int applyClick(board* minefield, int int_x, int int_y, int int_action)
 {
+  /* Variables */
+  cell* cell_c;
+  int int_delta;
+
+  cell_c = &CELL_AT(minefield, int_x, int_y);
+
   /* Cell is already revealed */
-  if (minefield[int_x][int_y].isHidden == false) return(-1);
+  if ((*cell_c & CELL_HIDDEN) == 0) return(-1);
 
   /* If user marks the cell */
   if (int_action == 2) {
     /* Create a toggle for unmarking/marking a cell */
-    if (minefield[int_x][int_y].hasFlag) {
-      minefield[int_x][int_y].hasFlag   = false;
-      minefield[int_x][int_y].toDisplay = 'h';
-    } else {
-      minefield[int_x][int_y].hasFlag   = true;
-      minefield[int_x][int_y].toDisplay = 'f';
+    *cell_c ^= CELL_FLAG;
+    int_delta = (*cell_c & CELL_FLAG) ? 1 : -1;
+    minefield->count.flags += int_delta;
+    if (*cell_c & CELL_MINE) {
+      minefield->count.validFlags  += int_delta;
+      minefield->count.hiddenMines -= int_delta;
     }
+    markDirty(minefield, cell_c - minefield->cells);
     return(1);
   }
 
   /* If we arrive here, it means the coordinates are valid and the user wants
   to reveal the clicked cell */
   
-  if (minefield[int_x][int_y].hasMine) {
-    /* User clicked on a mine */
-    minefield[int_x][int_y].toDisplay = 'b';
+  if (*cell_c & CELL_MINE) {
+    /* User clicked on a mine, the undo history only keeps it the first time */
+    if ( (minefield->undo != NULL) && ((*cell_c & CELL_BOMB) == 0) ) recordUndoCell(minefield->undo, cell_c - minefield->cells, false);
+    *cell_c |= CELL_BOMB;
+    markDirty(minefield, cell_c - minefield->cells);
     return(0);
   } else {
     /* User didn't click on a mine */
-    reveal(minefield, dim_dimensions, int_x, int_y);
+    reveal(minefield, int_x, int_y);
     return(1);
   }
 }
 
-int userHasWon(cell** minefield, dimensions dim_dimensions)
+int click(board* minefield, int int_x, int int_y, int int_action)
 {
   /* Variables */
-  int i;
-  int j;
   int int_res;
-  int int_allMinesHaveFlags;
-  int int_thereAreOnlyMinesLeft;
-  int int_nMines;
-  int int_nFlags;
-  int int_nValidFlags;
-  cell cell_c;
-
-  int int_nHiddenCellsWithMines;
-  int int_nHiddenCellsWithoutMines;
+  STATS_CLOCK(int_start)
 
+  if (minefield->undo != NULL) beginUndoMove(minefield->undo);
+  int_res = applyClick(minefield, int_x, int_y, int_action);
+  if (minefield->undo != NULL) endUndoMove(minefield->undo, CELL_INDEX(minefield->dim, int_x, int_y), int_action, int_res);
+  if (minefield->onClick != NULL) minefield->onClick(minefield->journal, minefield, CELL_INDEX(minefield->dim, int_x, int_y), int_action, int_res);
+  STATS_LATENCY(click, int_start);
 
-  /* Init values */
-  i = 0;
-  j = 0;
-  int_nFlags = 0;
-  int_nMines = 0;
-  int_nValidFlags = 0;
-  int_nHiddenCellsWithMines = 0;
-  int_nHiddenCellsWithoutMines = 0;
+  return(int_res);
+}
 
-  /* Go through array and count */
-  for (i = 0; i < dim_dimensions.width; i++) {
-    for (j = 0; j < dim_dimensions.height; j++) {
-      cell_c = minefield[i][j];
+int64_t clickBatch(board* minefield, boardMove* moves, int64_t int_count, batchResult* result)
+{
+  /* Variables */
+  boardMove* move;
+  int64_t i;
+  int64_t int_hidden;
+  STATS_CLOCK(int_start)
+
+  result->applied = 0;
+  result->rejected = 0;
+  result->lost = false;
+  result->won = false;
+  int_hidden = minefield->count.hiddenSafe;
+
+  for (i = 0; i < int_count; i++) {
+    move = &moves[i];
+    if ( (move->x < 0) || (move->x >= minefield->dim.width) || (move->y < 0) || (move->y >= minefield->dim.height) ||
+         ( (move->action != 1) && (move->action != 2) ) ) {
+      move->result = -1;
+      result->rejected++;
+      continue;
+    }
 
-      if (cell_c.isHidden && cell_c.hasMine && (cell_c.hasFlag == false)) {
-        int_nHiddenCellsWithMines++;
-      }
+    if (minefield->undo != NULL) beginUndoMove(minefield->undo);
+    move->result = applyClick(minefield, move->x, move->y, move->action);
+    if (minefield->undo != NULL) endUndoMove(minefield->undo, CELL_INDEX(minefield->dim, move->x, move->y), move->action, move->result);
+    if (minefield->onClick != NULL) minefield->onClick(minefield->journal, minefield, CELL_INDEX(minefield->dim, move->x, move->y), move->action, move->result);
+    if (move->result == -1) {
+      result->rejected++;
+      continue;
+    }
+    result->applied++;
 
-      if (cell_c.isHidden && (cell_c.hasMine == false)) {
-        int_nHiddenCellsWithoutMines++;
-      }
+    if (move->result == 0) {
+      result->lost = true;
+      i++;
+      break;
+    }
 
-      if (cell_c.hasFlag) int_nFlags++;
-      if (cell_c.hasMine) int_nMines++;
-      if (cell_c.hasFlag && cell_c.hasMine) int_nValidFlags++;
+    /* Only the last safe cell or the last flag can win, and not before the mines are placed */
+    if ( (minefield->count.mines > 0) && ( (minefield->count.hiddenSafe == 0) || (minefield->count.flags == minefield->count.mines) ) &&
+         (userHasWon(minefield)) ) {
+      result->won = true;
+      i++;
+      break;
     }
   }
 
+  result->played = i;
+  result->revealed = int_hidden - minefield->count.hiddenSafe;
+  STATS_LATENCY(clickBatch, int_start);
+
+  return(i);
+}
+
+int userHasWon(board* minefield)
+{
+  /* Variables */
+  int int_res;
+  int int_allMinesHaveFlags;
+  int int_thereAreOnlyMinesLeft;
+  int64_t int_nMines;
+  int64_t int_nFlags;
+  int64_t int_nValidFlags;
+
+  int64_t int_nHiddenCellsWithMines;
+  int64_t int_nHiddenCellsWithoutMines;
+  STATS_CLOCK(int_start)
+
+
+  /* Init values from the live counters */
+  int_nFlags = minefield->count.flags;
+  int_nMines = minefield->count.mines;
+  int_nValidFlags = minefield->count.validFlags;
+  int_nHiddenCellsWithMines = minefield->count.hiddenMines;
+  int_nHiddenCellsWithoutMines = minefield->count.hiddenSafe;
+
   /* This checks if all the cells still hidden have mines underneath them 
   AND all the flags are correctly placed. If so, the user has won */
   int_thereAreOnlyMinesLeft = (
@@ -282,6 +671,29 @@ int userHasWon(cell** minefield, dimensions dim_dimensions)
     (int_allMinesHaveFlags == 1) ||
     (int_thereAreOnlyMinesLeft == 1)
   ) ? 1:0;
+  STATS_LATENCY(userHasWon, int_start);
 
   return(int_res);
+}
+
+void recountMinefield(board* minefield)
+{
+  /* Variables */
+  int64_t i;
+  int64_t int_nCells;
+  cell cell_c;
+
+  memset(&minefield->count, 0, sizeof(counters));
+
+  /* Go through array and count (one linear pass over the cells) */
+  int_nCells = cellCount(minefield->dim);
+  for (i = 0; i < int_nCells; i++) {
+    cell_c = minefield->cells[i];
+
+    minefield->count.hiddenMines += (cell_c & (CELL_HIDDEN | CELL_MINE | CELL_FLAG)) == (CELL_HIDDEN | CELL_MINE);
+    minefield->count.hiddenSafe  += (cell_c & (CELL_HIDDEN | CELL_MINE)) == CELL_HIDDEN;
+    minefield->count.flags       += (cell_c & CELL_FLAG) != 0;
+    minefield->count.mines       += (cell_c & CELL_MINE) != 0;
+    minefield->count.validFlags  += (cell_c & (CELL_FLAG | CELL_MINE)) == (CELL_FLAG | CELL_MINE);
+  }
 }
\ No newline at end of file
@@ -0,0 +1,248 @@
+/*!
+  \file options.c
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \brief Command line options
+  \remarks None
+
+  Parses the command line arguments of
+  the program.
+
+*/
+
+#include "options.h"
+#include "world.h"
+#include "loadgen.h"
+
+#include <time.h>
+#include <unistd.h>
+
+
+
+/*!
+  \fn static void usage(const char* str_prog)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param str_prog Name of the program
+  \brief Prints the usage to stderr and kills the program
+  \remarks None
+*/
+static void usage(const char* str_prog)
+{
+  fprintf(stderr, "Usage : %s [options]\n", str_prog);
+  fprintf(stderr, "  --seed N        seed of the minefield (random by default)\n");
+  fprintf(stderr, "  --frame-stats   print the size and time of every frame\n");
+  fprintf(stderr, "  --stats         print the latencies of the engine and of the frames as JSON on stderr at exit\n");
+  fprintf(stderr, "  --diff          repaint only the cells that changed after a move\n");
+  fprintf(stderr, "  --practice      let the player undo and redo any number of moves, a mine can be taken back\n");
+  fprintf(stderr, "  --headless      play the moves of a stream without any display and print the result\n");
+  fprintf(stderr, "  --moves FILE    file of \"x y action\" moves in headless mode, - for stdin (default)\n");
+  fprintf(stderr, "  --width N       width of the minefield in headless mode, of the view of the infinite minefield\n");
+  fprintf(stderr, "  --height N      height of the minefield in headless mode, of the view of the infinite minefield\n");
+  fprintf(stderr, "  --mines N       amount of mines in headless mode\n");
+  fprintf(stderr, "  --solve         let the solver play in headless mode instead of reading moves\n");
+  fprintf(stderr, "  --games N       amount of games the solver or the simulation plays (1 by default)\n");
+  fprintf(stderr, "  --simulate      play games on every core without any display and print the win rate\n");
+  fprintf(stderr, "  --strategy S    strategy of the simulation : solver (default) or random\n");
+  fprintf(stderr, "  --threads N     threads of the simulation, the tiled setup, the server and the load generator (one per core by default)\n");
+  fprintf(stderr, "  --tiled         set the minefield up by tiles on every core in headless mode, for huge minefields\n");
+  fprintf(stderr, "  --no-guess      only play minefields that can be cleared without guessing\n");
+  fprintf(stderr, "                  (in headless mode, generate --games of them and print the attempts)\n");
+  fprintf(stderr, "  --save FILE     save the game to a snapshot (in headless mode, once the moves are played)\n");
+  fprintf(stderr, "  --load FILE     resume the game of a snapshot instead of creating a minefield\n");
+  fprintf(stderr, "  --verify        check the cells of the --load snapshot against their checksum (reads the whole file)\n");
+  fprintf(stderr, "                  and replay every move of --replay from the first one, not from the last keyframe\n");
+  fprintf(stderr, "  --journal FILE  record every move of the game, with its seed, to a journal\n");
+  fprintf(stderr, "  --replay FILE   replay a journal, checking the result of every move, and print the result\n");
+  fprintf(stderr, "  --seek N        stop the replay after N moves (--save to keep the game at that move)\n");
+  fprintf(stderr, "  --infinite      play on an infinite minefield, through a view of --width x --height cells (30x16) or with headless moves\n");
+  fprintf(stderr, "  --density P     percent of mines of the infinite minefield, %d to %d (20 by default)\n", WORLD_MIN_DENSITY, WORLD_MAX_DENSITY);
+  fprintf(stderr, "  --cache N       chunks of the infinite minefield kept in memory before evicting the resolved ones (1024 by default)\n");
+  fprintf(stderr, "  --serve ADDR    host games on a socket, a path or HOST:PORT, until SIGINT (one event loop per --threads)\n");
+  fprintf(stderr, "  --loadgen ADDR  load the server of ADDR with random games and print the throughput and the latency\n");
+  fprintf(stderr, "  --clients N     connections of the load generator (%d by default)\n", LOADGEN_CLIENTS);
+  fprintf(stderr, "  --seconds N     stop the server after N seconds, or load it for N seconds (%d by default)\n", LOADGEN_SECONDS);
+  exit(ARGUMENT_ERROR);
+}
+
+/*!
+  \fn static uint64_t parseUnsigned(const char* str_prog, const char* str_value)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param str_prog Name of the program
+  \param str_value Text to parse, may be NULL
+  \return The parsed number
+  \brief Parses an unsigned number or prints the usage
+  \remarks None
+*/
+static uint64_t parseUnsigned(const char* str_prog, const char* str_value)
+{
+  /* Variables */
+  unsigned long long int_value;
+  char* str_end;
+
+  if ( (str_value == NULL) || (*str_value == '\0') || (*str_value == '-') ) usage(str_prog);
+  int_value = strtoull(str_value, &str_end, 0);
+  if (*str_end != '\0') usage(str_prog);
+
+  return((uint64_t)int_value);
+}
+
+/*!
+  \fn static int parseSize(const char* str_prog, const char* str_value)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param str_prog Name of the program
+  \param str_value Text to parse, may be NULL
+  \return The parsed number
+  \brief Parses a dimension of the minefield or prints the usage
+  \remarks None
+*/
+static int parseSize(const char* str_prog, const char* str_value)
+{
+  /* Variables */
+  uint64_t int_value;
+
+  int_value = parseUnsigned(str_prog, str_value);
+  if ( (int_value == 0) || (int_value > INT32_MAX) ) usage(str_prog);
+
+  return((int)int_value);
+}
+
+void parseOptions(int argc, char** argv, options* opt)
+{
+  /* Variables */
+  int i;
+
+  /* Default values */
+  opt->seed = ((uint64_t)time(NULL) << 20) ^ (uint64_t)getpid();
+  opt->hasSeed = false;
+  opt->frameStats = false;
+  opt->stats = false;
+  opt->diff = false;
+  opt->practice = false;
+  opt->headless = false;
+  opt->moves = "-";
+  opt->dim.width = 0;
+  opt->dim.height = 0;
+  opt->mines = 0;
+  opt->solve = false;
+  opt->games = 1;
+  opt->simulate = false;
+  opt->strategy = "solver";
+  opt->threads = 0;
+  opt->tiled = false;
+  opt->noGuess = false;
+  opt->save = NULL;
+  opt->load = NULL;
+  opt->verify = false;
+  opt->journal = NULL;
+  opt->replay = NULL;
+  opt->seek = -1;
+  opt->infinite = false;
+  opt->density = 20;
+  opt->cache = 1024;
+  opt->serve = NULL;
+  opt->loadgen = NULL;
+  opt->clients = 0;
+  opt->seconds = 0;
+
+  for (i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--seed") == 0) {
+      opt->seed = parseUnsigned(argv[0], argv[++i]);
+      opt->hasSeed = true;
+    } else if (strcmp(argv[i], "--frame-stats") == 0) {
+      opt->frameStats = true;
+    } else if (strcmp(argv[i], "--stats") == 0) {
+      opt->stats = true;
+    } else if (strcmp(argv[i], "--diff") == 0) {
+      opt->diff = true;
+    } else if (strcmp(argv[i], "--practice") == 0) {
+      opt->practice = true;
+    } else if (strcmp(argv[i], "--headless") == 0) {
+      opt->headless = true;
+    } else if ( (strcmp(argv[i], "--moves") == 0) && (i + 1 < argc) ) {
+      opt->moves = argv[++i];
+    } else if (strcmp(argv[i], "--width") == 0) {
+      opt->dim.width = parseSize(argv[0], argv[++i]);
+    } else if (strcmp(argv[i], "--height") == 0) {
+      opt->dim.height = parseSize(argv[0], argv[++i]);
+    } else if (strcmp(argv[i], "--mines") == 0) {
+      opt->mines = (int64_t)parseUnsigned(argv[0], argv[++i]);
+    } else if (strcmp(argv[i], "--solve") == 0) {
+      opt->solve = true;
+    } else if (strcmp(argv[i], "--games") == 0) {
+      opt->games = (int64_t)parseUnsigned(argv[0], argv[++i]);
+      if (opt->games <= 0) usage(argv[0]);
+    } else if (strcmp(argv[i], "--simulate") == 0) {
+      opt->simulate = true;
+    } else if ( (strcmp(argv[i], "--strategy") == 0) && (i + 1 < argc) ) {
+      opt->strategy = argv[++i];
+    } else if (strcmp(argv[i], "--threads") == 0) {
+      opt->threads = parseSize(argv[0], argv[++i]);
+    } else if (strcmp(argv[i], "--tiled") == 0) {
+      opt->tiled = true;
+    } else if (strcmp(argv[i], "--no-guess") == 0) {
+      opt->noGuess = true;
+    } else if ( (strcmp(argv[i], "--save") == 0) && (i + 1 < argc) ) {
+      opt->save = argv[++i];
+    } else if ( (strcmp(argv[i], "--load") == 0) && (i + 1 < argc) ) {
+      opt->load = argv[++i];
+    } else if (strcmp(argv[i], "--verify") == 0) {
+      opt->verify = true;
+    } else if ( (strcmp(argv[i], "--journal") == 0) && (i + 1 < argc) ) {
+      opt->journal = argv[++i];
+    } else if ( (strcmp(argv[i], "--replay") == 0) && (i + 1 < argc) ) {
+      opt->replay = argv[++i];
+    } else if (strcmp(argv[i], "--seek") == 0) {
+      opt->seek = (int64_t)parseUnsigned(argv[0], argv[++i]);
+    } else if (strcmp(argv[i], "--infinite") == 0) {
+      opt->infinite = true;
+    } else if (strcmp(argv[i], "--density") == 0) {
+      opt->density = parseSize(argv[0], argv[++i]);
+      if ( (opt->density < WORLD_MIN_DENSITY) || (opt->density > WORLD_MAX_DENSITY) ) usage(argv[0]);
+    } else if (strcmp(argv[i], "--cache") == 0) {
+      opt->cache = parseSize(argv[0], argv[++i]);
+    } else if ( (strcmp(argv[i], "--serve") == 0) && (i + 1 < argc) ) {
+      opt->serve = argv[++i];
+    } else if ( (strcmp(argv[i], "--loadgen") == 0) && (i + 1 < argc) ) {
+      opt->loadgen = argv[++i];
+    } else if (strcmp(argv[i], "--clients") == 0) {
+      opt->clients = parseSize(argv[0], argv[++i]);
+    } else if (strcmp(argv[i], "--seconds") == 0) {
+      opt->seconds = parseSize(argv[0], argv[++i]);
+    } else {
+      usage(argv[0]);
+    }
+  }
+
+  /* The headless and simulation modes can't prompt for the minefield, a snapshot has its own */
+  if ( ( (opt->headless) && (opt->load == NULL) && (opt->infinite == false) ) || (opt->simulate) ) {
+    if ( (opt->dim.width == 0) || (opt->dim.height == 0) ) usage(argv[0]);
+    if ( (opt->mines <= 0) || (opt->mines > cellCount(opt->dim)) ) usage(argv[0]);
+  }
+  if ( (opt->solve) && (opt->headless == false) ) usage(argv[0]);
+  if ( (opt->load != NULL) && (opt->headless) && ( (opt->solve) || (opt->noGuess) ) ) usage(argv[0]);
+
+  /* The infinite minefield is played headless or interactively, it has no size to save or record */
+  if ( (opt->infinite) && ( (opt->solve) || (opt->noGuess) || (opt->tiled) || (opt->load != NULL) || (opt->save != NULL) ||
+       (opt->journal != NULL) || (opt->simulate) || (opt->replay != NULL) || (opt->serve != NULL) || (opt->loadgen != NULL) ||
+       (opt->practice) ) ) usage(argv[0]);
+
+  /* The games of the server and of the load generator come from the sockets */
+  if ( ( (opt->serve != NULL) || (opt->loadgen != NULL) ) &&
+       ( ( (opt->serve != NULL) && (opt->loadgen != NULL) ) || (opt->headless) || (opt->simulate) || (opt->replay != NULL) ||
+         (opt->load != NULL) || (opt->save != NULL) || (opt->journal != NULL) ) ) usage(argv[0]);
+  if ( (opt->loadgen != NULL) && (opt->mines > 0) && ( (opt->dim.width == 0) || (opt->dim.height == 0) || (opt->mines >= cellCount(opt->dim)) ) ) usage(argv[0]);
+
+  /* Moves are only undone in the interactive game, and a journal can't record them */
+  if ( (opt->practice) && ( (opt->headless) || (opt->simulate) || (opt->replay != NULL) || (opt->serve != NULL) ||
+       (opt->loadgen != NULL) || (opt->journal != NULL) ) ) usage(argv[0]);
+
+  /* Only one game is recorded */
+  if ( (opt->journal != NULL) && ( (opt->solve) || (opt->simulate) || (opt->replay != NULL) || ( (opt->headless) && (opt->noGuess) ) ) ) usage(argv[0]);
+}
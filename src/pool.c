@@ -0,0 +1,158 @@
+/*!
+  \file pool.c
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \brief Arenas of the games
+  \remarks None
+
+  Puts everything a game needs in one allocation
+  and keeps the allocations of finished games, by
+  size class, for the next ones. Part of the
+  library : nothing is printed and errors are
+  returned.
+
+*/
+
+#include "pool.h"
+
+/*! Start of an arena, before the extra bytes and the cells */
+typedef struct poolArena {
+  struct poolArena* next; /*!< next arena of the list, while in the pool */
+  int sizeClass;        /*!< log2 of the size of the arena */
+} poolArena;
+
+/*! Bytes of the header, so that what follows stays aligned */
+#define POOL_HEADER ((sizeof(poolArena) + CELL_ALIGNMENT - 1) & ~((size_t)CELL_ALIGNMENT - 1))
+
+
+
+/*!
+  \fn static size_t alignArena(size_t size_bytes)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param size_bytes Bytes
+  \return The bytes rounded up to CELL_ALIGNMENT
+  \brief Rounds an offset of the arena up
+  \remarks None
+*/
+static size_t alignArena(size_t size_bytes)
+{
+  return((size_bytes + CELL_ALIGNMENT - 1) & ~((size_t)CELL_ALIGNMENT - 1));
+}
+
+void initPool(boardPool* pool)
+{
+  memset(pool, 0, sizeof(boardPool));
+}
+
+void emptyPool(boardPool* pool)
+{
+  /* Variables */
+  poolArena* arena;
+  int i;
+
+  for (i = 0; i < POOL_CLASSES; i++) {
+    while (pool->free[i] != NULL) {
+      arena = pool->free[i];
+      pool->free[i] = arena->next;
+      free(arena);
+    }
+  }
+  pool->retained = 0;
+}
+
+int takeMinefield(boardPool* pool, board* minefield, bitboard* planes, dimensions dim_dimensions, size_t size_extra, void** ptr_extra)
+{
+  /* Variables */
+  poolArena* arena;
+  void* ptr_arena;
+  size_t size_cells;
+  size_t size_queue;
+  size_t size_dirty;
+  int64_t int_queue;
+  int64_t int_dirty;
+  size_t size_planes;
+  size_t size_extraAligned;
+  size_t size_total;
+  int64_t int_words;
+  int int_class;
+
+  /* Layout : header, extra bytes, cells, flood fill buffer, dirty list, bit planes */
+  size_extraAligned = alignArena(size_extra);
+  size_cells = cellBytes(dim_dimensions);
+  /* The work buffers are capped, not one index per cell */
+  int_queue = POOL_QUEUE_PERIMETER * ((int64_t)dim_dimensions.width + dim_dimensions.height);
+  if (int_queue > cellCount(dim_dimensions)) int_queue = cellCount(dim_dimensions);
+  int_dirty = cellCount(dim_dimensions) / POOL_DIRTY_SHARE;
+  if (int_dirty < POOL_DIRTY_MIN) int_dirty = POOL_DIRTY_MIN;
+  if (int_dirty > cellCount(dim_dimensions)) int_dirty = cellCount(dim_dimensions);
+  size_queue = alignArena((size_t)int_queue * sizeof(int64_t));
+  size_dirty = alignArena((size_t)int_dirty * sizeof(int64_t));
+  int_words = (dim_dimensions.width + 63) / 64;
+  size_planes = (planes != NULL) ? (3 * (int_words + 2) + 4 * int_words + 4) * sizeof(uint64_t) : 0;
+  size_total = POOL_HEADER + size_extraAligned + size_cells + size_queue + size_dirty + size_planes;
+
+  int_class = POOL_MIN_CLASS;
+  while ( (int_class < POOL_MIN_CLASS + POOL_CLASSES - 1) && (((size_t)1 << int_class) < size_total) ) int_class++;
+  if (((size_t)1 << int_class) < size_total) return(MEMORY_ALLOCATION_ERROR);
+
+  /* Reuse an arena of the same class if there is one */
+  arena = (pool != NULL) ? pool->free[int_class - POOL_MIN_CLASS] : NULL;
+  if (arena != NULL) {
+    pool->free[int_class - POOL_MIN_CLASS] = arena->next;
+    pool->retained -= (size_t)1 << int_class;
+  } else {
+    if (posix_memalign(&ptr_arena, CELL_ALIGNMENT, (size_t)1 << int_class) != 0) return(MEMORY_ALLOCATION_ERROR);
+    arena = ptr_arena;
+    arena->sizeClass = int_class;
+    if (pool != NULL) pool->allocated++;
+  }
+  if (pool != NULL) pool->taken++;
+  arena->next = NULL;
+
+  if (ptr_extra != NULL) *ptr_extra = (char*)arena + POOL_HEADER;
+  attachMinefield(minefield, (cell*)((char*)arena + POOL_HEADER + size_extraAligned), dim_dimensions);
+  minefield->arena = arena;
+  minefield->queue = (int64_t*)((char*)minefield->cells + size_cells);
+  minefield->queueSize = int_queue;
+  minefield->dirty = (int64_t*)((char*)minefield->queue + size_queue);
+  minefield->dirtySize = int_dirty;
+  resetMinefield(minefield);
+
+  /* The guard words of the mine rows must be zero */
+  if (planes != NULL) {
+    planes->words = int_words;
+    planes->mines = (uint64_t*)((char*)minefield->dirty + size_dirty);
+    planes->counts = planes->mines + 3 * (int_words + 2);
+    memset(planes->mines, 0, size_planes);
+  }
+
+  return(0);
+}
+
+void releaseMinefield(boardPool* pool, board* minefield)
+{
+  /* Variables */
+  poolArena* arena;
+
+  arena = minefield->arena;
+  if ( (arena == NULL) || (pool == NULL) ) {
+    freeMinefield(minefield);
+    return;
+  }
+
+  /* The minefield may be in the arena : it is cleared first */
+  minefield->cells = NULL;
+  minefield->queue = NULL;
+  minefield->queueSize = 0;
+  minefield->dirty = NULL;
+  minefield->dirtySize = 0;
+  minefield->dirtyLimit = 0;
+  minefield->arena = NULL;
+
+  arena->next = pool->free[arena->sizeClass - POOL_MIN_CLASS];
+  pool->free[arena->sizeClass - POOL_MIN_CLASS] = arena;
+  pool->retained += (size_t)1 << arena->sizeClass;
+}
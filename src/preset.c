@@ -0,0 +1,323 @@
+/*!
+  \file preset.c
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \brief Kernels of the presets
+  \remarks None
+
+  The minefields of the presets have at most 512
+  cells : the whole minefield is one bitboard where
+  bit i is cell i, and the neighbours of every cell
+  are a few shifts of it. The kernels are written
+  once as inline functions of the dimensions and
+  compiled for each preset, so that the loops, the
+  shifts and the column masks are constants. Part of
+  the library.
+
+*/
+
+#include "preset.h"
+#include "bitboard.h"
+
+/*! Gathers the lowest bit of each byte of a word (SPREAD_MASK) into its highest byte */
+#define GATHER_BITS 0x0102040810204080ULL
+/*! Inlined in the kernel of each preset, where the dimensions are constants */
+#define PRESET_INLINE static inline __attribute__((always_inline))
+
+
+
+/*!
+  \fn static inline void shiftUp(uint64_t* ptr_out, const uint64_t* ptr_in, int int_words, int int_shift)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param ptr_out The shifted bitboard
+  \param ptr_in The bitboard to shift
+  \param int_words Words of the bitboards
+  \param int_shift Cells to shift by, between 1 and 63
+  \brief Moves every bit of a bitboard to a higher cell : bit i of the
+  result is bit i-shift
+  \remarks None
+*/
+PRESET_INLINE void shiftUp(uint64_t* ptr_out, const uint64_t* ptr_in, int int_words, int int_shift)
+{
+  /* Variables */
+  int k;
+
+  for (k = int_words - 1; k > 0; k--) ptr_out[k] = (ptr_in[k] << int_shift) | (ptr_in[k-1] >> (64 - int_shift));
+  ptr_out[0] = ptr_in[0] << int_shift;
+}
+
+/*!
+  \fn static inline void shiftDown(uint64_t* ptr_out, const uint64_t* ptr_in, int int_words, int int_shift)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param ptr_out The shifted bitboard
+  \param ptr_in The bitboard to shift
+  \param int_words Words of the bitboards
+  \param int_shift Cells to shift by, between 1 and 63
+  \brief Moves every bit of a bitboard to a lower cell : bit i of the
+  result is bit i+shift
+  \remarks None
+*/
+PRESET_INLINE void shiftDown(uint64_t* ptr_out, const uint64_t* ptr_in, int int_words, int int_shift)
+{
+  /* Variables */
+  int k;
+
+  for (k = 0; k < int_words - 1; k++) ptr_out[k] = (ptr_in[k] >> int_shift) | (ptr_in[k+1] << (64 - int_shift));
+  ptr_out[int_words - 1] = ptr_in[int_words - 1] >> int_shift;
+}
+
+/*!
+  \fn static inline void columnMasks(uint64_t* ptr_hasWest, uint64_t* ptr_hasEast, int int_width, int int_words)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param ptr_hasWest The cells that have a neighbour on their left
+  \param ptr_hasEast The cells that have a neighbour on their right
+  \param int_width Width of the minefield
+  \param int_words Words of the bitboards
+  \brief Builds the masks of the first and last columns
+  \remarks The columns repeat every width bits : each word is the same
+  pattern, shifted
+*/
+PRESET_INLINE void columnMasks(uint64_t* ptr_hasWest, uint64_t* ptr_hasEast, int int_width, int int_words)
+{
+  /* Variables */
+  uint64_t int_pattern;
+  int int_x;
+  int k;
+
+  int_pattern = 0;
+  for (int_x = 0; int_x < 64; int_x += int_width) int_pattern |= 1ULL << int_x;
+
+  for (k = 0; k < int_words; k++) {
+    ptr_hasWest[k] = ~(int_pattern << ((int_width - (64 * k) % int_width) % int_width));
+    ptr_hasEast[k] = ~(int_pattern << ((2 * int_width - 1 - (64 * k) % int_width) % int_width));
+  }
+}
+
+/*!
+  \fn static inline void countPreset(board* minefield, int int_width, int int_height)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param minefield The minefield, of int_width x int_height cells
+  \param int_width Width of the minefield
+  \param int_height Height of the minefield
+  \brief Counts the amount of surrounding mines of each cell
+  \remarks Same adders as countWordsScalar in bitboard.c, on the whole
+  minefield at once : the rows above and below are shifts by the width.
+  Cells are read and written 8 at a time
+*/
+PRESET_INLINE void countPreset(board* minefield, int int_width, int int_height)
+{
+  /* Variables */
+  const int int_cells = int_width * int_height;
+  const int int_words = (int_cells + 63) / 64;
+  uint64_t hasWest[PRESET_WORDS], hasEast[PRESET_WORDS];
+  uint64_t mines[PRESET_WORDS], west[PRESET_WORDS], east[PRESET_WORDS];
+  uint64_t a0[PRESET_WORDS], a1[PRESET_WORDS], a2[PRESET_WORDS];
+  uint64_t b0[PRESET_WORDS], b1[PRESET_WORDS], b2[PRESET_WORDS];
+  uint64_t counts[4][PRESET_WORDS];
+  uint64_t int_sUp, int_cUp, int_sDown, int_cDown, int_sMid, int_cMid;
+  uint64_t int_carry, int_t, int_u, int_v;
+  uint64_t int_bytes;
+  uint64_t int_nibbles;
+  cell* ptr_cells;
+  int i;
+  int k;
+
+  ptr_cells = minefield->cells;
+  columnMasks(hasWest, hasEast, int_width, int_words);
+
+  /* Mine bits, 8 cells at a time */
+  memset(mines, 0, sizeof(mines));
+  for (i = 0; i + 8 <= int_cells; i += 8) {
+    memcpy(&int_bytes, ptr_cells + i, sizeof(uint64_t));
+    mines[i >> 6] |= ((((int_bytes >> 4) & SPREAD_MASK) * GATHER_BITS) >> 56) << (i & 63);
+  }
+  for (i = int_cells & ~7; i < int_cells; i++) {
+    if (ptr_cells[i] & CELL_MINE) mines[i >> 6] |= 1ULL << (i & 63);
+  }
+
+  /* Neighbours x-1 and x+1 of the same row, then of the rows above and below */
+  shiftUp(west, mines, int_words, 1);
+  shiftDown(east, mines, int_words, 1);
+  for (k = 0; k < int_words; k++) {
+    west[k] &= hasWest[k];
+    east[k] &= hasEast[k];
+  }
+  shiftUp(a0, west, int_words, int_width);
+  shiftUp(a1, mines, int_words, int_width);
+  shiftUp(a2, east, int_words, int_width);
+  shiftDown(b0, west, int_words, int_width);
+  shiftDown(b1, mines, int_words, int_width);
+  shiftDown(b2, east, int_words, int_width);
+
+  for (k = 0; k < int_words; k++) {
+    /* Sum each row (0 to 3, or 0 to 2 for the current row) */
+    int_sUp   = a0[k] ^ a1[k] ^ a2[k];
+    int_cUp   = (a0[k] & a1[k]) | (a2[k] & (a0[k] ^ a1[k]));
+    int_sDown = b0[k] ^ b1[k] ^ b2[k];
+    int_cDown = (b0[k] & b1[k]) | (b2[k] & (b0[k] ^ b1[k]));
+    int_sMid  = west[k] ^ east[k];
+    int_cMid  = west[k] & east[k];
+
+    /* Add the three rows together (0 to 8) */
+    int_carry = (int_sUp & int_sDown) | (int_sMid & (int_sUp ^ int_sDown));
+    int_t     = int_cUp ^ int_cDown ^ int_cMid;
+    int_u     = (int_cUp & int_cDown) | (int_cMid & (int_cUp ^ int_cDown));
+    int_v     = int_t & int_carry;
+
+    counts[0][k] = int_sUp ^ int_sDown ^ int_sMid;
+    counts[1][k] = int_t ^ int_carry;
+    counts[2][k] = int_u ^ int_v;
+    counts[3][k] = int_u & int_v;
+  }
+
+  /* Store the counts in the CELL_COUNT nibble, 8 cells at a time */
+  for (i = 0; i + 8 <= int_cells; i += 8) {
+    int_nibbles =  spreadBits((counts[0][i >> 6] >> (i & 63)) & 0xFF)
+                | (spreadBits((counts[1][i >> 6] >> (i & 63)) & 0xFF) << 1)
+                | (spreadBits((counts[2][i >> 6] >> (i & 63)) & 0xFF) << 2)
+                | (spreadBits((counts[3][i >> 6] >> (i & 63)) & 0xFF) << 3);
+    memcpy(&int_bytes, ptr_cells + i, sizeof(uint64_t));
+    int_bytes = (int_bytes & ~(SPREAD_MASK * CELL_COUNT)) | int_nibbles;
+    memcpy(ptr_cells + i, &int_bytes, sizeof(uint64_t));
+  }
+  for (i = int_cells & ~7; i < int_cells; i++) {
+    ptr_cells[i] = (ptr_cells[i] & ~CELL_COUNT)
+                 | ( ((counts[0][i >> 6] >> (i & 63)) & 1)
+                   | (((counts[1][i >> 6] >> (i & 63)) & 1) << 1)
+                   | (((counts[2][i >> 6] >> (i & 63)) & 1) << 2)
+                   | (((counts[3][i >> 6] >> (i & 63)) & 1) << 3) );
+  }
+}
+
+/*!
+  \fn static inline int64_t floodPreset(board* minefield, int64_t int_start, uint64_t* ptr_revealed, int64_t* ptr_visited, int int_width, int int_height)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param minefield The minefield, of int_width x int_height cells
+  \param int_start Index of a revealed cell without any mine around it
+  \param ptr_revealed PRESET_WORDS words where to store the cells to reveal
+  \param ptr_visited Where to store the number of empty cells whose
+  neighbours were looked at
+  \param int_width Width of the minefield
+  \param int_height Height of the minefield
+  \return The number of cells to reveal
+  \brief Finds the cells the flood fill of reveal reveals, without
+  changing any of them
+  \remarks Every step reveals the hidden neighbours of the empty cells
+  revealed by the step before, for all of them at once : the same cells as
+  the queue of floodReveal, in as many steps as the longest path
+*/
+PRESET_INLINE int64_t floodPreset(board* minefield, int64_t int_start, uint64_t* ptr_revealed, int64_t* ptr_visited, int int_width, int int_height)
+{
+  /* Variables */
+  const int int_cells = int_width * int_height;
+  const int int_words = (int_cells + 63) / 64;
+  uint64_t hasWest[PRESET_WORDS], hasEast[PRESET_WORDS];
+  uint64_t hidden[PRESET_WORDS], empty[PRESET_WORDS];
+  uint64_t frontier[PRESET_WORDS], west[PRESET_WORDS], east[PRESET_WORDS];
+  uint64_t row[PRESET_WORDS], up[PRESET_WORDS], down[PRESET_WORDS];
+  uint64_t int_bytes;
+  uint64_t int_grown;
+  uint64_t int_any;
+  int64_t int_revealed;
+  cell* ptr_cells;
+  int i;
+  int k;
+
+  ptr_cells = minefield->cells;
+  columnMasks(hasWest, hasEast, int_width, int_words);
+
+  /* Hidden cells, and cells without any mine on them or around them */
+  memset(hidden, 0, sizeof(hidden));
+  memset(empty, 0, sizeof(empty));
+  for (i = 0; i + 8 <= int_cells; i += 8) {
+    memcpy(&int_bytes, ptr_cells + i, sizeof(uint64_t));
+    hidden[i >> 6] |= ((((int_bytes >> 5) & SPREAD_MASK) * GATHER_BITS) >> 56) << (i & 63);
+    int_bytes &= SPREAD_MASK * (CELL_MINE | CELL_COUNT);
+    int_bytes = ~((int_bytes + SPREAD_MASK * 0x7F) >> 7) & SPREAD_MASK;
+    empty[i >> 6] |= ((int_bytes * GATHER_BITS) >> 56) << (i & 63);
+  }
+  for (i = int_cells & ~7; i < int_cells; i++) {
+    if (ptr_cells[i] & CELL_HIDDEN) hidden[i >> 6] |= 1ULL << (i & 63);
+    if ((ptr_cells[i] & (CELL_MINE | CELL_COUNT)) == 0) empty[i >> 6] |= 1ULL << (i & 63);
+  }
+
+  memset(frontier, 0, sizeof(frontier));
+  memset(ptr_revealed, 0, PRESET_WORDS * sizeof(uint64_t));
+  frontier[int_start >> 6] = 1ULL << (int_start & 63);
+  int_revealed = 0;
+  *ptr_visited = 0;
+
+  do {
+    /* The 8 neighbours of the frontier */
+    shiftUp(west, frontier, int_words, 1);
+    shiftDown(east, frontier, int_words, 1);
+    for (k = 0; k < int_words; k++) {
+      *ptr_visited += __builtin_popcountll(frontier[k]);
+      row[k] = frontier[k] | (west[k] & hasWest[k]) | (east[k] & hasEast[k]);
+    }
+    shiftUp(up, row, int_words, int_width);
+    shiftDown(down, row, int_words, int_width);
+
+    /* Reveal the hidden ones, the empty ones are the next frontier */
+    int_any = 0;
+    for (k = 0; k < int_words; k++) {
+      int_grown = (row[k] | up[k] | down[k]) & hidden[k] & ~ptr_revealed[k];
+      ptr_revealed[k] |= int_grown;
+      int_revealed += __builtin_popcountll(int_grown);
+      frontier[k] = int_grown & empty[k];
+      int_any |= frontier[k];
+    }
+  } while (int_any != 0);
+
+  return(int_revealed);
+}
+
+/*!
+  \def PRESET_KERNELS(W, H)
+  \brief Compiles countPreset and floodPreset for a minefield of W x H
+  cells, as countMinesWxH and floodCellsWxH
+  \remarks W*H can't be more than 64*PRESET_WORDS and W more than 62
+*/
+#define PRESET_KERNELS(W, H) \
+  static void countMines##W##x##H(board* minefield) \
+  { \
+    countPreset(minefield, W, H); \
+  } \
+  static int64_t floodCells##W##x##H(board* minefield, int64_t int_start, uint64_t* ptr_revealed, int64_t* ptr_visited) \
+  { \
+    return(floodPreset(minefield, int_start, ptr_revealed, ptr_visited, W, H)); \
+  }
+
+PRESET_KERNELS(9, 9)
+PRESET_KERNELS(16, 16)
+PRESET_KERNELS(30, 16)
+
+/*! Beginner, intermediate and expert minefields */
+static const presetKernels PRESETS[] = {
+  { 9, 9, countMines9x9, floodCells9x9 },
+  { 16, 16, countMines16x16, floodCells16x16 },
+  { 30, 16, countMines30x16, floodCells30x16 }
+};
+
+const presetKernels* findPreset(dimensions dim_dimensions)
+{
+  /* Variables */
+  int i;
+
+  for (i = 0; i < (int)(sizeof(PRESETS) / sizeof(PRESETS[0])); i++) {
+    if ( (PRESETS[i].width == dim_dimensions.width) && (PRESETS[i].height == dim_dimensions.height) ) return(&PRESETS[i]);
+  }
+
+  return(NULL);
+}
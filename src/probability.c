@@ -0,0 +1,1308 @@
+/*!
+  \file probability.c
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \brief Mine probabilities
+  \remarks None
+
+  Computes the exact probability of every hidden cell
+  to hold a mine. The frontier cells of a group are
+  handled one after the other : a state is the amount
+  of mines still needed by every number that has been
+  started but not finished, so arrangements that lead
+  to the same state are counted together instead of
+  being enumerated one by one. A forward pass counts
+  the arrangements by amount of mines, a backward pass
+  gives the weight of every cell holding a mine. Every
+  state only keeps the amounts of mines that can lead
+  to it.
+
+  The states grow with the amount of numbers started
+  but not finished, so the cells that the numbers
+  decide on their own are set aside first, which splits
+  the groups further, and the cells of a group are
+  decided along its longer side. Past a budget of
+  work, the counting stops instead of taking
+  seconds.
+
+*/
+
+#include "probability.h"
+
+#include <math.h>
+
+
+/* Custom types */
+/*! States of a group of frontier cells once its first cells have been decided */
+typedef struct {
+  int width;            /*!< amount of numbers started but not finished (bytes of a key) */
+  int64_t count;        /*!< amount of states */
+  int64_t capacity;     /*!< amount of states allocated */
+  uint8_t* keys;        /*!< mines still needed by every unfinished number, for every state */
+  int* low;             /*!< least amount of mines in the decided cells, for every state */
+  int* high;            /*!< most amount of mines in the decided cells, for every state */
+  int64_t* offset;      /*!< position of the weights of every state, and total amount of weights */
+  double* forward;      /*!< arrangements of the decided cells by amount of mines from low to high */
+  double* backward;     /*!< weight of the arrangements of the other cells, by amount of mines from low to high */
+  int64_t* next;        /*!< state of the next layer without then with a mine in the cell, -1 if impossible */
+  int64_t* table;       /*!< hash table of the states, -1 for an empty slot */
+  int64_t tableMask;    /*!< size of the hash table minus one */
+} layer;
+
+/*! How the needs of the numbers change when a frontier cell is decided */
+typedef struct {
+  int nKeep;            /*!< numbers still unfinished after the cell, they come first in the new key */
+  int* keepSrc;         /*!< position of each of them in the old key (closeSrc shares its allocation) */
+  uint8_t* keepDec;     /*!< 1 if the cell is one of their neighbours */
+  uint8_t* keepMax;     /*!< amount of their neighbours left after the cell (in the allocation of keepDec) */
+  int nNew;             /*!< numbers started by the cell, they come last in the new key */
+  uint8_t newNeed[8];   /*!< mines they need */
+  uint8_t newMax[8];    /*!< amount of their neighbours left after the cell */
+  int nClose;           /*!< numbers started earlier and finished by the cell */
+  int* closeSrc;        /*!< position of each of them in the old key */
+  int nSingle;          /*!< numbers whose only unknown neighbour is the cell */
+  uint8_t singleNeed[8]; /*!< mines they need */
+} plan;
+
+/*! A number with unknown neighbours */
+typedef struct {
+  int64_t index;        /*!< index of the revealed cell */
+  int need;             /*!< mines among its unknown neighbours */
+  int nCells;           /*!< amount of unknown neighbours */
+  int cells[8];         /*!< frontier ids of the unknown neighbours */
+  int group;            /*!< group of the number */
+  int first;            /*!< first position of its neighbours in the order of the group */
+  int last;             /*!< last position of its neighbours in the order of the group */
+} constraint;
+
+/*! Position of a frontier cell along the sweep of its group */
+typedef struct {
+  int64_t key;          /*!< coordinate along the longer side of the group, then along the other */
+  int id;               /*!< frontier id of the cell */
+} sweepCell;
+
+/*! Independent group of frontier cells */
+typedef struct {
+  int nCells;           /*!< amount of cells */
+  int* cells;           /*!< frontier ids of the cells, in the order they are decided */
+  int cap;              /*!< maximum amount of mines in the group */
+  layer* layers;        /*!< states before each cell and after the last one */
+  plan* plans;          /*!< transition of each cell */
+  double* total;        /*!< arrangements of the group by amount of mines */
+  double* ext;          /*!< weight of the rest of the minefield by amount of mines in the group */
+} group;
+
+/*! Everything needed while computing the probabilities */
+typedef struct {
+  board* minefield;     /*!< the minefield */
+  int nFrontier;        /*!< amount of frontier cells */
+  int64_t* frontier;    /*!< index of every frontier cell */
+  int* frontierId;      /*!< frontier id of every cell, -1 if not on the frontier */
+  int* parent;          /*!< union-find forest of the frontier cells */
+  int* cellConstraints; /*!< numbers of every frontier cell, 8 per cell */
+  uint8_t* nCellConstraints; /*!< amount of numbers of every frontier cell */
+  int8_t* decided;      /*!< value the numbers alone give to every frontier cell (1 for a mine), -1 if they don't */
+  int* queue;           /*!< numbers to look at again while deciding cells */
+  uint8_t* queued;      /*!< 1 for every number in the queue */
+  int queueHead;        /*!< position of the first number of the queue */
+  int queueLength;      /*!< amount of numbers in the queue */
+  int* order;           /*!< position of every frontier cell in its group */
+  int nConstraints;     /*!< amount of numbers with unknown neighbours */
+  constraint* constraints; /*!< the numbers with unknown neighbours */
+  int nGroups;          /*!< amount of groups */
+  group* groups;        /*!< the groups */
+  int64_t states;       /*!< amount of states allocated */
+  int64_t spent;        /*!< amount of states and of their weights by amount of mines computed */
+  int64_t budget;       /*!< most states and weights to compute */
+  int64_t mines;        /*!< mines left to find (mines minus flags, and the decided mines once they are known) */
+  int64_t outside;      /*!< unknown cells that are not on the frontier */
+} workspace;
+
+
+
+/*!
+  \fn static void* allocate(size_t size_bytes)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param size_bytes Bytes to allocate
+  \return Zeroed memory
+  \brief Allocates zeroed memory
+  \remarks Kills the program on allocation error
+*/
+static void* allocate(size_t size_bytes)
+{
+  /* Variables */
+  void* ptr_res;
+
+  ptr_res = calloc((size_bytes == 0) ? 1 : size_bytes, 1);
+
+  /* Kill the program if allocation error */
+  if (ptr_res == NULL) {
+    fprintf(stderr, "Memory allocation error.\n");
+    exit(MEMORY_ALLOCATION_ERROR);
+  }
+
+  return(ptr_res);
+}
+
+/*!
+  \fn static int findRoot(int* ptr_parent, int int_id)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param ptr_parent Union-find forest
+  \param int_id A frontier cell
+  \return The root of its tree
+  \brief Finds the group of a frontier cell, halving the path on the way
+  \remarks None
+*/
+static int findRoot(int* ptr_parent, int int_id)
+{
+  while (ptr_parent[int_id] != int_id) {
+    ptr_parent[int_id] = ptr_parent[ptr_parent[int_id]];
+    int_id = ptr_parent[int_id];
+  }
+
+  return(int_id);
+}
+
+/*!
+  \fn static int readFrontier(workspace* work)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.2 - decided cells
+  \param work The workspace, with its minefield
+  \return 0 on success, PROBABILITY_INCONSISTENT otherwise
+  \brief Finds the numbers with unknown neighbours, the frontier cells
+  and the numbers of every frontier cell
+  \remarks None
+*/
+static int readFrontier(workspace* work)
+{
+  /* Variables */
+  board* minefield;
+  int64_t i;
+  int64_t int_nCells;
+  int64_t int_unknown;
+  int int_x;
+  int int_y;
+  int int_dx;
+  int int_dy;
+  int int_flags;
+  int int_id;
+  int j;
+  constraint* cons;
+  cell cell_c;
+
+  minefield = work->minefield;
+  int_nCells = cellCount(minefield->dim);
+  work->frontierId = allocate(int_nCells * sizeof(int));
+  work->frontier = allocate(int_nCells * sizeof(int64_t));
+  work->constraints = allocate(int_nCells * sizeof(constraint));
+  for (i = 0; i < int_nCells; i++) work->frontierId[i] = -1;
+
+  int_unknown = 0;
+  for (i = 0; i < int_nCells; i++) {
+    cell_c = minefield->cells[i];
+    if (cell_c & CELL_HIDDEN) {
+      int_unknown += (cell_c & CELL_FLAG) == 0;
+      continue;
+    }
+
+    /* Unknown and flagged neighbours of a number */
+    cons = &work->constraints[work->nConstraints];
+    cons->index = i;
+    cons->nCells = 0;
+    int_flags = 0;
+    int_y = i / minefield->dim.width;
+    int_x = i - (int64_t)int_y * minefield->dim.width;
+    for (int_dy = -1; int_dy <= 1; int_dy++) {
+      if ( (int_y + int_dy < 0) || (int_y + int_dy >= minefield->dim.height) ) continue;
+      for (int_dx = -1; int_dx <= 1; int_dx++) {
+        if ( (int_x + int_dx < 0) || (int_x + int_dx >= minefield->dim.width) ) continue;
+        cell_c = CELL_AT(minefield, int_x + int_dx, int_y + int_dy);
+        if ((cell_c & CELL_HIDDEN) == 0) continue;
+        if (cell_c & CELL_FLAG) {
+          int_flags++;
+          continue;
+        }
+
+        int_id = work->frontierId[CELL_INDEX(minefield->dim, int_x + int_dx, int_y + int_dy)];
+        if (int_id < 0) {
+          int_id = work->nFrontier++;
+          work->frontierId[CELL_INDEX(minefield->dim, int_x + int_dx, int_y + int_dy)] = int_id;
+          work->frontier[int_id] = CELL_INDEX(minefield->dim, int_x + int_dx, int_y + int_dy);
+        }
+        cons->cells[cons->nCells++] = int_id;
+      }
+    }
+
+    cons->need = (minefield->cells[i] & CELL_COUNT) - int_flags;
+    if ( (cons->need < 0) || (cons->need > cons->nCells) ) return(PROBABILITY_INCONSISTENT);
+    if (cons->nCells > 0) work->nConstraints++;
+  }
+
+  work->mines = minefield->count.mines - minefield->count.flags;
+  work->outside = int_unknown - work->nFrontier;
+  if ( (work->mines < 0) || (work->mines > int_unknown) ) return(PROBABILITY_INCONSISTENT);
+
+  /* Numbers of every frontier cell */
+  work->cellConstraints = allocate(8 * (size_t)work->nFrontier * sizeof(int));
+  work->nCellConstraints = allocate(work->nFrontier);
+  for (i = 0; i < work->nConstraints; i++) {
+    cons = &work->constraints[i];
+    for (j = 0; j < cons->nCells; j++) {
+      int_id = cons->cells[j];
+      work->cellConstraints[8 * int_id + work->nCellConstraints[int_id]++] = i;
+    }
+  }
+
+  return(0);
+}
+
+/*!
+  \fn static int decideCell(workspace* work, int int_id, int int_value)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param work The workspace
+  \param int_id Frontier id of the cell
+  \param int_value 1 if the cell holds a mine, 0 otherwise
+  \return 0 on success, PROBABILITY_INCONSISTENT otherwise
+  \brief Sets a frontier cell aside with its value
+  \remarks The cell leaves its numbers, which are queued to be looked at again
+*/
+static int decideCell(workspace* work, int int_id, int int_value)
+{
+  /* Variables */
+  int j;
+  int k;
+  int int_pos;
+  constraint* cons;
+
+  work->decided[int_id] = int_value;
+  work->mines -= int_value;
+  for (j = 0; j < work->nCellConstraints[int_id]; j++) {
+    k = work->cellConstraints[8 * int_id + j];
+    cons = &work->constraints[k];
+    for (int_pos = 0; cons->cells[int_pos] != int_id; int_pos++) { }
+    cons->cells[int_pos] = cons->cells[--cons->nCells];
+    cons->need -= int_value;
+    if ( (cons->need < 0) || (cons->need > cons->nCells) ) return(PROBABILITY_INCONSISTENT);
+    if (work->queued[k] == 0) {
+      work->queue[(work->queueHead + work->queueLength) % work->nConstraints] = k;
+      work->queued[k] = 1;
+      work->queueLength++;
+    }
+  }
+
+  return(0);
+}
+
+/*!
+  \fn static int compareNumbers(constraint* cons, constraint* other, int* ptr_ids, int* ptr_values)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param cons A number
+  \param other A number sharing unknown neighbours with it
+  \param ptr_ids Where to store the frontier ids of the cells they decide, 16 at most
+  \param ptr_values Where to store their values
+  \return Amount of cells decided
+  \brief Looks for cells two numbers decide together
+  \remarks When a number needs as many more mines than the other as it
+  has cells of its own, these cells are mines and the cells only the other
+  has are safe
+*/
+static int compareNumbers(constraint* cons, constraint* other, int* ptr_ids, int* ptr_values)
+{
+  /* Variables */
+  int i;
+  int j;
+  int int_shared;
+  int int_count;
+  int int_value;
+  boolean bool_sharedCons[8];
+  boolean bool_sharedOther[8];
+  constraint* mines;
+
+  int_shared = 0;
+  for (j = 0; j < other->nCells; j++) bool_sharedOther[j] = false;
+  for (i = 0; i < cons->nCells; i++) {
+    bool_sharedCons[i] = false;
+    for (j = 0; j < other->nCells; j++) {
+      if (cons->cells[i] != other->cells[j]) continue;
+      bool_sharedCons[i] = true;
+      bool_sharedOther[j] = true;
+      int_shared++;
+    }
+  }
+  if (cons->need - other->need == cons->nCells - int_shared) mines = cons;
+  else if (other->need - cons->need == other->nCells - int_shared) mines = other;
+  else return(0);
+
+  int_count = 0;
+  for (i = 0; i < cons->nCells; i++) {
+    if (bool_sharedCons[i]) continue;
+    int_value = (mines == cons);
+    ptr_ids[int_count] = cons->cells[i];
+    ptr_values[int_count++] = int_value;
+  }
+  for (j = 0; j < other->nCells; j++) {
+    if (bool_sharedOther[j]) continue;
+    int_value = (mines == other);
+    ptr_ids[int_count] = other->cells[j];
+    ptr_values[int_count++] = int_value;
+  }
+
+  return(int_count);
+}
+
+/*!
+  \fn static int decideCells(workspace* work)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param work The workspace, with its frontier
+  \return 0 on success, PROBABILITY_INCONSISTENT otherwise
+  \brief Sets aside the frontier cells the numbers decide on their own
+  \remarks A number that needs no more mines makes its cells safe, one
+  that needs all of them makes them mines, and two numbers sharing cells
+  may decide the cells only one of them has (see compareNumbers). The
+  decided cells leave their numbers, which may decide more cells, and the
+  numbers left without any unknown cell are dropped : the groups are then
+  split on the decided cells, and much smaller on a minefield full of
+  numbers
+*/
+static int decideCells(workspace* work)
+{
+  /* Variables */
+  int i;
+  int j;
+  int k;
+  int n;
+  int int_id;
+  int int_res;
+  int int_count;
+  int int_kept;
+  int ptr_ids[16];
+  int ptr_values[16];
+  constraint* cons;
+  constraint* other;
+
+  work->decided = allocate(work->nFrontier);
+  memset(work->decided, 0xFF, work->nFrontier);
+  work->queue = allocate(work->nConstraints * sizeof(int));
+  work->queued = allocate(work->nConstraints);
+  for (i = 0; i < work->nConstraints; i++) {
+    work->queue[i] = i;
+    work->queued[i] = 1;
+  }
+  work->queueHead = 0;
+  work->queueLength = work->nConstraints;
+
+  int_res = 0;
+  while ( (work->queueLength > 0) && (int_res == 0) ) {
+    i = work->queue[work->queueHead];
+    work->queueHead = (work->queueHead + 1 == work->nConstraints) ? 0 : work->queueHead + 1;
+    work->queueLength--;
+    work->queued[i] = 0;
+    cons = &work->constraints[i];
+    if (cons->nCells == 0) continue;
+
+    /* Every cell of the number gets the same value */
+    if ( (cons->need == 0) || (cons->need == cons->nCells) ) {
+      while ( (cons->nCells > 0) && (int_res == 0) ) int_res = decideCell(work, cons->cells[0], (cons->need > 0));
+      continue;
+    }
+
+    /* Or the number decides cells with one of its neighbours */
+    int_count = 0;
+    for (j = 0; (j < cons->nCells) && (int_count == 0); j++) {
+      int_id = cons->cells[j];
+      for (k = 0; (k < work->nCellConstraints[int_id]) && (int_count == 0); k++) {
+        other = &work->constraints[work->cellConstraints[8 * int_id + k]];
+        if (other == cons) continue;
+        int_count = compareNumbers(cons, other, ptr_ids, ptr_values);
+      }
+    }
+    for (n = 0; (n < int_count) && (int_res == 0); n++) int_res = decideCell(work, ptr_ids[n], ptr_values[n]);
+    if ( (int_count > 0) && (work->queued[i] == 0) ) {
+      work->queue[(work->queueHead + work->queueLength) % work->nConstraints] = i;
+      work->queued[i] = 1;
+      work->queueLength++;
+    }
+  }
+  free(work->queue);
+  free(work->queued);
+  if (int_res != 0) return(int_res);
+  if (work->mines < 0) return(PROBABILITY_INCONSISTENT);
+
+  /* Numbers still with unknown cells, and the numbers of every cell again */
+  int_kept = 0;
+  for (i = 0; i < work->nConstraints; i++) {
+    if (work->constraints[i].nCells > 0) work->constraints[int_kept++] = work->constraints[i];
+  }
+  work->nConstraints = int_kept;
+  memset(work->nCellConstraints, 0, work->nFrontier);
+  for (i = 0; i < work->nConstraints; i++) {
+    cons = &work->constraints[i];
+    for (j = 0; j < cons->nCells; j++) {
+      int_id = cons->cells[j];
+      work->cellConstraints[8 * int_id + work->nCellConstraints[int_id]++] = i;
+    }
+  }
+
+  return(0);
+}
+
+/*!
+  \fn static int compareSweep(const void* ptr_a, const void* ptr_b)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param ptr_a A sweepCell
+  \param ptr_b Another sweepCell
+  \return Negative, zero or positive like strcmp
+  \brief Orders frontier cells along the sweep of their group, for qsort
+  \remarks None
+*/
+static int compareSweep(const void* ptr_a, const void* ptr_b)
+{
+  /* Variables */
+  int64_t int_a;
+  int64_t int_b;
+
+  int_a = ((const sweepCell*)ptr_a)->key;
+  int_b = ((const sweepCell*)ptr_b)->key;
+
+  return( (int_a > int_b) - (int_a < int_b) );
+}
+
+/*!
+  \fn static void buildGroups(workspace* work)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.2 - sweep
+  \param work The workspace, with its frontier and its decided cells
+  \brief Splits the cells that aren't decided into independent groups
+  and lists the cells of every group along its longer side
+  \remarks The states of a group grow with the amount of numbers started
+  but not finished. Sweeping the bounding box of the group column after
+  column (or row after row when it is taller than wide) keeps them to
+  about two columns of numbers, where a breadth first walk from a cell
+  keeps a whole ring of them
+*/
+static void buildGroups(workspace* work)
+{
+  /* Variables */
+  int i;
+  int j;
+  int k;
+  int int_root;
+  int int_x;
+  int int_y;
+  int int_minX;
+  int int_maxX;
+  int int_minY;
+  int int_maxY;
+  int int_width;
+  int int_height;
+  int* ptr_groupOf;
+  sweepCell* ptr_sweep;
+  group* grp;
+  constraint* cons;
+
+  /* The numbers link their cells */
+  work->parent = allocate(work->nFrontier * sizeof(int));
+  for (i = 0; i < work->nFrontier; i++) work->parent[i] = i;
+  for (i = 0; i < work->nConstraints; i++) {
+    cons = &work->constraints[i];
+    for (k = 1; k < cons->nCells; k++) work->parent[findRoot(work->parent, cons->cells[k])] = findRoot(work->parent, cons->cells[0]);
+  }
+
+  ptr_groupOf = allocate(work->nFrontier * sizeof(int));
+  work->order = allocate(work->nFrontier * sizeof(int));
+  work->groups = allocate(work->nFrontier * sizeof(group));
+  for (i = 0; i < work->nFrontier; i++) {
+    ptr_groupOf[i] = -1;
+    work->order[i] = -1;
+  }
+
+  /* Size of every group */
+  for (i = 0; i < work->nFrontier; i++) {
+    if (work->decided[i] >= 0) continue;
+    int_root = findRoot(work->parent, i);
+    if (ptr_groupOf[int_root] < 0) ptr_groupOf[int_root] = work->nGroups++;
+    work->groups[ptr_groupOf[int_root]].nCells++;
+  }
+  for (i = 0; i < work->nGroups; i++) {
+    work->groups[i].cells = allocate(work->groups[i].nCells * sizeof(int));
+    work->groups[i].nCells = 0;
+  }
+
+  for (i = 0; i < work->nFrontier; i++) {
+    if (work->decided[i] >= 0) continue;
+    grp = &work->groups[ptr_groupOf[findRoot(work->parent, i)]];
+    grp->cells[grp->nCells++] = i;
+  }
+
+  /* Sweep every group along its longer side */
+  int_width = work->minefield->dim.width;
+  int_height = work->minefield->dim.height;
+  ptr_sweep = allocate(work->nFrontier * sizeof(sweepCell));
+  for (i = 0; i < work->nGroups; i++) {
+    grp = &work->groups[i];
+    int_minX = int_width;
+    int_maxX = -1;
+    int_minY = int_height;
+    int_maxY = -1;
+    for (j = 0; j < grp->nCells; j++) {
+      int_y = work->frontier[grp->cells[j]] / int_width;
+      int_x = work->frontier[grp->cells[j]] - (int64_t)int_y * int_width;
+      if (int_x < int_minX) int_minX = int_x;
+      if (int_x > int_maxX) int_maxX = int_x;
+      if (int_y < int_minY) int_minY = int_y;
+      if (int_y > int_maxY) int_maxY = int_y;
+    }
+    for (j = 0; j < grp->nCells; j++) {
+      int_y = work->frontier[grp->cells[j]] / int_width;
+      int_x = work->frontier[grp->cells[j]] - (int64_t)int_y * int_width;
+      ptr_sweep[j].id = grp->cells[j];
+      ptr_sweep[j].key = (int_maxX - int_minX >= int_maxY - int_minY) ? (int64_t)int_x * int_height + int_y : work->frontier[grp->cells[j]];
+    }
+    qsort(ptr_sweep, grp->nCells, sizeof(sweepCell), compareSweep);
+    for (j = 0; j < grp->nCells; j++) {
+      grp->cells[j] = ptr_sweep[j].id;
+      work->order[grp->cells[j]] = j;
+    }
+  }
+  free(ptr_sweep);
+
+  /* Span of every number in the order of its group */
+  for (i = 0; i < work->nConstraints; i++) {
+    cons = &work->constraints[i];
+    cons->group = ptr_groupOf[findRoot(work->parent, cons->cells[0])];
+    cons->first = work->order[cons->cells[0]];
+    cons->last = cons->first;
+    for (k = 1; k < cons->nCells; k++) {
+      if (work->order[cons->cells[k]] < cons->first) cons->first = work->order[cons->cells[k]];
+      if (work->order[cons->cells[k]] > cons->last) cons->last = work->order[cons->cells[k]];
+    }
+  }
+
+  free(ptr_groupOf);
+}
+
+/*!
+  \fn static int cellsAfter(workspace* work, constraint* cons, int int_pos, boolean* ptr_contains)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param work The workspace
+  \param cons A number
+  \param int_pos A position in the order of its group
+  \param ptr_contains Where to store true if the cell at this position is a neighbour
+  \return Amount of its unknown neighbours after this position
+  \brief Looks at the neighbours of a number around a position
+  \remarks None
+*/
+static int cellsAfter(workspace* work, constraint* cons, int int_pos, boolean* ptr_contains)
+{
+  /* Variables */
+  int k;
+  int int_res;
+
+  int_res = 0;
+  *ptr_contains = false;
+  for (k = 0; k < cons->nCells; k++) {
+    if (work->order[cons->cells[k]] > int_pos) int_res++;
+    if (work->order[cons->cells[k]] == int_pos) *ptr_contains = true;
+  }
+
+  return(int_res);
+}
+
+/*!
+  \fn static void buildPlans(workspace* work, group* grp)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param work The workspace
+  \param grp The group
+  \brief Computes the transition of every cell of a group
+  \remarks Also sets the width of every layer
+*/
+static void buildPlans(workspace* work, group* grp)
+{
+  /* Variables */
+  int i;
+  int j;
+  int int_nActive;
+  int int_nNext;
+  int int_id;
+  int* ptr_active;
+  int* ptr_next;
+  int* ptr_swap;
+  boolean bool_contains;
+  constraint* cons;
+  plan* pl;
+
+  ptr_active = allocate(work->nConstraints * sizeof(int));
+  ptr_next = allocate(work->nConstraints * sizeof(int));
+  grp->plans = allocate(grp->nCells * sizeof(plan));
+  grp->layers = allocate((grp->nCells + 1) * sizeof(layer));
+  int_nActive = 0;
+
+  for (i = 0; i < grp->nCells; i++) {
+    pl = &grp->plans[i];
+    int_id = grp->cells[i];
+    pl->keepSrc = allocate(2 * (int_nActive + 1) * sizeof(int));
+    pl->closeSrc = pl->keepSrc + int_nActive + 1;
+    pl->keepDec = allocate(2 * (int_nActive + 1));
+    pl->keepMax = pl->keepDec + int_nActive + 1;
+    grp->layers[i].width = int_nActive;
+
+    /* Numbers already started */
+    int_nNext = 0;
+    for (j = 0; j < int_nActive; j++) {
+      cons = &work->constraints[ptr_active[j]];
+      if (cons->last == i) {
+        pl->closeSrc[pl->nClose++] = j;
+        continue;
+      }
+      pl->keepSrc[pl->nKeep] = j;
+      pl->keepMax[pl->nKeep] = cellsAfter(work, cons, i, &bool_contains);
+      pl->keepDec[pl->nKeep] = bool_contains;
+      pl->nKeep++;
+      ptr_next[int_nNext++] = ptr_active[j];
+    }
+
+    /* Numbers started by this cell */
+    for (j = 0; j < work->nCellConstraints[int_id]; j++) {
+      cons = &work->constraints[work->cellConstraints[8 * int_id + j]];
+      if (cons->first != i) continue;
+      if (cons->last == i) {
+        pl->singleNeed[pl->nSingle++] = cons->need;
+        continue;
+      }
+      pl->newNeed[pl->nNew] = cons->need;
+      pl->newMax[pl->nNew] = cellsAfter(work, cons, i, &bool_contains);
+      pl->nNew++;
+      ptr_next[int_nNext++] = work->cellConstraints[8 * int_id + j];
+    }
+
+    ptr_swap = ptr_active;
+    ptr_active = ptr_next;
+    ptr_next = ptr_swap;
+    int_nActive = int_nNext;
+  }
+  grp->layers[grp->nCells].width = int_nActive;
+
+  free(ptr_active);
+  free(ptr_next);
+}
+
+/*!
+  \fn static boolean applyPlan(plan* pl, const uint8_t* ptr_key, int int_value, uint8_t* ptr_next)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param pl The transition of the cell
+  \param ptr_key State before the cell
+  \param int_value 1 if the cell holds a mine, 0 otherwise
+  \param ptr_next Where to store the state after the cell
+  \return true if the numbers can still be satisfied
+  \brief Decides a cell
+  \remarks None
+*/
+static boolean applyPlan(plan* pl, const uint8_t* ptr_key, int int_value, uint8_t* ptr_next)
+{
+  /* Variables */
+  int j;
+  int int_need;
+
+  for (j = 0; j < pl->nClose; j++) {
+    if (ptr_key[pl->closeSrc[j]] != int_value) return(false);
+  }
+  for (j = 0; j < pl->nSingle; j++) {
+    if (pl->singleNeed[j] != int_value) return(false);
+  }
+  for (j = 0; j < pl->nKeep; j++) {
+    int_need = ptr_key[pl->keepSrc[j]] - (pl->keepDec[j] ? int_value : 0);
+    if ( (int_need < 0) || (int_need > pl->keepMax[j]) ) return(false);
+    ptr_next[j] = int_need;
+  }
+  for (j = 0; j < pl->nNew; j++) {
+    int_need = pl->newNeed[j] - int_value;
+    if ( (int_need < 0) || (int_need > pl->newMax[j]) ) return(false);
+    ptr_next[pl->nKeep + j] = int_need;
+  }
+
+  return(true);
+}
+
+/*!
+  \fn static uint64_t hashKey(const uint8_t* ptr_key, int int_width)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param ptr_key A state
+  \param int_width Bytes of the state
+  \return Hash of the state
+  \brief FNV-1a hash of a state
+  \remarks None
+*/
+static uint64_t hashKey(const uint8_t* ptr_key, int int_width)
+{
+  /* Variables */
+  int i;
+  uint64_t int_hash;
+
+  int_hash = 0xCBF29CE484222325ULL;
+  for (i = 0; i < int_width; i++) int_hash = (int_hash ^ ptr_key[i]) * 0x100000001B3ULL;
+
+  return(int_hash);
+}
+
+/*!
+  \fn static int64_t findState(layer* lay, const uint8_t* ptr_key)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param lay The layer
+  \param ptr_key The state
+  \return Position in the hash table of the state, or of the empty slot
+  where it would go
+  \brief Looks a state up
+  \remarks None
+*/
+static int64_t findState(layer* lay, const uint8_t* ptr_key)
+{
+  /* Variables */
+  int64_t int_slot;
+  int64_t int_state;
+
+  int_slot = hashKey(ptr_key, lay->width) & lay->tableMask;
+  while ( (int_state = lay->table[int_slot]) >= 0 ) {
+    if (memcmp(lay->keys + int_state * lay->width, ptr_key, lay->width) == 0) return(int_slot);
+    int_slot = (int_slot + 1) & lay->tableMask;
+  }
+
+  return(int_slot);
+}
+
+/*!
+  \fn static void growLayer(layer* lay)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param lay The layer
+  \brief Doubles the room for states of a layer and rebuilds its hash table
+  \remarks None
+*/
+static void growLayer(layer* lay)
+{
+  /* Variables */
+  int64_t i;
+  int64_t int_capacity;
+
+  int_capacity = (lay->capacity == 0) ? 16 : 2 * lay->capacity;
+  lay->keys = realloc(lay->keys, int_capacity * (lay->width + 1));
+  lay->low = realloc(lay->low, int_capacity * sizeof(int));
+  lay->high = realloc(lay->high, int_capacity * sizeof(int));
+  lay->next = realloc(lay->next, int_capacity * 2 * sizeof(int64_t));
+
+  /* Kill the program if allocation error */
+  if ( (lay->keys == NULL) || (lay->low == NULL) || (lay->high == NULL) || (lay->next == NULL) ) {
+    fprintf(stderr, "Memory allocation error.\n");
+    exit(MEMORY_ALLOCATION_ERROR);
+  }
+  lay->capacity = int_capacity;
+
+  /* Hash table at most half full */
+  free(lay->table);
+  lay->tableMask = 2 * int_capacity - 1;
+  lay->table = allocate(2 * int_capacity * sizeof(int64_t));
+  memset(lay->table, 0xFF, 2 * int_capacity * sizeof(int64_t));
+  for (i = 0; i < lay->count; i++) lay->table[findState(lay, lay->keys + i * lay->width)] = i;
+}
+
+/*!
+  \fn static int64_t addState(workspace* work, layer* lay, const uint8_t* ptr_key)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param work The workspace
+  \param lay The layer
+  \param ptr_key The state
+  \return Number of the state in the layer, -1 if there are too many states
+  \brief Finds a state, adding it with no amount of mines if it is new
+  \remarks None
+*/
+static int64_t addState(workspace* work, layer* lay, const uint8_t* ptr_key)
+{
+  /* Variables */
+  int64_t int_slot;
+
+  if (lay->count == lay->capacity) growLayer(lay);
+  int_slot = findState(lay, ptr_key);
+  if (lay->table[int_slot] >= 0) return(lay->table[int_slot]);
+
+  if (++work->states > PROBABILITY_MAX_STATES) return(-1);
+  memcpy(lay->keys + lay->count * lay->width, ptr_key, lay->width);
+  lay->low[lay->count] = INT32_MAX;
+  lay->high[lay->count] = -1;
+  lay->table[int_slot] = lay->count;
+
+  return(lay->count++);
+}
+
+/*!
+  \fn static void placeWeights(layer* lay)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param lay The layer, with the amounts of mines of all its states
+  \brief Lays the weights of the states out one after the other
+  \remarks None
+*/
+static void placeWeights(layer* lay)
+{
+  /* Variables */
+  int64_t s;
+
+  lay->offset = allocate((lay->count + 1) * sizeof(int64_t));
+  for (s = 0; s < lay->count; s++) lay->offset[s + 1] = lay->offset[s] + lay->high[s] - lay->low[s] + 1;
+  lay->forward = allocate(lay->offset[lay->count] * sizeof(double));
+}
+
+/*!
+  \fn static int forwardPass(workspace* work, group* grp)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.2 - budget
+  \param work The workspace
+  \param grp The group, with its plans
+  \return 0 on success, PROBABILITY_INCONSISTENT or PROBABILITY_TOO_COMPLEX
+  \brief Counts the arrangements of the first cells of a group leading to
+  every state, by amount of mines, and of the whole group
+  \remarks Gives up as soon as the states and their weights by amount of
+  mines, for all the groups, go over the budget
+*/
+static int forwardPass(workspace* work, group* grp)
+{
+  /* Variables */
+  int i;
+  int v;
+  int a;
+  int int_len;
+  int64_t s;
+  int64_t int_next;
+  uint8_t ptr_key[8 * 64];
+  uint8_t* ptr_next;
+  layer* lay;
+  layer* lay_next;
+  double* ptr_from;
+  double* ptr_to;
+
+  grp->cap = (work->mines < grp->nCells) ? work->mines : grp->nCells;
+
+  /* Nothing decided yet */
+  lay = &grp->layers[0];
+  if (addState(work, lay, ptr_key) < 0) return(PROBABILITY_TOO_COMPLEX);
+  lay->low[0] = 0;
+  lay->high[0] = 0;
+  placeWeights(lay);
+  lay->forward[0] = 1.0;
+
+  for (i = 0; i < grp->nCells; i++) {
+    lay = &grp->layers[i];
+    lay_next = &grp->layers[i + 1];
+    ptr_next = (lay_next->width <= (int)sizeof(ptr_key)) ? ptr_key : allocate(lay_next->width);
+
+    /* States reached by the cell, and their amounts of mines */
+    for (s = 0; s < lay->count; s++) {
+      for (v = 0; v <= 1; v++) {
+        lay->next[2 * s + v] = -1;
+        if (lay->low[s] + v > grp->cap) continue;
+        if (applyPlan(&grp->plans[i], lay->keys + s * lay->width, v, ptr_next) == false) continue;
+        int_next = addState(work, lay_next, ptr_next);
+        if ( (int_next < 0) || (work->spent + lay_next->count > work->budget) ) {
+          if (ptr_next != ptr_key) free(ptr_next);
+          return(PROBABILITY_TOO_COMPLEX);
+        }
+        lay->next[2 * s + v] = int_next;
+        if (lay->low[s] + v < lay_next->low[int_next]) lay_next->low[int_next] = lay->low[s] + v;
+        if (lay->high[s] + v > lay_next->high[int_next]) lay_next->high[int_next] = lay->high[s] + v;
+        if (lay_next->high[int_next] > grp->cap) lay_next->high[int_next] = grp->cap;
+      }
+    }
+    if (ptr_next != ptr_key) free(ptr_next);
+
+    /* Arrangements leading to them */
+    placeWeights(lay_next);
+    work->spent += lay_next->count + lay_next->offset[lay_next->count];
+    if (work->spent > work->budget) return(PROBABILITY_TOO_COMPLEX);
+    for (s = 0; s < lay->count; s++) {
+      ptr_from = lay->forward + lay->offset[s];
+      for (v = 0; v <= 1; v++) {
+        int_next = lay->next[2 * s + v];
+        if (int_next < 0) continue;
+        ptr_to = lay_next->forward + lay_next->offset[int_next] + (lay->low[s] + v - lay_next->low[int_next]);
+        int_len = ((lay->high[s] < lay_next->high[int_next] - v) ? lay->high[s] : lay_next->high[int_next] - v) - lay->low[s] + 1;
+        for (a = 0; a < int_len; a++) ptr_to[a] += ptr_from[a];
+      }
+    }
+  }
+
+  /* Every number must be satisfied at the end */
+  lay = &grp->layers[grp->nCells];
+  if (lay->count == 0) return(PROBABILITY_INCONSISTENT);
+  grp->total = allocate((grp->cap + 1) * sizeof(double));
+  for (s = 0; s < lay->count; s++) {
+    for (a = lay->low[s]; a <= lay->high[s]; a++) grp->total[a] += lay->forward[lay->offset[s] + a - lay->low[s]];
+  }
+
+  return(0);
+}
+
+/*!
+  \fn static void convolve(const double* ptr_a, int int_lenA, const double* ptr_b, int int_lenB, double* ptr_res, int int_lenRes)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param ptr_a First weights by amount of mines
+  \param int_lenA Length of the first weights
+  \param ptr_b Second weights by amount of mines
+  \param int_lenB Length of the second weights
+  \param ptr_res Where to store the weights of both, by total amount of mines
+  \param int_lenRes Length of the result, longer totals are dropped
+  \brief Combines the weights of two independent parts
+  \remarks None
+*/
+static void convolve(const double* ptr_a, int int_lenA, const double* ptr_b, int int_lenB, double* ptr_res, int int_lenRes)
+{
+  /* Variables */
+  int i;
+  int j;
+
+  memset(ptr_res, 0, int_lenRes * sizeof(double));
+  for (i = 0; i < int_lenA; i++) {
+    if (ptr_a[i] == 0.0) continue;
+    for (j = 0; (j < int_lenB) && (i + j < int_lenRes); j++) ptr_res[i + j] += ptr_a[i] * ptr_b[j];
+  }
+}
+
+/*!
+  \fn static double* outsideWeights(workspace* work, int int_len)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.2 - reentrant
+  \param work The workspace
+  \param int_len Amount of totals, from 0 mines on the frontier
+  \return Weight of every amount of mines on the frontier : the ways to
+  place the other mines in the cells outside of it, relative to the
+  largest one
+  \brief Binomial weights of the cells outside of the frontier
+  \remarks Computed as logarithms, the binomials overflow on big minefields.
+  The solvers of the simulation and of the generator run on every thread :
+  lgamma_r keeps the sign to itself where lgamma writes the global signgam
+*/
+static double* outsideWeights(workspace* work, int int_len)
+{
+  /* Variables */
+  int k;
+  int int_sign;
+  int64_t int_rest;
+  double* ptr_weights;
+  double int_max;
+  double int_logOutside;
+
+  ptr_weights = allocate(int_len * sizeof(double));
+  int_max = -HUGE_VAL;
+  int_logOutside = lgamma_r(work->outside + 1.0, &int_sign);
+  for (k = 0; k < int_len; k++) {
+    int_rest = work->mines - k;
+    if ( (int_rest < 0) || (int_rest > work->outside) ) {
+      ptr_weights[k] = -HUGE_VAL;
+      continue;
+    }
+    ptr_weights[k] = int_logOutside - lgamma_r(int_rest + 1.0, &int_sign) - lgamma_r(work->outside - int_rest + 1.0, &int_sign);
+    if (ptr_weights[k] > int_max) int_max = ptr_weights[k];
+  }
+  for (k = 0; k < int_len; k++) ptr_weights[k] = (ptr_weights[k] == -HUGE_VAL) ? 0.0 : exp(ptr_weights[k] - int_max);
+
+  return(ptr_weights);
+}
+
+/*!
+  \fn static double combineGroups(workspace* work, double* ptr_outsideProb)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param work The workspace, with the totals of every group
+  \param ptr_outsideProb Where to store the probability of a cell outside of the frontier
+  \return Total weight of every arrangement, 0 if there is none
+  \brief Computes the weight of the rest of the minefield for every group
+  and amount of mines in it
+  \remarks None
+*/
+static double combineGroups(workspace* work, double* ptr_outsideProb)
+{
+  /* Variables */
+  int i;
+  int k;
+  int m;
+  int int_len;
+  double** ptr_prefix;
+  double** ptr_suffix;
+  double* ptr_others;
+  double* ptr_weights;
+  double int_scale;
+  double int_total;
+  double int_outside;
+  group* grp;
+
+  /* The totals fit in the frontier, and can't hold more than the mines left */
+  int_len = ((work->mines < work->nFrontier) ? work->mines : work->nFrontier) + 1;
+  ptr_weights = outsideWeights(work, int_len);
+
+  /* Same scale for every group, only the ratios matter */
+  for (i = 0; i < work->nGroups; i++) {
+    grp = &work->groups[i];
+    int_scale = 0.0;
+    for (k = 0; k <= grp->cap; k++) if (grp->total[k] > int_scale) int_scale = grp->total[k];
+    for (k = 0; k <= grp->cap; k++) grp->total[k] /= int_scale;
+  }
+
+  /* Combined totals of the groups before and after every group */
+  ptr_prefix = allocate((work->nGroups + 1) * sizeof(double*));
+  ptr_suffix = allocate((work->nGroups + 1) * sizeof(double*));
+  ptr_prefix[0] = allocate(int_len * sizeof(double));
+  ptr_prefix[0][0] = 1.0;
+  ptr_suffix[work->nGroups] = allocate(int_len * sizeof(double));
+  ptr_suffix[work->nGroups][0] = 1.0;
+  for (i = 0; i < work->nGroups; i++) {
+    ptr_prefix[i + 1] = allocate(int_len * sizeof(double));
+    convolve(ptr_prefix[i], int_len, work->groups[i].total, work->groups[i].cap + 1, ptr_prefix[i + 1], int_len);
+  }
+  for (i = work->nGroups - 1; i >= 0; i--) {
+    ptr_suffix[i] = allocate(int_len * sizeof(double));
+    convolve(ptr_suffix[i + 1], int_len, work->groups[i].total, work->groups[i].cap + 1, ptr_suffix[i], int_len);
+  }
+
+  /* Weight of the rest for every amount of mines in a group */
+  ptr_others = allocate(int_len * sizeof(double));
+  for (i = 0; i < work->nGroups; i++) {
+    grp = &work->groups[i];
+    convolve(ptr_prefix[i], int_len, ptr_suffix[i + 1], int_len, ptr_others, int_len);
+    grp->ext = allocate((grp->cap + 1) * sizeof(double));
+    for (k = 0; k <= grp->cap; k++) {
+      for (m = 0; k + m < int_len; m++) grp->ext[k] += ptr_others[m] * ptr_weights[k + m];
+    }
+  }
+
+  /* Everything, and the mines expected outside of the frontier */
+  int_total = 0.0;
+  int_outside = 0.0;
+  for (k = 0; k < int_len; k++) {
+    int_total += ptr_prefix[work->nGroups][k] * ptr_weights[k];
+    int_outside += ptr_prefix[work->nGroups][k] * ptr_weights[k] * (work->mines - k);
+  }
+  *ptr_outsideProb = ( (work->outside > 0) && (int_total > 0.0) ) ? int_outside / int_total / work->outside : 0.0;
+
+  for (i = 0; i <= work->nGroups; i++) {
+    free(ptr_prefix[i]);
+    free(ptr_suffix[i]);
+  }
+  free(ptr_prefix);
+  free(ptr_suffix);
+  free(ptr_others);
+  free(ptr_weights);
+
+  return(int_total);
+}
+
+/*!
+  \fn static void backwardPass(workspace* work, group* grp, double* ptr_prob)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param work The workspace
+  \param grp The group, after its forward pass and with its outside weights
+  \param ptr_prob The probabilities to fill
+  \brief Weighs every state by the arrangements of the cells after it and
+  the rest of the minefield, giving the probability of every cell
+  \remarks The transitions recorded by the forward pass are followed back,
+  no state is looked up again
+*/
+static void backwardPass(workspace* work, group* grp, double* ptr_prob)
+{
+  /* Variables */
+  int i;
+  int v;
+  int a;
+  int int_len;
+  int64_t s;
+  int64_t int_next;
+  double* ptr_mine;
+  double* ptr_from;
+  double* ptr_to;
+  double* ptr_forward;
+  double int_total;
+  layer* lay;
+  layer* lay_next;
+
+  ptr_mine = allocate(grp->nCells * sizeof(double));
+
+  /* After the last cell only the rest of the minefield is left */
+  lay = &grp->layers[grp->nCells];
+  lay->backward = allocate(lay->offset[lay->count] * sizeof(double));
+  for (s = 0; s < lay->count; s++) {
+    for (a = lay->low[s]; a <= lay->high[s]; a++) lay->backward[lay->offset[s] + a - lay->low[s]] = grp->ext[a];
+  }
+
+  for (i = grp->nCells - 1; i >= 0; i--) {
+    lay = &grp->layers[i];
+    lay_next = &grp->layers[i + 1];
+    lay->backward = allocate(lay->offset[lay->count] * sizeof(double));
+
+    for (s = 0; s < lay->count; s++) {
+      ptr_to = lay->backward + lay->offset[s];
+      ptr_forward = lay->forward + lay->offset[s];
+      for (v = 0; v <= 1; v++) {
+        int_next = lay->next[2 * s + v];
+        if (int_next < 0) continue;
+        ptr_from = lay_next->backward + lay_next->offset[int_next] + (lay->low[s] + v - lay_next->low[int_next]);
+        int_len = ((lay->high[s] < lay_next->high[int_next] - v) ? lay->high[s] : lay_next->high[int_next] - v) - lay->low[s] + 1;
+        for (a = 0; a < int_len; a++) ptr_to[a] += ptr_from[a];
+        if (v == 1) {
+          for (a = 0; a < int_len; a++) ptr_mine[i] += ptr_forward[a] * ptr_from[a];
+        }
+      }
+    }
+  }
+
+  /* Every arrangement goes through the single state before the first cell */
+  int_total = grp->layers[0].backward[0];
+  for (i = 0; i < grp->nCells; i++) {
+    ptr_prob[work->frontier[grp->cells[i]]] = (int_total > 0.0) ? ptr_mine[i] / int_total : 0.0;
+  }
+
+  free(ptr_mine);
+}
+
+/*!
+  \fn static void freeWorkspace(workspace* work)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param work The workspace
+  \brief Releases everything allocated while computing the probabilities
+  \remarks None
+*/
+static void freeWorkspace(workspace* work)
+{
+  /* Variables */
+  int i;
+  int j;
+  group* grp;
+
+  for (i = 0; i < work->nGroups; i++) {
+    grp = &work->groups[i];
+    if (grp->plans != NULL) {
+      for (j = 0; j < grp->nCells; j++) {
+        free(grp->plans[j].keepSrc);
+        free(grp->plans[j].keepDec);
+      }
+    }
+    if (grp->layers != NULL) {
+      for (j = 0; j <= grp->nCells; j++) {
+        free(grp->layers[j].keys);
+        free(grp->layers[j].forward);
+        free(grp->layers[j].backward);
+        free(grp->layers[j].table);
+        free(grp->layers[j].next);
+        free(grp->layers[j].low);
+        free(grp->layers[j].high);
+        free(grp->layers[j].offset);
+      }
+    }
+    free(grp->plans);
+    free(grp->layers);
+    free(grp->cells);
+    free(grp->total);
+    free(grp->ext);
+  }
+
+  free(work->groups);
+  free(work->frontier);
+  free(work->frontierId);
+  free(work->parent);
+  free(work->cellConstraints);
+  free(work->nCellConstraints);
+  free(work->decided);
+  free(work->order);
+  free(work->constraints);
+}
+
+int computeProbabilities(board* minefield, double* ptr_prob, int64_t int_budget)
+{
+  /* Variables */
+  int i;
+  int int_res;
+  int64_t j;
+  int64_t int_nCells;
+  double int_outsideProb;
+  workspace work;
+
+  memset(&work, 0, sizeof(workspace));
+  work.minefield = minefield;
+  work.budget = int_budget;
+
+  int_res = readFrontier(&work);
+  if (int_res == 0) int_res = decideCells(&work);
+  if (int_res == 0) {
+    buildGroups(&work);
+    for (i = 0; (i < work.nGroups) && (int_res == 0); i++) {
+      buildPlans(&work, &work.groups[i]);
+      int_res = forwardPass(&work, &work.groups[i]);
+    }
+  }
+  if ( (int_res == 0) && (combineGroups(&work, &int_outsideProb) <= 0.0) ) int_res = PROBABILITY_INCONSISTENT;
+
+  if (int_res == 0) {
+    int_nCells = cellCount(minefield->dim);
+    for (j = 0; j < int_nCells; j++) {
+      ptr_prob[j] = ((minefield->cells[j] & (CELL_HIDDEN | CELL_FLAG)) == CELL_HIDDEN) ? int_outsideProb : -1.0;
+    }
+    for (i = 0; i < work.nGroups; i++) backwardPass(&work, &work.groups[i], ptr_prob);
+    for (i = 0; i < work.nFrontier; i++) {
+      if (work.decided[i] >= 0) ptr_prob[work.frontier[i]] = work.decided[i];
+    }
+  }
+
+  freeWorkspace(&work);
+
+  return(int_res);
+}
+
+int64_t safestCell(board* minefield, double* ptr_prob)
+{
+  /* Variables */
+  int64_t i;
+  int64_t int_nCells;
+  int64_t int_best;
+
+  int_best = -1;
+  int_nCells = cellCount(minefield->dim);
+  for (i = 0; i < int_nCells; i++) {
+    if (ptr_prob[i] < 0.0) continue;
+    if ( (int_best < 0) || (ptr_prob[i] < ptr_prob[int_best]) ) int_best = i;
+  }
+
+  return(int_best);
+}
@@ -0,0 +1,114 @@
+/*!
+  \file random.c
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \brief Random numbers
+  \remarks None
+
+  Small, fast and seedable pseudo random number
+  generator (xoshiro256**). Each game owns its
+  generator, there is no hidden global state.
+
+*/
+
+#include "random.h"
+
+
+
+/*!
+  \fn static uint64_t splitmix64(uint64_t* ptr_state)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param ptr_state State of the sequence
+  \return The next number of the sequence
+  \brief splitmix64 sequence, used to expand seeds
+  \remarks None
+*/
+static uint64_t splitmix64(uint64_t* ptr_state)
+{
+  /* Variables */
+  uint64_t int_z;
+
+  int_z = (*ptr_state += 0x9E3779B97F4A7C15ULL);
+  int_z = (int_z ^ (int_z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  int_z = (int_z ^ (int_z >> 27)) * 0x94D049BB133111EBULL;
+
+  return(int_z ^ (int_z >> 31));
+}
+
+/*!
+  \fn static uint64_t rotateLeft(uint64_t int_x, int int_k)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param int_x Word to rotate
+  \param int_k Amount of bits
+  \return The rotated word
+  \brief Rotates a word to the left
+  \remarks None
+*/
+static uint64_t rotateLeft(uint64_t int_x, int int_k)
+{
+  return((int_x << int_k) | (int_x >> (64 - int_k)));
+}
+
+void seedRng(rng* gen, uint64_t int_seed)
+{
+  /* Variables */
+  int i;
+
+  for (i = 0; i < 4; i++) gen->s[i] = splitmix64(&int_seed);
+}
+
+uint64_t nextRandom(rng* gen)
+{
+  /* Variables */
+  uint64_t int_res;
+  uint64_t int_t;
+
+  int_res = rotateLeft(gen->s[1] * 5, 7) * 9;
+  int_t = gen->s[1] << 17;
+
+  gen->s[2] ^= gen->s[0];
+  gen->s[3] ^= gen->s[1];
+  gen->s[1] ^= gen->s[2];
+  gen->s[0] ^= gen->s[3];
+  gen->s[2] ^= int_t;
+  gen->s[3] = rotateLeft(gen->s[3], 45);
+
+  return(int_res);
+}
+
+uint64_t boundedRandom(rng* gen, uint64_t int_bound)
+{
+  /* Variables */
+  unsigned __int128 int_product;
+  uint64_t int_low;
+  uint64_t int_threshold;
+
+  int_product = (unsigned __int128)nextRandom(gen) * int_bound;
+  int_low = (uint64_t)int_product;
+
+  /* Reject the few draws that would bias the result */
+  if (int_low < int_bound) {
+    int_threshold = -int_bound % int_bound;
+    while (int_low < int_threshold) {
+      int_product = (unsigned __int128)nextRandom(gen) * int_bound;
+      int_low = (uint64_t)int_product;
+    }
+  }
+
+  return((uint64_t)(int_product >> 64));
+}
+
+uint64_t mixSeed(uint64_t int_seed, uint64_t int_value)
+{
+  /* Variables */
+  uint64_t int_state;
+
+  int_state = int_seed ^ splitmix64(&int_value);
+
+  return(splitmix64(&int_state));
+}
@@ -0,0 +1,738 @@
+/*!
+  \file render.c
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \brief Renderer
+  \remarks None
+
+  Builds each frame of the minefield in a reusable
+  buffer from precomputed glyphs and writes it to
+  the terminal with a single write. Only the view
+  (the part of the minefield that fits the terminal)
+  is printed, a minimap sums up the rest.
+
+*/
+
+#include "render.h"
+#include "stats.h"
+
+#include <errno.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+
+/*! Glyph of a hidden cell */
+#define GLYPH_HIDDEN 0
+/*! Glyph of a cell with a flag */
+#define GLYPH_FLAG 1
+/*! Glyph of a bomb */
+#define GLYPH_BOMB 2
+/*! Glyph of a revealed cell without adjacent mines, GLYPH_EMPTY+n has n adjacent mines */
+#define GLYPH_EMPTY 3
+
+/*! Colour number meaning no colour */
+#define COLOUR_NONE 0
+
+
+/* Custom types */
+/*! Text and colour of a glyph */
+typedef struct {
+  const char* text;   /*!< 3 columns of text */
+  int colour;         /*!< colour number (index in COLOURS) */
+} glyphStyle;
+
+/*! Colour escapes, indexed by colour number */
+static const char* const COLOURS[] = { reset, RED, GREEN, CYAN, BLUE, YELLOW };
+
+/*! Every glyph, same appearance as the original display function */
+static const glyphStyle GLYPHS[] = {
+  { " \u23F9 ", 0 },   /* hidden */
+  { " \u2690 ", 1 },   /* flag */
+  { " X ",      1 },   /* bomb */
+  { "   ",      0 },   /* no adjacent mines */
+  { " 1 ",      2 },
+  { " 2 ",      3 },
+  { " 3 ",      4 },
+  { " 4 ",      5 },
+  { " 5 ",      1 },
+  { " 6 ",      1 },
+  { " 7 ",      1 },
+  { " 8 ",      1 }
+};
+
+
+
+/*!
+  \fn static void reserve(renderer* screen, size_t size_extra)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param screen The renderer
+  \param size_extra Bytes about to be appended
+  \brief Makes sure the frame buffer can hold size_extra more bytes
+  \remarks Kills the program on allocation error
+*/
+static void reserve(renderer* screen, size_t size_extra)
+{
+  /* Variables */
+  size_t size_new;
+  char* ptr_buffer;
+
+  if (screen->size + size_extra <= screen->capacity) return;
+
+  size_new = (screen->capacity == 0) ? 4096 : screen->capacity;
+  while (size_new < screen->size + size_extra) size_new *= 2;
+  ptr_buffer = realloc(screen->buffer, size_new);
+
+  /* Kill the program if allocation error */
+  if (ptr_buffer == NULL) {
+    fprintf(stderr, "Memory allocation error.\n");
+    exit(MEMORY_ALLOCATION_ERROR);
+  }
+
+  screen->buffer = ptr_buffer;
+  screen->capacity = size_new;
+}
+
+/*!
+  \fn static void appendText(renderer* screen, const char* str_text)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param screen The renderer
+  \param str_text Text to append
+  \brief Appends text to the frame, the room must have been reserved
+  \remarks None
+*/
+static void appendText(renderer* screen, const char* str_text)
+{
+  /* Variables */
+  size_t size_text;
+
+  size_text = strlen(str_text);
+  memcpy(screen->buffer + screen->size, str_text, size_text);
+  screen->size += size_text;
+}
+
+/*!
+  \fn static void appendNumber(renderer* screen, int64_t int_n)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param screen The renderer
+  \param int_n Positive number to append
+  \brief Appends a number to the frame, the room must have been reserved
+  \remarks None
+*/
+static void appendNumber(renderer* screen, int64_t int_n)
+{
+  /* Variables */
+  char str_digits[24];
+  int int_length;
+
+  int_length = 0;
+  do {
+    str_digits[int_length++] = '0' + (int_n % 10);
+    int_n /= 10;
+  } while (int_n > 0);
+
+  while (int_length > 0) screen->buffer[screen->size++] = str_digits[--int_length];
+}
+
+/*!
+  \fn static void flushFrame(renderer* screen, int64_t int_start)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.2 - stats
+  \param screen The renderer
+  \param int_start Time the frame was started at (nowNs)
+  \brief Writes the frame buffer and updates the measurements
+  \remarks Pending stdio output is flushed first to keep the order. Every
+  frame, printMinefield included, ends here : it stops the clock of the
+  move it shows (see STATS_FRAME)
+*/
+static void flushFrame(renderer* screen, int64_t int_start)
+{
+  /* Variables */
+  size_t size_done;
+  ssize_t int_written;
+
+  fflush(stdout);
+
+  size_done = 0;
+  while (size_done < screen->size) {
+    int_written = write(screen->fd, screen->buffer + size_done, screen->size - size_done);
+    if (int_written < 0) {
+      if (errno == EINTR) continue;
+      break;
+    }
+    size_done += int_written;
+  }
+
+  screen->frames++;
+  screen->frameBytes = screen->size;
+  screen->frameNs = nowNs() - int_start;
+  screen->totalBytes += screen->frameBytes;
+  screen->totalNs += screen->frameNs;
+  screen->size = 0;
+  STATS_FRAME(screen->frameBytes, int_start);
+}
+
+void initRenderer(renderer* screen, int int_fd)
+{
+  /* Variables */
+  int i;
+  char char_c;
+
+  memset(screen, 0, sizeof(renderer));
+  screen->fd = int_fd;
+
+  /* Glyph of every possible cell */
+  for (i = 0; i < 256; i++) {
+    char_c = cellDisplay((cell)i);
+    switch (char_c) {
+    case 'h' :
+      screen->glyph[i] = GLYPH_HIDDEN;
+      break;
+
+    case 'f' :
+      screen->glyph[i] = GLYPH_FLAG;
+      break;
+
+    case 'b' :
+      screen->glyph[i] = GLYPH_BOMB;
+      break;
+
+    case 'd' :
+      screen->glyph[i] = GLYPH_EMPTY;
+      break;
+
+    default :
+      /* Counts above 8 can't happen, show them as 8 */
+      screen->glyph[i] = GLYPH_EMPTY + ((char_c - '0' > 8) ? 8 : char_c - '0');
+      break;
+    }
+  }
+}
+
+void freeRenderer(renderer* screen)
+{
+  free(screen->buffer);
+  free(screen->shadow);
+  screen->shadow = NULL;
+  screen->shadowSize = 0;
+  screen->hasFrame = false;
+  screen->buffer = NULL;
+  screen->capacity = 0;
+  screen->size = 0;
+}
+
+/*!
+  \fn static int rowLabelWidth(int int_y)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param int_y Last row of the view
+  \return Columns used by the number and the first separator of a row
+  \brief Width of the start of a row, the first glyph is right after it
+  \remarks None
+*/
+static int rowLabelWidth(int int_y)
+{
+  /* Variables */
+  int int_digits;
+
+  int_digits = 1;
+  while (int_y >= 10) {
+    int_y /= 10;
+    int_digits++;
+  }
+
+  return(1 + ((int_digits < 2) ? 2 : int_digits) + 2);
+}
+
+/*!
+  \fn static void layoutMinimap(renderer* screen, board* minefield)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param screen The renderer
+  \param minefield The minefield
+  \brief Chooses the size of the minimap and of its blocks
+  \remarks The counts of the minimap are dropped when the minefield changed
+*/
+static void layoutMinimap(renderer* screen, board* minefield)
+{
+  if ( (screen->mapDim.width == minefield->dim.width) && (screen->mapDim.height == minefield->dim.height) ) return;
+
+  screen->mapWidth = (minefield->dim.width < MINIMAP_WIDTH) ? minefield->dim.width : MINIMAP_WIDTH;
+  screen->blockWidth = (minefield->dim.width + screen->mapWidth - 1) / screen->mapWidth;
+  screen->mapWidth = (minefield->dim.width + screen->blockWidth - 1) / screen->blockWidth;
+
+  screen->mapHeight = (minefield->dim.height < MINIMAP_HEIGHT) ? minefield->dim.height : MINIMAP_HEIGHT;
+  screen->blockHeight = (minefield->dim.height + screen->mapHeight - 1) / screen->mapHeight;
+  screen->mapHeight = (minefield->dim.height + screen->blockHeight - 1) / screen->blockHeight;
+
+  screen->mapDim = minefield->dim;
+  screen->mapValid = false;
+}
+
+/*!
+  \fn static void placeView(renderer* screen, board* minefield)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param screen The renderer
+  \param minefield The minefield
+  \brief Sizes the view to the terminal and keeps it inside the minefield
+  \remarks The view is the whole minefield when fitView is not set or
+  when the output is not a terminal
+*/
+static void placeView(renderer* screen, board* minefield)
+{
+  /* Variables */
+  struct winsize size_terminal;
+  int int_label;
+  int int_columns;
+  int int_rows;
+
+  layoutMinimap(screen, minefield);
+  screen->viewWidth = minefield->dim.width;
+  screen->viewHeight = minefield->dim.height;
+
+  if ( screen->fitView && (ioctl(screen->fd, TIOCGWINSZ, &size_terminal) == 0) &&
+       (size_terminal.ws_col > 0) && (size_terminal.ws_row > 0) ) {
+    /* Row numbers, closing separator and arrow of the x axis */
+    int_label = rowLabelWidth(minefield->dim.height - 1);
+    int_columns = (size_terminal.ws_col - int_label - 8) / 4;
+
+    /* Numbers, arrow of the y axis and the lines of the caller */
+    int_rows = (size_terminal.ws_row - 5 - screen->footerLines) / 2;
+    if ( (int_columns < minefield->dim.width) || (int_rows < minefield->dim.height) ) {
+      /* Room for the status line and the minimap */
+      int_rows = (size_terminal.ws_row - 6 - screen->mapHeight - screen->footerLines) / 2;
+    }
+
+    if (int_columns < screen->viewWidth) screen->viewWidth = (int_columns < 1) ? 1 : int_columns;
+    if (int_rows < screen->viewHeight) screen->viewHeight = (int_rows < 1) ? 1 : int_rows;
+  }
+
+  if (screen->viewX > minefield->dim.width - screen->viewWidth) screen->viewX = minefield->dim.width - screen->viewWidth;
+  if (screen->viewX < 0) screen->viewX = 0;
+  if (screen->viewY > minefield->dim.height - screen->viewHeight) screen->viewY = minefield->dim.height - screen->viewHeight;
+  if (screen->viewY < 0) screen->viewY = 0;
+}
+
+/*!
+  \fn static boolean isPartialView(renderer* screen, board* minefield)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param screen The renderer
+  \param minefield The minefield
+  \return true if the view doesn't hold the whole minefield
+  \brief Tells whether the minimap is needed
+  \remarks None
+*/
+static boolean isPartialView(renderer* screen, board* minefield)
+{
+  return( (screen->viewWidth < minefield->dim.width) || (screen->viewHeight < minefield->dim.height) );
+}
+
+/*!
+  \fn static int blockOf(renderer* screen, board* minefield, int64_t int_index)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param screen The renderer
+  \param minefield The minefield
+  \param int_index Index of a cell
+  \return Index of the minimap block holding the cell
+  \brief Finds the minimap block of a cell
+  \remarks None
+*/
+static int blockOf(renderer* screen, board* minefield, int64_t int_index)
+{
+  /* Variables */
+  int int_x;
+  int int_y;
+
+  int_y = int_index / minefield->dim.width;
+  int_x = int_index - (int64_t)int_y * minefield->dim.width;
+
+  return((int_y / screen->blockHeight) * screen->mapWidth + int_x / screen->blockWidth);
+}
+
+/*!
+  \fn static void updateMinimap(renderer* screen, board* minefield)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.2 - undo
+  \param screen The renderer
+  \param minefield The minefield
+  \brief Brings the revealed cells of every minimap block up to date
+  \remarks Only the dirty list is read, unless the counts are unknown,
+  changes are not tracked or the dirty list overflowed : then the whole
+  minefield is counted again. A visible cell of the list is counted as
+  newly revealed, so the counts are forgotten when a move is undone (see
+  forgetMinimap)
+*/
+static void updateMinimap(renderer* screen, board* minefield)
+{
+  /* Variables */
+  int64_t i;
+  int64_t int_nCells;
+  int64_t int_index;
+
+  if ( (screen->mapValid == false) || (minefield->dirtyLimit == 0) || minefield->dirtyOverflow ) {
+    memset(screen->mapRevealed, 0, sizeof(screen->mapRevealed));
+    int_nCells = cellCount(minefield->dim);
+    for (i = 0; i < int_nCells; i++) {
+      if ((minefield->cells[i] & CELL_HIDDEN) == 0) screen->mapRevealed[blockOf(screen, minefield, i)]++;
+    }
+
+    screen->mapValid = true;
+    screen->mapEpoch = minefield->dirtyEpoch;
+    screen->mapSeen = minefield->dirtyCount;
+    return;
+  }
+
+  /* Entries of a cleared dirty list haven't been counted yet */
+  if (screen->mapEpoch != minefield->dirtyEpoch) {
+    screen->mapEpoch = minefield->dirtyEpoch;
+    screen->mapSeen = 0;
+  }
+
+  /* Hidden cells only change flags, a visible one was just revealed */
+  for (i = screen->mapSeen; i < minefield->dirtyCount; i++) {
+    int_index = minefield->dirty[i];
+    if ((minefield->cells[int_index] & CELL_HIDDEN) == 0) screen->mapRevealed[blockOf(screen, minefield, int_index)]++;
+  }
+  screen->mapSeen = minefield->dirtyCount;
+}
+
+/*!
+  \fn static char minimapChar(renderer* screen, board* minefield, int int_bx, int int_by)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param screen The renderer
+  \param minefield The minefield
+  \param int_bx Column of the block in the minimap
+  \param int_by Row of the block in the minimap
+  \return '@' if the block is in the view, '.' if nothing is revealed in it,
+  '-' if less than half of it is revealed and '=' otherwise
+  \brief Character of a minimap block
+  \remarks None
+*/
+static char minimapChar(renderer* screen, board* minefield, int int_bx, int int_by)
+{
+  /* Variables */
+  int int_x0;
+  int int_y0;
+  int int_x1;
+  int int_y1;
+  int64_t int_area;
+  int64_t int_revealed;
+
+  int_x0 = int_bx * screen->blockWidth;
+  int_y0 = int_by * screen->blockHeight;
+  int_x1 = (int_x0 + screen->blockWidth < minefield->dim.width) ? int_x0 + screen->blockWidth : minefield->dim.width;
+  int_y1 = (int_y0 + screen->blockHeight < minefield->dim.height) ? int_y0 + screen->blockHeight : minefield->dim.height;
+
+  if ( (int_x0 < screen->viewX + screen->viewWidth) && (screen->viewX < int_x1) &&
+       (int_y0 < screen->viewY + screen->viewHeight) && (screen->viewY < int_y1) ) return('@');
+
+  int_area = (int64_t)(int_x1 - int_x0) * (int_y1 - int_y0);
+  int_revealed = screen->mapRevealed[int_by * screen->mapWidth + int_bx];
+  if (int_revealed == 0) return('.');
+
+  return( (2 * int_revealed < int_area) ? '-' : '=' );
+}
+
+/*!
+  \fn static void buildFrame(renderer* screen, board* minefield, boolean bool_shadow)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.2 - view and minimap
+  \param screen The renderer
+  \param minefield The minefield to print
+  \param bool_shadow true to record the glyphs in the shadow
+  \brief Appends a whole frame of the view to the frame buffer
+  \remarks The minimap counts must be up to date when the view is partial
+*/
+static void buildFrame(renderer* screen, board* minefield, boolean bool_shadow)
+{
+  /* Variables */
+  int i;
+  int j;
+  int int_x;
+  int int_y;
+  int int_end;
+  int int_digits;
+  int int_colour;
+  int int_next;
+  size_t size_line;
+  size_t size_lineStart;
+  cell* cell_row;
+  uint8_t* ptr_shadow;
+  const glyphStyle* glyph_g;
+
+  int_end = screen->viewX + screen->viewWidth;
+  screen->labelWidth = rowLabelWidth(screen->viewY + screen->viewHeight - 1);
+
+  /* Line of numbers, only the last 3 digits past 999 */
+  reserve(screen, 32 + screen->labelWidth + 16 * (size_t)screen->viewWidth);
+  for (i = 1; i < screen->labelWidth; i++) screen->buffer[screen->size++] = ' ';
+  for (int_x = screen->viewX; int_x < int_end; int_x++) {
+    if (int_x < 100) {
+      appendText(screen, (int_x < 10) ? "  " : " ");
+      appendNumber(screen, int_x);
+    } else {
+      screen->buffer[screen->size++] = '0' + (int_x / 100) % 10;
+      screen->buffer[screen->size++] = '0' + (int_x / 10) % 10;
+      screen->buffer[screen->size++] = '0' + int_x % 10;
+    }
+    appendText(screen, " ");
+  }
+
+  /* Arrow after x axis */
+  appendText(screen, "   \u2190 x \n");
+
+  /* Separation line, copied after every row */
+  size_lineStart = screen->size;
+  for (i = 1; i < screen->labelWidth; i++) screen->buffer[screen->size++] = ' ';
+  for (i = 0; i < screen->viewWidth; i++) appendText(screen, "+---");
+  appendText(screen, "+\n");
+  size_line = screen->size - size_lineStart;
+
+  /* Display the view */
+  for (i = 0; i < screen->viewHeight; i++) {
+    int_y = screen->viewY + i;
+
+    /* Worst case : colour, glyph and reset around every cell */
+    reserve(screen, 32 + screen->labelWidth + 24 * (size_t)screen->viewWidth + size_line);
+
+    /* Numbers, aligned to the right */
+    int_digits = 1;
+    for (j = int_y; j >= 10; j /= 10) int_digits++;
+    for (j = int_digits + 2; j < screen->labelWidth; j++) screen->buffer[screen->size++] = ' ';
+    appendNumber(screen, int_y);
+    appendText(screen, " |");
+
+    /* Values, merging the runs of cells of the same colour */
+    cell_row = &CELL_AT(minefield, screen->viewX, int_y);
+    ptr_shadow = screen->shadow + (int64_t)i * screen->viewWidth;
+    int_colour = COLOUR_NONE;
+    for (j = 0; j < screen->viewWidth; j++) {
+      glyph_g = &GLYPHS[screen->glyph[cell_row[j]]];
+      if (bool_shadow) ptr_shadow[j] = screen->glyph[cell_row[j]];
+      if (glyph_g->colour != int_colour) {
+        appendText(screen, COLOURS[glyph_g->colour]);
+        int_colour = glyph_g->colour;
+      }
+      appendText(screen, glyph_g->text);
+
+      /* Keep the colour for the separator only if the next cell shares it */
+      int_next = (j + 1 < screen->viewWidth) ? GLYPHS[screen->glyph[cell_row[j+1]]].colour : COLOUR_NONE;
+      if ( (int_colour != COLOUR_NONE) && (int_next != int_colour) ) {
+        appendText(screen, reset);
+        int_colour = COLOUR_NONE;
+      }
+      screen->buffer[screen->size++] = '|';
+    }
+    screen->buffer[screen->size++] = '\n';
+
+    /* Separation line */
+    memcpy(screen->buffer + screen->size, screen->buffer + size_lineStart, size_line);
+    screen->size += size_line;
+  }
+
+  /* Arrow below y axis */
+  reserve(screen, 32);
+  appendText(screen, "  \u2191 \n  y \n");
+  screen->mapLine = 0;
+  screen->bottomLine = 6 + 2 * screen->viewHeight;
+
+  /* Where the view is and what is around it */
+  if (isPartialView(screen, minefield)) {
+    reserve(screen, 128 + (size_t)screen->mapHeight * (screen->mapWidth + 3));
+    appendText(screen, "View : x ");
+    appendNumber(screen, screen->viewX);
+    appendText(screen, "-");
+    appendNumber(screen, int_end - 1);
+    appendText(screen, " of ");
+    appendNumber(screen, minefield->dim.width);
+    appendText(screen, ", y ");
+    appendNumber(screen, screen->viewY);
+    appendText(screen, "-");
+    appendNumber(screen, screen->viewY + screen->viewHeight - 1);
+    appendText(screen, " of ");
+    appendNumber(screen, minefield->dim.height);
+    appendText(screen, " (map : @ view, - some, = most revealed)\n");
+
+    for (i = 0; i < screen->mapHeight; i++) {
+      appendText(screen, "  ");
+      for (j = 0; j < screen->mapWidth; j++) {
+        screen->mapShadow[i * screen->mapWidth + j] = minimapChar(screen, minefield, j, i);
+        screen->buffer[screen->size++] = screen->mapShadow[i * screen->mapWidth + j];
+      }
+      screen->buffer[screen->size++] = '\n';
+    }
+
+    screen->mapLine = 6 + 2 * screen->viewHeight;
+    screen->bottomLine += 1 + screen->mapHeight;
+  }
+  appendText(screen, "\n");
+}
+
+/*!
+  \fn static void prepareFrame(renderer* screen, board* minefield)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param screen The renderer
+  \param minefield The minefield
+  \brief Places the view and updates the minimap before a frame
+  \remarks None
+*/
+static void prepareFrame(renderer* screen, board* minefield)
+{
+  placeView(screen, minefield);
+  if (isPartialView(screen, minefield)) {
+    updateMinimap(screen, minefield);
+  } else {
+    /* The dirty lists are not followed while the minimap is hidden */
+    screen->mapValid = false;
+  }
+}
+
+void renderMinefield(renderer* screen, board* minefield)
+{
+  /* Variables */
+  int64_t int_start;
+
+  int_start = nowNs();
+
+  /* The frame is printed wherever the cursor is, diff updates can't follow */
+  screen->hasFrame = false;
+  prepareFrame(screen, minefield);
+  buildFrame(screen, minefield, false);
+  flushFrame(screen, int_start);
+}
+
+void renderMinefieldDiff(renderer* screen, board* minefield)
+{
+  /* Variables */
+  int64_t i;
+  int64_t int_start;
+  int64_t int_index;
+  int64_t int_viewCells;
+  int int_x;
+  int int_y;
+  int int_bx;
+  int int_by;
+  char char_block;
+  uint8_t int_glyph;
+  const glyphStyle* glyph_g;
+
+  int_start = nowNs();
+  prepareFrame(screen, minefield);
+  int_viewCells = (int64_t)screen->viewWidth * screen->viewHeight;
+
+  /* Full frame from the top of a cleared screen when the previous one is unknown */
+  if (
+    (screen->hasFrame == false) || (minefield->dirtyLimit == 0) || minefield->dirtyOverflow ||
+    (screen->shadowX != screen->viewX) || (screen->shadowY != screen->viewY) ||
+    (screen->shadowWidth != screen->viewWidth) || (screen->shadowHeight != screen->viewHeight)
+  ) {
+    if (screen->shadowSize < int_viewCells) {
+      free(screen->shadow);
+      screen->shadow = malloc(int_viewCells);
+
+      /* Kill the program if allocation error */
+      if (screen->shadow == NULL) {
+        fprintf(stderr, "Memory allocation error.\n");
+        exit(MEMORY_ALLOCATION_ERROR);
+      }
+      screen->shadowSize = int_viewCells;
+    }
+
+    reserve(screen, 16);
+    appendText(screen, "\e[1;1H\e[2J");
+    buildFrame(screen, minefield, true);
+    screen->shadowX = screen->viewX;
+    screen->shadowY = screen->viewY;
+    screen->shadowWidth = screen->viewWidth;
+    screen->shadowHeight = screen->viewHeight;
+    screen->hasFrame = true;
+    flushFrame(screen, int_start);
+    return;
+  }
+
+  /* Repaint the changed cells of the view along with the separators around them */
+  for (i = 0; i < minefield->dirtyCount; i++) {
+    int_index = minefield->dirty[i];
+    int_y = int_index / minefield->dim.width;
+    int_x = int_index - (int64_t)int_y * minefield->dim.width;
+    if ( (int_x < screen->viewX) || (int_x >= screen->viewX + screen->viewWidth) ||
+         (int_y < screen->viewY) || (int_y >= screen->viewY + screen->viewHeight) ) continue;
+
+    int_x -= screen->viewX;
+    int_y -= screen->viewY;
+    int_glyph = screen->glyph[minefield->cells[int_index]];
+    if (screen->shadow[(int64_t)int_y * screen->viewWidth + int_x] == int_glyph) continue;
+    screen->shadow[(int64_t)int_y * screen->viewWidth + int_x] = int_glyph;
+    glyph_g = &GLYPHS[int_glyph];
+
+    reserve(screen, 64);
+    appendText(screen, "\e[");
+    appendNumber(screen, 3 + 2 * (int64_t)int_y);
+    appendText(screen, ";");
+    appendNumber(screen, screen->labelWidth + 4 * (int64_t)int_x);
+    appendText(screen, "H|");
+    if (glyph_g->colour != COLOUR_NONE) appendText(screen, COLOURS[glyph_g->colour]);
+    appendText(screen, glyph_g->text);
+    if (glyph_g->colour != COLOUR_NONE) appendText(screen, reset);
+    appendText(screen, "|");
+  }
+
+  /* Repaint the minimap blocks that changed */
+  if (screen->mapLine != 0) {
+    for (int_by = 0; int_by < screen->mapHeight; int_by++) {
+      for (int_bx = 0; int_bx < screen->mapWidth; int_bx++) {
+        char_block = minimapChar(screen, minefield, int_bx, int_by);
+        if (screen->mapShadow[int_by * screen->mapWidth + int_bx] == char_block) continue;
+        screen->mapShadow[int_by * screen->mapWidth + int_bx] = char_block;
+
+        reserve(screen, 32);
+        appendText(screen, "\e[");
+        appendNumber(screen, screen->mapLine + int_by);
+        appendText(screen, ";");
+        appendNumber(screen, 3 + int_bx);
+        appendText(screen, "H");
+        screen->buffer[screen->size++] = char_block;
+      }
+    }
+  }
+
+  /* Back below the frame, where the previous prompts are erased */
+  reserve(screen, 64);
+  appendText(screen, "\e[");
+  appendNumber(screen, screen->bottomLine);
+  appendText(screen, ";1H\e[J");
+
+  flushFrame(screen, int_start);
+}
+
+void centreView(renderer* screen, board* minefield, int int_x, int int_y)
+{
+  screen->viewX = int_x - screen->viewWidth / 2;
+  screen->viewY = int_y - screen->viewHeight / 2;
+  placeView(screen, minefield);
+}
+
+void forgetMinimap(renderer* screen)
+{
+  screen->mapValid = false;
+}
@@ -0,0 +1,265 @@
+/*!
+  \file replay.c
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \brief Replay mode
+  \remarks None
+
+  Rebuilds the game of a journal, up to any of its
+  moves, and checks that every move gives the result
+  it gave when it was played : to settle disputes and
+  to keep the games recorded as regression tests.
+
+*/
+
+#include "replay.h"
+#include "console.h"
+#include "headless.h"
+#include "minesweeper.h"
+#include "bitboard.h"
+#include "random.h"
+#include "setup.h"
+#include "generator.h"
+#include "snapshot.h"
+
+
+
+/*!
+  \fn static int placeSetup(journalReader* reader, board* minefield, options* opt, int int_setup, int int_x, int int_y)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param reader The journal
+  \param minefield The minefield, without any mine
+  \param opt The command line options
+  \param int_setup How the mines were placed
+  \param int_x x coordinate of the first reveal
+  \param int_y y coordinate of the first reveal
+  \return 0 on success, FILE_ERROR otherwise (with a message on stderr)
+  \brief Places the mines again, the way the game placed them
+  \remarks The tiled setup and the snapshots replace the minefield, they
+  only happen before the first move. The minefield is released on error
+*/
+static int placeSetup(journalReader* reader, board* minefield, options* opt, int int_setup, int int_x, int int_y)
+{
+  /* Variables */
+  rng gen;
+  uint64_t int_seed;
+
+  seedRng(&gen, reader->seed);
+  switch (int_setup) {
+    case SETUP_PLACE:
+      placeMines(minefield, reader->mines, &gen);
+      initSurroundingMinesBitboard(minefield);
+      break;
+    case SETUP_AROUND:
+      placeMinesAround(minefield, reader->mines, int_x, int_y, &gen);
+      initSurroundingMinesBitboard(minefield);
+      break;
+    case SETUP_NO_GUESS:
+      generateNoGuess(minefield, reader->mines, int_x, int_y, reader->seed, opt->threads, NULL);
+      break;
+    case SETUP_TILED:
+      freeMinefield(minefield);
+      setupMinefieldTiled(minefield, reader->dim, reader->mines, reader->seed, opt->threads);
+      break;
+    case SETUP_SNAPSHOT:
+      if (opt->load == NULL) {
+        fprintf(stderr, "The journal starts from a snapshot, give it with --load.\n");
+        return(FILE_ERROR);
+      }
+      freeMinefield(minefield);
+      if (loadSnapshot(minefield, &int_seed, opt->load, opt->verify) != 0) return(FILE_ERROR);
+      if ( (minefield->dim.width != reader->dim.width) || (minefield->dim.height != reader->dim.height) || (int_seed != reader->seed) ) {
+        fprintf(stderr, "The snapshot %s is not the one the journal starts from.\n", opt->load);
+        freeMinefield(minefield);
+        return(FILE_ERROR);
+      }
+      break;
+  }
+
+  return(0);
+}
+
+/*!
+  \fn static void applyKeyframe(board* minefield, const journalRecord* record)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param minefield The minefield, with its mines
+  \param record The keyframe
+  \brief Restores the hidden and flag planes and the counters of a keyframe
+  \remarks None
+*/
+static void applyKeyframe(board* minefield, const journalRecord* record)
+{
+  /* Variables */
+  const uint8_t* ptr_hidden;
+  const uint8_t* ptr_flags;
+  int64_t i;
+  int64_t int_nCells;
+  cell cell_bits;
+
+  int_nCells = cellCount(minefield->dim);
+  ptr_hidden = record->planes;
+  ptr_flags = record->planes + (int_nCells + 7) / 8;
+  for (i = 0; i < int_nCells; i++) {
+    cell_bits = (((ptr_hidden[i >> 3] >> (i & 7)) & 1) ? CELL_HIDDEN : 0) | (((ptr_flags[i >> 3] >> (i & 7)) & 1) ? CELL_FLAG : 0);
+    minefield->cells[i] = (minefield->cells[i] & ~(CELL_HIDDEN | CELL_FLAG)) | cell_bits;
+  }
+  minefield->count = record->count;
+}
+
+/*!
+  \fn static boolean keyframeMatches(board* minefield, const journalRecord* record)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param minefield The minefield, after the moves before the keyframe
+  \param record The keyframe
+  \return true if the minefield is the one the keyframe holds
+  \brief Compares a minefield to a keyframe : counters, hidden and flag planes
+  \remarks None
+*/
+static boolean keyframeMatches(board* minefield, const journalRecord* record)
+{
+  /* Variables */
+  const uint8_t* ptr_hidden;
+  const uint8_t* ptr_flags;
+  int64_t i;
+  int64_t int_nCells;
+  cell cell_bits;
+
+  if (memcmp(&record->count, &minefield->count, sizeof(counters)) != 0) return(false);
+
+  int_nCells = cellCount(minefield->dim);
+  ptr_hidden = record->planes;
+  ptr_flags = record->planes + (int_nCells + 7) / 8;
+  for (i = 0; i < int_nCells; i++) {
+    cell_bits = (((ptr_hidden[i >> 3] >> (i & 7)) & 1) ? CELL_HIDDEN : 0) | (((ptr_flags[i >> 3] >> (i & 7)) & 1) ? CELL_FLAG : 0);
+    if ((minefield->cells[i] & (CELL_HIDDEN | CELL_FLAG)) != cell_bits) return(false);
+  }
+
+  return(true);
+}
+
+int replayJournal(journalReader* reader, board* minefield, options* opt, int64_t int_target, replayResult* result)
+{
+  /* Variables */
+  journalRecord record;
+  int64_t int_move;
+  int64_t int_lastIndex;
+  int64_t int_low;
+  int64_t int_high;
+  int64_t int_mid;
+  size_t size_offset;
+  size_t size_next;
+  int int_res;
+
+  result->diverged = -1;
+  result->outcome = OUTCOME_UNFINISHED;
+  initMinefield(minefield, reader->dim);
+  int_move = 0;
+  int_lastIndex = 0;
+  size_offset = JOURNAL_HEADER_SIZE;
+
+  /* Last keyframe at or before the target, none to check every move */
+  int_low = 0;
+  int_high = (opt->verify) ? 0 : reader->nKeyframes;
+  while (int_low < int_high) {
+    int_mid = (int_low + int_high) / 2;
+    if (reader->keyframes[int_mid].move <= int_target) {
+      int_low = int_mid + 1;
+    } else {
+      int_high = int_mid;
+    }
+  }
+  if (int_low > 0) {
+    if (placeSetup(reader, minefield, opt, reader->setup, reader->setupX, reader->setupY) != 0) return(FILE_ERROR);
+    size_offset = readRecord(reader, reader->keyframes[int_low - 1].offset, &int_lastIndex, &record);
+    applyKeyframe(minefield, &record);
+    int_move = record.move;
+  }
+  result->from = int_move;
+
+  /* Moves from there, the records after the target are left alone */
+  while ( (size_offset < reader->end) && (int_move <= int_target) ) {
+    size_next = readRecord(reader, size_offset, &int_lastIndex, &record);
+
+    /* Move out of the minefield */
+    if (size_next == 0) {
+      result->diverged = int_move;
+      break;
+    }
+
+    if (record.type == -1) {
+      if (int_move == int_target) break;
+      int_res = click(minefield, record.index % reader->dim.width, record.index / reader->dim.width, record.action);
+      if (int_res != record.result) {
+        result->diverged = int_move;
+        break;
+      }
+      int_move++;
+      if (int_res == 0) result->outcome = OUTCOME_LOST;
+    } else if (record.type == JOURNAL_SETUP) {
+      if (placeSetup(reader, minefield, opt, record.setup, record.x, record.y) != 0) return(FILE_ERROR);
+    } else if (keyframeMatches(minefield, &record) == false) {
+      result->diverged = int_move;
+      break;
+    }
+    size_offset = size_next;
+  }
+  result->position = int_move;
+  if ( (result->outcome == OUTCOME_UNFINISHED) && (minefield->count.mines > 0) && (userHasWon(minefield)) ) result->outcome = OUTCOME_WON;
+
+  return(0);
+}
+
+int runReplay(options* opt)
+{
+  /* Variables */
+  journalReader reader;
+  board minefield;
+  replayResult result;
+  int64_t int_start;
+  int64_t int_openNs;
+  int64_t int_replayNs;
+  int64_t int_target;
+  int int_res;
+  static const char* const OUTCOMES[] = { "unfinished", "won", "lost" };
+
+  int_start = nowNs();
+  int_res = openReplay(&reader, opt->replay);
+  if (int_res != 0) return(int_res);
+  int_openNs = nowNs() - int_start;
+
+  int_target = ( (opt->seek < 0) || (opt->seek > reader.moves) ) ? reader.moves : opt->seek;
+  int_start = nowNs();
+  int_res = replayJournal(&reader, &minefield, opt, int_target, &result);
+  int_replayNs = nowNs() - int_start;
+  if (int_res != 0) {
+    closeReplay(&reader);
+    return(int_res);
+  }
+
+  printf("{\"mode\":\"replay\",\"width\":%d,\"height\":%d,\"mines\":%lld,\"seed\":%llu,\"moves\":%lld,"
+         "\"keyframes\":%lld,\"position\":%lld,\"from_keyframe\":%lld,\"outcome\":\"%s\",\"open_ns\":%lld,"
+         "\"replay_ns\":%lld,\"moves_per_second\":%.0f",
+         reader.dim.width, reader.dim.height, (long long)reader.mines, (unsigned long long)reader.seed,
+         (long long)reader.moves, (long long)reader.nKeyframes, (long long)result.position, (long long)result.from,
+         OUTCOMES[result.outcome], (long long)int_openNs, (long long)int_replayNs,
+         (int_replayNs > 0) ? 1e9 * (result.position - result.from) / int_replayNs : 0.0);
+  if (reader.end < reader.size) printf(",\"truncated\":true");
+  if (result.diverged >= 0) printf(",\"diverged_at\":%lld", (long long)result.diverged);
+  printf("}\n");
+
+  /* Game at that move, to look at it with --load */
+  int_res = (opt->save != NULL) ? saveSnapshot(&minefield, reader.seed, opt->save) : 0;
+
+  freeMinefield(&minefield);
+  closeReplay(&reader);
+
+  if (int_res != 0) return(int_res);
+  return( (result.diverged >= 0) ? MOVE_INPUT_ERROR : 0 );
+}
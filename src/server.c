@@ -0,0 +1,820 @@
+/*!
+  \file server.c
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \brief Multi-game server
+  \remarks None
+
+  Hosts any amount of games over a Unix-domain or
+  TCP socket, with one epoll event loop per thread
+  and no thread per connection : a connection and its
+  game belong to the loop that accepted it.
+
+*/
+
+/* accept4 */
+#define _GNU_SOURCE
+
+#include "server.h"
+#include "minesweeper.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+
+/*! Reply to click and flag for each outcome, the start of the reply to moves */
+static const char* STATE_NAMES[] = {"ok playing\n", "ok won\n", "ok lost\n"};
+
+
+
+/*!
+  \fn static boolean isUnixAddress(const char* str_address)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param str_address Address given to --serve or --loadgen
+  \return true for the path of a Unix-domain socket, false for HOST:PORT
+  \brief Tells the kind of an address
+  \remarks A path with a slash is always a Unix-domain socket
+*/
+static boolean isUnixAddress(const char* str_address)
+{
+  return( (strchr(str_address, ':') == NULL) || (strchr(str_address, '/') != NULL) );
+}
+
+int openEndpoint(const char* str_address, boolean bool_listen)
+{
+  /* Variables */
+  struct sockaddr_un addr_unix;
+  struct sockaddr_in addr_inet;
+  struct stat stat_file;
+  char str_host[64];
+  const char* str_port;
+  char* str_end;
+  long int_port;
+  int int_fd;
+  int int_yes;
+  int int_res;
+
+  int_yes = 1;
+  if (isUnixAddress(str_address)) {
+    memset(&addr_unix, 0, sizeof(addr_unix));
+    addr_unix.sun_family = AF_UNIX;
+    if (strlen(str_address) >= sizeof(addr_unix.sun_path)) {
+      fprintf(stderr, "Invalid address %s.\n", str_address);
+      return(-1);
+    }
+    strcpy(addr_unix.sun_path, str_address);
+
+    int_fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC | (bool_listen ? SOCK_NONBLOCK : 0), 0);
+    if (int_fd < 0) {
+      fprintf(stderr, "Can't open the socket %s : %s.\n", str_address, strerror(errno));
+      return(-1);
+    }
+
+    if (bool_listen) {
+      /* Left by a server that was killed */
+      if ( (stat(str_address, &stat_file) == 0) && (S_ISSOCK(stat_file.st_mode)) ) unlink(str_address);
+      int_res = bind(int_fd, (struct sockaddr*)&addr_unix, sizeof(addr_unix));
+      if (int_res == 0) int_res = listen(int_fd, SOMAXCONN);
+    } else {
+      int_res = connect(int_fd, (struct sockaddr*)&addr_unix, sizeof(addr_unix));
+    }
+  } else {
+    str_port = strrchr(str_address, ':');
+    if ( (size_t)(str_port - str_address) >= sizeof(str_host) ) {
+      fprintf(stderr, "Invalid address %s.\n", str_address);
+      return(-1);
+    }
+    memcpy(str_host, str_address, str_port - str_address);
+    str_host[str_port - str_address] = '\0';
+    int_port = strtol(str_port + 1, &str_end, 10);
+
+    memset(&addr_inet, 0, sizeof(addr_inet));
+    addr_inet.sin_family = AF_INET;
+    addr_inet.sin_port = htons((uint16_t)int_port);
+    if ( (*str_end != '\0') || (str_port[1] == '\0') || (int_port < 0) || (int_port > 65535) ||
+         (inet_pton(AF_INET, (str_host[0] == '\0') ? "127.0.0.1" : str_host, &addr_inet.sin_addr) != 1) ) {
+      fprintf(stderr, "Invalid address %s.\n", str_address);
+      return(-1);
+    }
+
+    int_fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC | (bool_listen ? SOCK_NONBLOCK : 0), 0);
+    if (int_fd < 0) {
+      fprintf(stderr, "Can't open the socket %s : %s.\n", str_address, strerror(errno));
+      return(-1);
+    }
+
+    if (bool_listen) {
+      setsockopt(int_fd, SOL_SOCKET, SO_REUSEADDR, &int_yes, sizeof(int_yes));
+      int_res = bind(int_fd, (struct sockaddr*)&addr_inet, sizeof(addr_inet));
+      if (int_res == 0) int_res = listen(int_fd, SOMAXCONN);
+    } else {
+      setsockopt(int_fd, IPPROTO_TCP, TCP_NODELAY, &int_yes, sizeof(int_yes));
+      int_res = connect(int_fd, (struct sockaddr*)&addr_inet, sizeof(addr_inet));
+    }
+  }
+
+  if (int_res != 0) {
+    fprintf(stderr, "Can't %s %s : %s.\n", bool_listen ? "listen on" : "connect to", str_address, strerror(errno));
+    close(int_fd);
+    return(-1);
+  }
+
+  return(int_fd);
+}
+
+void raiseFileLimit(void)
+{
+  /* Variables */
+  struct rlimit limit_files;
+
+  if (getrlimit(RLIMIT_NOFILE, &limit_files) != 0) return;
+  limit_files.rlim_cur = limit_files.rlim_max;
+  setrlimit(RLIMIT_NOFILE, &limit_files);
+}
+
+/*!
+  \fn static char* reserveOutput(session* conn, size_t size_bytes)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param conn The connection
+  \param size_bytes Bytes about to be written
+  \return Where to write them, NULL on allocation error
+  \brief Makes room at the end of the output buffer of a connection
+  \remarks The caller adds the bytes it wrote to outCount
+*/
+static char* reserveOutput(session* conn, size_t size_bytes)
+{
+  /* Variables */
+  char* ptr_out;
+  size_t size_new;
+
+  if (conn->outCount + size_bytes > conn->outSize) {
+    size_new = (conn->outSize == 0) ? SERVER_LINE : conn->outSize;
+    while (conn->outCount + size_bytes > size_new) size_new *= 2;
+    ptr_out = realloc(conn->out, size_new);
+    if (ptr_out == NULL) return(NULL);
+    conn->out = ptr_out;
+    conn->outSize = size_new;
+  }
+
+  return(conn->out + conn->outCount);
+}
+
+/*!
+  \fn static void reply(session* conn, const char* str_text)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param conn The connection
+  \param str_text Reply, newline included
+  \brief Queues a reply
+  \remarks The connection is closed if the reply can't be queued
+*/
+static void reply(session* conn, const char* str_text)
+{
+  /* Variables */
+  char* ptr_out;
+  size_t size_text;
+
+  size_text = strlen(str_text);
+  ptr_out = reserveOutput(conn, size_text);
+  if (ptr_out == NULL) {
+    conn->closing = true;
+    return;
+  }
+  memcpy(ptr_out, str_text, size_text);
+  conn->outCount += size_text;
+}
+
+/*!
+  \fn static void newGame(serverLoop* loop, session* conn, int64_t int_width, int64_t int_height, int64_t int_mines, int int_args, uint64_t int_seed)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param loop The event loop of the connection
+  \param conn The connection
+  \param int_width Width of the minefield
+  \param int_height Height of the minefield
+  \param int_mines Amount of mines
+  \param int_args Arguments of the request : 4 with a seed, 3 without
+  \param int_seed Seed of the minefield, if given
+  \brief Handles "new W H MINES [SEED]" : replaces the game of the connection
+  \remarks The minefield is kept when the dimensions do not change, its
+  arena goes back to the pool of the loop otherwise. The mines are placed
+  on the first reveal, away from it, like the library
+*/
+static void newGame(serverLoop* loop, session* conn, int64_t int_width, int64_t int_height, int64_t int_mines, int int_args, uint64_t int_seed)
+{
+  /* Variables */
+  dimensions dim_dimensions;
+  char* ptr_out;
+
+  if ( (int_width < 1) || (int_height < 1) || (int_width > SERVER_MAX_CELLS) || (int_height > SERVER_MAX_CELLS) ||
+       (int_width * int_height > SERVER_MAX_CELLS) ||
+       (int_mines < 1) || (int_mines >= int_width * int_height) ) {
+    reply(conn, "error arguments\n");
+    return;
+  }
+  dim_dimensions.width = (int)int_width;
+  dim_dimensions.height = (int)int_height;
+
+  if ( (conn->hasGame) && (conn->minefield.dim.width == dim_dimensions.width) && (conn->minefield.dim.height == dim_dimensions.height) ) {
+    resetMinefield(&conn->minefield);
+  } else {
+    if (conn->hasGame) releaseMinefield(&loop->pool, &conn->minefield);
+    conn->hasGame = false;
+    if (takeMinefield(&loop->pool, &conn->minefield, &conn->planes, dim_dimensions, 0, NULL) != 0) {
+      reply(conn, "error memory\n");
+      return;
+    }
+    conn->hasGame = true;
+  }
+  trackDirty(&conn->minefield, cellCount(dim_dimensions));
+
+  if (int_args < 4) int_seed = mixSeed(loop->srv->seed, (uint64_t)__atomic_fetch_add(&loop->srv->nextGame, 1, __ATOMIC_RELAXED));
+  seedRng(&conn->gen, int_seed);
+  conn->mines = int_mines;
+  conn->placed = false;
+  conn->state = OUTCOME_UNFINISHED;
+  loop->games++;
+
+  ptr_out = reserveOutput(conn, 80);
+  if (ptr_out == NULL) {
+    conn->closing = true;
+    return;
+  }
+  conn->outCount += sprintf(ptr_out, "ok %d %d %lld\n", dim_dimensions.width, dim_dimensions.height, (long long)int_mines);
+}
+
+/*!
+  \fn static void playMove(session* conn, int64_t int_x, int64_t int_y, int int_action)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param conn The connection
+  \param int_x x coordinate to click
+  \param int_y y coordinate to click
+  \param int_action 1 to reveal, 2 to mark
+  \brief Handles "click X Y" and "flag X Y"
+  \remarks Replies with the state of the game, "rejected" if the cell
+  can't be clicked
+*/
+static void playMove(session* conn, int64_t int_x, int64_t int_y, int int_action)
+{
+  /* Variables */
+  int int_res;
+
+  if (conn->hasGame == false) {
+    reply(conn, "error no game\n");
+    return;
+  }
+  if (conn->state != OUTCOME_UNFINISHED) {
+    reply(conn, "error game over\n");
+    return;
+  }
+  if ( (int_x < 0) || (int_x >= conn->minefield.dim.width) || (int_y < 0) || (int_y >= conn->minefield.dim.height) ) {
+    reply(conn, "error out of the minefield\n");
+    return;
+  }
+
+  /* The first reveal is always safe */
+  if ( (conn->placed == false) && (int_action == 1) ) {
+    placeMinesAround(&conn->minefield, conn->mines, (int)int_x, (int)int_y, &conn->gen);
+    countSurroundingMinesRows(&conn->minefield, &conn->planes, 0, conn->minefield.dim.height);
+    conn->placed = true;
+  }
+
+  int_res = click(&conn->minefield, (int)int_x, (int)int_y, int_action);
+  if (int_res == -1) {
+    reply(conn, "rejected\n");
+    return;
+  }
+  if (int_res == 0) {
+    conn->state = OUTCOME_LOST;
+  } else if ( (conn->placed) && (userHasWon(&conn->minefield)) ) {
+    conn->state = OUTCOME_WON;
+  }
+
+  reply(conn, STATE_NAMES[conn->state]);
+}
+
+/*!
+  \fn static void playMoves(session* conn, const char* str_moves)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param conn The connection
+  \param str_moves Arguments of the request : triples "X Y A"
+  \brief Handles "moves X Y A [X Y A ...]" : plays the moves in order with
+  one clickBatch, A being 1 to reveal and 2 to mark
+  \remarks Replies with the state of the game followed by the result of
+  each move played : 1, 0 for the mine, -1 if it was rejected (out of the
+  minefield, unknown action or cell that can't be clicked). The moves
+  after the end of the game are not played
+*/
+static void playMoves(session* conn, const char* str_moves)
+{
+  /* Variables */
+  boardMove moves[SERVER_MOVES];
+  batchResult batch;
+  board* minefield;
+  char* ptr_out;
+  char* str_end;
+  long long int_value;
+  int64_t int_count;
+  int64_t int_first;
+  int64_t int_played;
+  int64_t i;
+  int int_values;
+  int* ptr_field;
+
+  if (conn->hasGame == false) {
+    reply(conn, "error no game\n");
+    return;
+  }
+  if (conn->state != OUTCOME_UNFINISHED) {
+    reply(conn, "error game over\n");
+    return;
+  }
+  minefield = &conn->minefield;
+
+  /* Triples of numbers, the ones that don't fit an int are out of the minefield anyway */
+  int_count = 0;
+  int_values = 0;
+  for (;;) {
+    int_value = strtoll(str_moves, &str_end, 10);
+    if (str_end == str_moves) break;
+    str_moves = str_end;
+    if (int_count == SERVER_MOVES) {
+      reply(conn, "error arguments\n");
+      return;
+    }
+    if ( (int_value < -1) || (int_value > INT32_MAX) ) int_value = -1;
+    ptr_field = (int_values == 0) ? &moves[int_count].x : (int_values == 1) ? &moves[int_count].y : &moves[int_count].action;
+    *ptr_field = (int)int_value;
+    int_values++;
+    if (int_values == 3) {
+      int_values = 0;
+      int_count++;
+    }
+  }
+  while (*str_moves == ' ') str_moves++;
+  if ( (int_count == 0) || (int_values != 0) || (*str_moves != '\0') ) {
+    reply(conn, "error arguments\n");
+    return;
+  }
+
+  /* The first reveal is always safe : the moves before it are played on the minefield without mines */
+  int_first = 0;
+  if (conn->placed == false) {
+    while ( (int_first < int_count) && ( (moves[int_first].action != 1) ||
+            (moves[int_first].x < 0) || (moves[int_first].x >= minefield->dim.width) ||
+            (moves[int_first].y < 0) || (moves[int_first].y >= minefield->dim.height) ) ) int_first++;
+    clickBatch(minefield, moves, int_first, &batch);
+  }
+  int_played = int_first;
+  if (int_first < int_count) {
+    if (conn->placed == false) {
+      placeMinesAround(minefield, conn->mines, moves[int_first].x, moves[int_first].y, &conn->gen);
+      countSurroundingMinesRows(minefield, &conn->planes, 0, minefield->dim.height);
+      conn->placed = true;
+    }
+    int_played += clickBatch(minefield, moves + int_first, int_count - int_first, &batch);
+    if (batch.lost) {
+      conn->state = OUTCOME_LOST;
+    } else if (batch.won) {
+      conn->state = OUTCOME_WON;
+    }
+  }
+
+  ptr_out = reserveOutput(conn, 16 + (size_t)int_played * 3);
+  if (ptr_out == NULL) {
+    conn->closing = true;
+    return;
+  }
+  i = strlen(STATE_NAMES[conn->state]) - 1;
+  memcpy(ptr_out, STATE_NAMES[conn->state], i);
+  ptr_out += i;
+  conn->outCount += i;
+  for (i = 0; i < int_played; i++) {
+    conn->outCount += sprintf(ptr_out, " %d", moves[i].result);
+    ptr_out = conn->out + conn->outCount;
+  }
+  *ptr_out = '\n';
+  conn->outCount++;
+}
+
+/*!
+  \fn static void sendDiff(session* conn)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param conn The connection
+  \brief Handles "diff" : replies with the cells changed since the
+  previous diff, as "diff N" followed by N triples "X Y C"
+  \remarks C is the character of cellDisplay. The cells come from the
+  dirty list of the minefield, a cell may be listed twice. If the list
+  overflowed, every cell that is not plainly hidden is sent instead
+*/
+static void sendDiff(session* conn)
+{
+  /* Variables */
+  board* minefield;
+  char* ptr_out;
+  char* ptr_count;
+  int64_t int_cells;
+  int64_t int_sent;
+  int64_t int_index;
+  int64_t i;
+
+  if (conn->hasGame == false) {
+    reply(conn, "error no game\n");
+    return;
+  }
+  minefield = &conn->minefield;
+  int_cells = (minefield->dirtyOverflow) ? cellCount(minefield->dim) : minefield->dirtyCount;
+
+  /* "diff " and its count are written once the cells are */
+  ptr_out = reserveOutput(conn, 32 + (size_t)int_cells * 16);
+  if (ptr_out == NULL) {
+    conn->closing = true;
+    return;
+  }
+  ptr_count = ptr_out;
+  ptr_out += 32;
+
+  int_sent = 0;
+  for (i = 0; i < int_cells; i++) {
+    int_index = (minefield->dirtyOverflow) ? i : minefield->dirty[i];
+    if ( (minefield->dirtyOverflow) && (cellDisplay(minefield->cells[int_index]) == 'h') ) continue;
+    ptr_out += sprintf(ptr_out, " %lld %lld %c", (long long)(int_index % minefield->dim.width),
+                       (long long)(int_index / minefield->dim.width), cellDisplay(minefield->cells[int_index]));
+    int_sent++;
+  }
+  *ptr_out++ = '\n';
+  clearDirty(minefield);
+
+  /* Move the cells right after the count */
+  i = sprintf(ptr_count, "diff %lld", (long long)int_sent);
+  memmove(ptr_count + i, ptr_count + 32, ptr_out - (ptr_count + 32));
+  conn->outCount += i + (ptr_out - (ptr_count + 32));
+}
+
+/*!
+  \fn static void handleLine(serverLoop* loop, session* conn, char* str_line)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.3 - any blank before the command
+  \param loop The event loop of the connection
+  \param conn The connection
+  \param str_line Request, without its newline
+  \brief Handles a request and queues its reply
+  \remarks The moves start where sscanf ended the command, so the blanks
+  before it may be tabs too
+*/
+static void handleLine(serverLoop* loop, session* conn, char* str_line)
+{
+  /* Variables */
+  char str_command[16];
+  char str_extra[2];
+  long long int_a;
+  long long int_b;
+  long long int_c;
+  unsigned long long int_seed;
+  int int_args;
+  int int_end;
+
+  loop->commands++;
+  int_end = 0;
+  int_args = sscanf(str_line, "%15s%n %lld %lld %lld %llu %1s", str_command, &int_end, &int_a, &int_b, &int_c, &int_seed, str_extra);
+
+  if (int_args < 1) {
+    reply(conn, "error empty request\n");
+  } else if ( (strcmp(str_command, "click") == 0) && (int_args == 3) ) {
+    playMove(conn, int_a, int_b, 1);
+  } else if ( (strcmp(str_command, "flag") == 0) && (int_args == 3) ) {
+    playMove(conn, int_a, int_b, 2);
+  } else if ( (strcmp(str_command, "moves") == 0) && (int_args >= 1) ) {
+    playMoves(conn, str_line + int_end);
+  } else if ( (strcmp(str_command, "diff") == 0) && (int_args == 1) ) {
+    sendDiff(conn);
+  } else if ( (strcmp(str_command, "new") == 0) && ( (int_args == 4) || (int_args == 5) ) ) {
+    newGame(loop, conn, int_a, int_b, int_c, int_args - 1, int_seed);
+  } else if ( (strcmp(str_command, "quit") == 0) && (int_args == 1) ) {
+    conn->closing = true;
+  } else {
+    reply(conn, "error unknown request\n");
+  }
+}
+
+/*!
+  \fn static void closeSession(serverLoop* loop, session* conn)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param loop The event loop of the connection
+  \param conn The connection
+  \brief Closes a connection and releases its game
+  \remarks None
+*/
+static void closeSession(serverLoop* loop, session* conn)
+{
+  if (conn->prev != NULL) conn->prev->next = conn->next;
+  else loop->sessions = conn->next;
+  if (conn->next != NULL) conn->next->prev = conn->prev;
+
+  close(conn->fd);
+  if (conn->hasGame) releaseMinefield(&loop->pool, &conn->minefield);
+  free(conn->out);
+  free(conn);
+  __atomic_fetch_sub(&loop->srv->open, 1, __ATOMIC_RELAXED);
+}
+
+/*!
+  \fn static void acceptSessions(serverLoop* loop)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param loop The event loop
+  \brief Accepts the pending connections, at most SERVER_ACCEPTS of them
+  \remarks The listening socket stays readable if more are pending, so
+  that the other loops get their share
+*/
+static void acceptSessions(serverLoop* loop)
+{
+  /* Variables */
+  struct epoll_event event;
+  session* conn;
+  int64_t int_open;
+  int64_t int_peak;
+  int int_fd;
+  int int_yes;
+  int i;
+
+  int_yes = 1;
+  for (i = 0; i < SERVER_ACCEPTS; i++) {
+    int_fd = accept4(loop->srv->listener, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+    if (int_fd < 0) return;
+
+    conn = calloc(1, sizeof(session));
+    if (conn == NULL) {
+      close(int_fd);
+      return;
+    }
+    conn->fd = int_fd;
+    /* Fails on a Unix-domain socket, which doesn't need it */
+    setsockopt(int_fd, IPPROTO_TCP, TCP_NODELAY, &int_yes, sizeof(int_yes));
+
+    event.events = EPOLLIN;
+    event.data.ptr = conn;
+    if (epoll_ctl(loop->epoll, EPOLL_CTL_ADD, int_fd, &event) != 0) {
+      close(int_fd);
+      free(conn);
+      return;
+    }
+    conn->next = loop->sessions;
+    if (loop->sessions != NULL) loop->sessions->prev = conn;
+    loop->sessions = conn;
+    loop->accepted++;
+
+    int_open = __atomic_add_fetch(&loop->srv->open, 1, __ATOMIC_RELAXED);
+    int_peak = __atomic_load_n(&loop->srv->peakOpen, __ATOMIC_RELAXED);
+    while ( (int_open > int_peak) &&
+            (__atomic_compare_exchange_n(&loop->srv->peakOpen, &int_peak, int_open, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED) == false) );
+  }
+}
+
+/*!
+  \fn static void handleSession(serverLoop* loop, session* conn)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param loop The event loop of the connection
+  \param conn The connection, closed if it fails or is over
+  \brief Reads the requests of a connection, handles every complete line
+  and sends the replies
+  \remarks While replies are waiting for the socket, the connection is
+  only watched for writing : a client that doesn't read its replies
+  isn't read either
+*/
+static void handleSession(serverLoop* loop, session* conn)
+{
+  /* Variables */
+  struct epoll_event event;
+  ssize_t int_bytes;
+  char* ptr_line;
+  char* ptr_end;
+
+  if (conn->writing == false) {
+    int_bytes = read(conn->fd, conn->in + conn->inCount, SERVER_LINE - conn->inCount);
+    if ( (int_bytes == 0) || ( (int_bytes < 0) && (errno != EAGAIN) && (errno != EINTR) ) ) {
+      closeSession(loop, conn);
+      return;
+    }
+    if (int_bytes > 0) conn->inCount += int_bytes;
+
+    /* Every complete line */
+    ptr_line = conn->in;
+    while ( (conn->closing == false) && ( (ptr_end = memchr(ptr_line, '\n', conn->in + conn->inCount - ptr_line)) != NULL ) ) {
+      *ptr_end = '\0';
+      if ( (ptr_end > ptr_line) && (ptr_end[-1] == '\r') ) ptr_end[-1] = '\0';
+      handleLine(loop, conn, ptr_line);
+      ptr_line = ptr_end + 1;
+    }
+    conn->inCount -= ptr_line - conn->in;
+    memmove(conn->in, ptr_line, conn->inCount);
+
+    if ( (conn->inCount == SERVER_LINE) && (conn->closing == false) ) {
+      reply(conn, "error request too long\n");
+      conn->closing = true;
+    }
+  }
+
+  /* Send what the socket takes */
+  while (conn->outSent < conn->outCount) {
+    int_bytes = send(conn->fd, conn->out + conn->outSent, conn->outCount - conn->outSent, MSG_NOSIGNAL);
+    if (int_bytes < 0) {
+      if ( (errno == EAGAIN) || (errno == EINTR) ) break;
+      closeSession(loop, conn);
+      return;
+    }
+    conn->outSent += int_bytes;
+  }
+  if (conn->outSent == conn->outCount) {
+    conn->outSent = 0;
+    conn->outCount = 0;
+    if (conn->closing) {
+      closeSession(loop, conn);
+      return;
+    }
+  }
+
+  /* Watch the socket for what comes next */
+  if ( (conn->outCount > 0) != conn->writing ) {
+    conn->writing = (conn->outCount > 0);
+    event.events = (conn->writing) ? EPOLLOUT : EPOLLIN;
+    event.data.ptr = conn;
+    if (epoll_ctl(loop->epoll, EPOLL_CTL_MOD, conn->fd, &event) != 0) closeSession(loop, conn);
+  }
+}
+
+/*!
+  \fn static void* runLoop(void* ptr_loop)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param ptr_loop The serverLoop of the thread
+  \return NULL
+  \brief Event loop of a thread, until the eventfd of the server is written
+  \remarks The listening socket has a NULL pointer in the epoll set, the
+  eventfd the server
+*/
+static void* runLoop(void* ptr_loop)
+{
+  /* Variables */
+  serverLoop* loop;
+  struct epoll_event events[SERVER_EVENTS];
+  boolean bool_running;
+  int int_events;
+  int i;
+
+  loop = ptr_loop;
+  bool_running = true;
+  while (bool_running) {
+    int_events = epoll_wait(loop->epoll, events, SERVER_EVENTS, -1);
+    for (i = 0; i < int_events; i++) {
+      if (events[i].data.ptr == NULL) {
+        acceptSessions(loop);
+      } else if (events[i].data.ptr == loop->srv) {
+        bool_running = false;
+      } else {
+        handleSession(loop, events[i].data.ptr);
+      }
+    }
+  }
+
+  while (loop->sessions != NULL) closeSession(loop, loop->sessions);
+  emptyPool(&loop->pool);
+
+  return(NULL);
+}
+
+int runServer(options* opt)
+{
+  /* Variables */
+  server srv;
+  serverLoop* loops;
+  struct epoll_event event;
+  struct timespec time_limit;
+  sigset_t set_signals;
+  uint64_t int_wake;
+  int64_t int_start;
+  int64_t int_elapsedNs;
+  int64_t int_accepted;
+  int64_t int_commands;
+  int64_t int_games;
+  int64_t int_arenas;
+  int int_threads;
+  int int_signal;
+  int i;
+
+  raiseFileLimit();
+  srv.listener = openEndpoint(opt->serve, true);
+  if (srv.listener < 0) return(FILE_ERROR);
+  srv.wake = eventfd(0, EFD_CLOEXEC);
+  srv.seed = opt->seed;
+  srv.nextGame = 0;
+  srv.open = 0;
+  srv.peakOpen = 0;
+
+  /* One loop per core by default */
+  int_threads = opt->threads;
+  if (int_threads == 0) int_threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+  if (int_threads < 1) int_threads = 1;
+  loops = calloc(int_threads, sizeof(serverLoop));
+
+  /* Kill the program if allocation error */
+  if ( (loops == NULL) || (srv.wake < 0) ) {
+    fprintf(stderr, "Memory allocation error.\n");
+    exit(MEMORY_ALLOCATION_ERROR);
+  }
+
+  /* Only this thread waits for the signals, the loops inherit the mask */
+  sigemptyset(&set_signals);
+  sigaddset(&set_signals, SIGINT);
+  sigaddset(&set_signals, SIGTERM);
+  pthread_sigmask(SIG_BLOCK, &set_signals, NULL);
+
+  int_start = nowNs();
+  for (i = 0; i < int_threads; i++) {
+    loops[i].srv = &srv;
+    initPool(&loops[i].pool);
+    loops[i].epoll = epoll_create1(EPOLL_CLOEXEC);
+    /* EPOLLEXCLUSIVE : a new connection wakes one loop, not all of them */
+    event.events = EPOLLIN | EPOLLEXCLUSIVE;
+    event.data.ptr = NULL;
+    if ( (loops[i].epoll < 0) || (epoll_ctl(loops[i].epoll, EPOLL_CTL_ADD, srv.listener, &event) != 0) ) {
+      fprintf(stderr, "Can't create an event loop.\n");
+      exit(MEMORY_ALLOCATION_ERROR);
+    }
+    event.events = EPOLLIN;
+    event.data.ptr = &srv;
+    epoll_ctl(loops[i].epoll, EPOLL_CTL_ADD, srv.wake, &event);
+    if (pthread_create(&loops[i].thread, NULL, runLoop, &loops[i]) != 0) {
+      fprintf(stderr, "Can't start a thread.\n");
+      exit(MEMORY_ALLOCATION_ERROR);
+    }
+  }
+
+  if (opt->seconds > 0) {
+    time_limit.tv_sec = opt->seconds;
+    time_limit.tv_nsec = 0;
+    sigtimedwait(&set_signals, NULL, &time_limit);
+  } else {
+    sigwait(&set_signals, &int_signal);
+  }
+
+  /* Never read : the eventfd stays readable for every loop */
+  int_wake = 1;
+  if (write(srv.wake, &int_wake, sizeof(int_wake)) != sizeof(int_wake)) fprintf(stderr, "Can't stop the event loops.\n");
+
+  int_accepted = 0;
+  int_commands = 0;
+  int_games = 0;
+  int_arenas = 0;
+  for (i = 0; i < int_threads; i++) {
+    pthread_join(loops[i].thread, NULL);
+    close(loops[i].epoll);
+    int_accepted += loops[i].accepted;
+    int_commands += loops[i].commands;
+    int_games += loops[i].games;
+    int_arenas += loops[i].pool.allocated;
+  }
+  int_elapsedNs = nowNs() - int_start;
+  free(loops);
+  close(srv.wake);
+  close(srv.listener);
+  if (isUnixAddress(opt->serve)) unlink(opt->serve);
+
+  printf("{\"mode\":\"serve\",\"address\":\"%s\",\"threads\":%d,\"sessions\":%lld,\"peak_sessions\":%lld,"
+         "\"games\":%lld,\"arenas\":%lld,\"requests\":%lld,\"elapsed_ns\":%lld}\n",
+         opt->serve, int_threads, (long long)int_accepted, (long long)srv.peakOpen,
+         (long long)int_games, (long long)int_arenas, (long long)int_commands, (long long)int_elapsedNs);
+
+  return(0);
+}
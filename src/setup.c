@@ -0,0 +1,292 @@
+/*!
+  \file setup.c
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \brief Tiled setup of large minefields
+  \remarks None
+
+  Creates very large minefields on several threads :
+  the minefield is cut in bands of rows (the tiles),
+  which are filled with their mines then counted
+  independently. Only the amount of mines of every
+  tile is drawn up front, so the result does not
+  depend on which thread handles which tile.
+
+*/
+
+#include "setup.h"
+#include "console.h"
+#include "bitboard.h"
+#include "random.h"
+
+#include <math.h>
+#include <unistd.h>
+
+
+
+/*!
+  \fn static double logChoose(int64_t int_n, int64_t int_k)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.2 - reentrant
+  \param int_n Size of the set
+  \param int_k Size of the subsets
+  \return The logarithm of the amount of subsets of k elements among n
+  \brief Logarithm of a binomial coefficient
+  \remarks lgamma_r keeps the sign to itself, lgamma writes the global
+  signgam from every thread
+*/
+static double logChoose(int64_t int_n, int64_t int_k)
+{
+  /* Variables */
+  int int_sign;
+
+  return(lgamma_r(int_n + 1.0, &int_sign) - lgamma_r(int_k + 1.0, &int_sign) - lgamma_r(int_n - int_k + 1.0, &int_sign));
+}
+
+/*!
+  \fn static int64_t drawHypergeometric(rng* gen, int64_t int_total, int64_t int_good, int64_t int_draws)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param gen Random number generator
+  \param int_total Amount of cells
+  \param int_good Amount of mines among them
+  \param int_draws Amount of cells taken without replacement
+  \return Amount of mines among the cells taken
+  \brief Draws from the hypergeometric distribution
+  \remarks Inversion starting at the mode and going towards the most likely
+  side first : the amount of steps is about the standard deviation, a few
+  hundreds for a tile of a million cells
+*/
+static int64_t drawHypergeometric(rng* gen, int64_t int_total, int64_t int_good, int64_t int_draws)
+{
+  /* Variables */
+  int64_t int_low;
+  int64_t int_high;
+  int64_t int_mode;
+  int64_t int_up;
+  int64_t int_down;
+  int64_t int_rest;
+  double int_u;
+  double int_probUp;
+  double int_probDown;
+  double int_nextUp;
+  double int_nextDown;
+
+  int_rest = int_total - int_good;
+  int_low = (int_draws > int_rest) ? int_draws - int_rest : 0;
+  int_high = (int_draws < int_good) ? int_draws : int_good;
+  if (int_low == int_high) return(int_low);
+
+  int_mode = (int64_t)(((double)int_draws + 1.0) * ((double)int_good + 1.0) / ((double)int_total + 2.0));
+  if (int_mode < int_low) int_mode = int_low;
+  if (int_mode > int_high) int_mode = int_high;
+
+  int_probUp = exp(logChoose(int_good, int_mode) + logChoose(int_rest, int_draws - int_mode) - logChoose(int_total, int_draws));
+  int_probDown = int_probUp;
+  int_u = (nextRandom(gen) >> 11) * 0x1.0p-53 - int_probUp;
+  int_up = int_mode;
+  int_down = int_mode;
+
+  while (int_u >= 0.0) {
+    /* Probabilities of the next amounts on both sides */
+    int_nextUp = 0.0;
+    if (int_up < int_high) {
+      int_nextUp = int_probUp * (double)(int_good - int_up) * (double)(int_draws - int_up)
+                   / ((double)(int_up + 1) * (double)(int_rest - int_draws + int_up + 1));
+    }
+    int_nextDown = 0.0;
+    if (int_down > int_low) {
+      int_nextDown = int_probDown * (double)int_down * (double)(int_rest - int_draws + int_down)
+                     / ((double)(int_good - int_down + 1) * (double)(int_draws - int_down + 1));
+    }
+
+    /* Rounding left some probability over */
+    if ( (int_nextUp == 0.0) && (int_nextDown == 0.0) ) return(int_mode);
+
+    if (int_nextUp >= int_nextDown) {
+      int_up++;
+      int_probUp = int_nextUp;
+      int_u -= int_nextUp;
+      if (int_u < 0.0) return(int_up);
+    } else {
+      int_down--;
+      int_probDown = int_nextDown;
+      int_u -= int_nextDown;
+      if (int_u < 0.0) return(int_down);
+    }
+  }
+
+  return(int_mode);
+}
+
+/*!
+  \fn static void fillTile(setupJob* job, int64_t int_tile)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param job The tiles
+  \param int_tile The tile to fill
+  \brief Clears the cells of a tile and places its mines
+  \remarks Floyd's algorithm on the cells of the tile, like placeMines,
+  with the stream mixSeed(seed, tile). The last tile also clears the
+  padding of the minefield
+*/
+static void fillTile(setupJob* job, int64_t int_tile)
+{
+  /* Variables */
+  board* minefield;
+  cell* ptr_cells;
+  rng gen;
+  int64_t i;
+  int64_t int_index;
+  int64_t int_nCells;
+  int64_t int_nDraws;
+  int64_t int_y0;
+  int64_t int_y1;
+  size_t size_bytes;
+  cell int_picked;
+
+  minefield = job->minefield;
+  int_y0 = int_tile * job->tileRows;
+  int_y1 = (int_y0 + job->tileRows < minefield->dim.height) ? int_y0 + job->tileRows : minefield->dim.height;
+  ptr_cells = minefield->cells + int_y0 * minefield->dim.width;
+  int_nCells = (int_y1 - int_y0) * minefield->dim.width;
+
+  /* No mine, hidden, no flag, no surrounding mines */
+  size_bytes = (int_y1 == minefield->dim.height) ? cellBytes(minefield->dim) - int_y0 * minefield->dim.width : (size_t)int_nCells;
+  memset(ptr_cells, CELL_HIDDEN, size_bytes);
+
+  /* Above half the cells, fill the tile and draw the safe cells instead */
+  seedRng(&gen, mixSeed(job->seed, int_tile));
+  int_nDraws = job->tileMines[int_tile];
+  int_picked = CELL_MINE;
+  if (2 * int_nDraws > int_nCells) {
+    for (i = 0; i < int_nCells; i++) ptr_cells[i] |= CELL_MINE;
+    int_nDraws = int_nCells - int_nDraws;
+    int_picked = 0;
+  }
+
+  for (i = int_nCells - int_nDraws; i < int_nCells; i++) {
+    int_index = boundedRandom(&gen, i + 1);
+    if ((ptr_cells[int_index] & CELL_MINE) == int_picked) int_index = i;
+    ptr_cells[int_index] ^= CELL_MINE;
+  }
+}
+
+/*!
+  \fn static void* runSetupWorker(void* ptr_job)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.2 - halos
+  \param ptr_job The setupJob
+  \return NULL
+  \brief Fills tiles until there is none left, waits for the other threads,
+  then counts the surrounding mines of tiles until there is none left
+  \remarks The counts of a tile read the rows of mines packed by the tiles
+  around it, hence the barrier between both steps. They never read the
+  cells of another tile, whose counts another thread may be writing
+*/
+static void* runSetupWorker(void* ptr_job)
+{
+  /* Variables */
+  setupJob* job;
+  bitboard planes;
+  int64_t int_tile;
+  int64_t int_y0;
+  int64_t int_y1;
+  const uint64_t* ptr_above;
+  const uint64_t* ptr_below;
+
+  job = ptr_job;
+  while ( (int_tile = __atomic_fetch_add(&job->nextFill, 1, __ATOMIC_RELAXED)) < job->tiles ) {
+    fillTile(job, int_tile);
+    int_y0 = int_tile * job->tileRows;
+    int_y1 = (int_y0 + job->tileRows < job->minefield->dim.height) ? int_y0 + job->tileRows : job->minefield->dim.height;
+    packMineRow(job->minefield, int_y0, job->firstRows + int_tile * job->words, job->words);
+    if (job->lastRows != job->firstRows) packMineRow(job->minefield, int_y1 - 1, job->lastRows + int_tile * job->words, job->words);
+  }
+  pthread_barrier_wait(&job->filled);
+
+  initBitboard(&planes, job->minefield->dim);
+  while ( (int_tile = __atomic_fetch_add(&job->nextCount, 1, __ATOMIC_RELAXED)) < job->tiles ) {
+    int_y0 = int_tile * job->tileRows;
+    int_y1 = (int_y0 + job->tileRows < job->minefield->dim.height) ? int_y0 + job->tileRows : job->minefield->dim.height;
+    ptr_above = (int_tile > 0) ? job->lastRows + (int_tile - 1) * job->words : NULL;
+    ptr_below = (int_tile + 1 < job->tiles) ? job->firstRows + (int_tile + 1) * job->words : NULL;
+    countSurroundingMinesHalo(job->minefield, &planes, int_y0, int_y1, ptr_above, ptr_below);
+  }
+  freeBitboard(&planes);
+
+  return(NULL);
+}
+
+void setupMinefieldTiled(board* minefield, dimensions dim_dimensions, int64_t int_mines, uint64_t int_seed, int int_threads)
+{
+  /* Variables */
+  setupJob job;
+  pthread_t* ptr_threads;
+  rng gen;
+  int64_t i;
+  int64_t int_cellsLeft;
+  int64_t int_minesLeft;
+  int64_t int_tileCells;
+
+  allocMinefield(minefield, dim_dimensions);
+  job.minefield = minefield;
+  job.seed = int_seed;
+  job.tileRows = (dim_dimensions.width < SETUP_TILE_CELLS) ? SETUP_TILE_CELLS / dim_dimensions.width : 1;
+  if (job.tileRows > dim_dimensions.height) job.tileRows = dim_dimensions.height;
+  job.tiles = (dim_dimensions.height + job.tileRows - 1) / job.tileRows;
+  job.nextFill = 0;
+  job.nextCount = 0;
+  job.tileMines = malloc(job.tiles * sizeof(int64_t));
+  job.words = (dim_dimensions.width + 63) / 64;
+  job.firstRows = malloc(job.tiles * job.words * sizeof(uint64_t));
+  job.lastRows = (job.tileRows == 1) ? job.firstRows : malloc(job.tiles * job.words * sizeof(uint64_t));
+
+  /* One thread per core by default, no more than tiles */
+  if (int_threads == 0) int_threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+  if (int_threads < 1) int_threads = 1;
+  if (int_threads > job.tiles) int_threads = (int)job.tiles;
+  ptr_threads = malloc(int_threads * sizeof(pthread_t));
+
+  /* Kill the program if allocation error */
+  if ( (job.tileMines == NULL) || (job.firstRows == NULL) || (job.lastRows == NULL) || (ptr_threads == NULL) ) {
+    fprintf(stderr, "Memory allocation error.\n");
+    exit(MEMORY_ALLOCATION_ERROR);
+  }
+
+  /* Share the mines between the tiles, one tile after the other */
+  seedRng(&gen, int_seed);
+  int_cellsLeft = cellCount(dim_dimensions);
+  int_minesLeft = int_mines;
+  for (i = 0; i < job.tiles; i++) {
+    int_tileCells = (int64_t)job.tileRows * dim_dimensions.width;
+    if (int_tileCells > int_cellsLeft) int_tileCells = int_cellsLeft;
+    job.tileMines[i] = drawHypergeometric(&gen, int_cellsLeft, int_minesLeft, int_tileCells);
+    int_cellsLeft -= int_tileCells;
+    int_minesLeft -= job.tileMines[i];
+  }
+
+  pthread_barrier_init(&job.filled, NULL, int_threads);
+  for (i = 0; i < int_threads; i++) {
+    if (pthread_create(&ptr_threads[i], NULL, runSetupWorker, &job) != 0) {
+      fprintf(stderr, "Can't start a thread.\n");
+      exit(MEMORY_ALLOCATION_ERROR);
+    }
+  }
+  for (i = 0; i < int_threads; i++) pthread_join(ptr_threads[i], NULL);
+  pthread_barrier_destroy(&job.filled);
+
+  minefield->count.mines = int_mines;
+  minefield->count.hiddenMines = int_mines;
+  minefield->count.hiddenSafe = cellCount(dim_dimensions) - int_mines;
+
+  if (job.lastRows != job.firstRows) free(job.lastRows);
+  free(job.firstRows);
+  free(job.tileMines);
+  free(ptr_threads);
+}
@@ -0,0 +1,233 @@
+/*!
+  \file simulate.c
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \brief Simulation mode
+  \remarks None
+
+  Plays a large amount of games with a strategy on
+  every core, without any display, and prints the win
+  rate with its confidence interval, to tune the
+  presets of the minefields.
+
+*/
+
+#include "simulate.h"
+#include "console.h"
+#include "minesweeper.h"
+
+#include <math.h>
+#include <unistd.h>
+
+
+
+/*!
+  \fn static void playRandom(board* minefield, solver* solv, rng* gen, solverResult* result)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param minefield The minefield, nothing revealed yet
+  \param solv Unused
+  \param gen Random number generator
+  \param result Where to store the result
+  \brief Reveals random hidden cells until the game ends
+  \remarks Every click after the first one is a guess
+*/
+static void playRandom(board* minefield, solver* solv, rng* gen, solverResult* result)
+{
+  /* Variables */
+  int64_t int_index;
+
+  result->won = false;
+  result->guesses = -1;
+  result->reveals = 0;
+  result->flags = 0;
+
+  do {
+    int_index = pickUnknownCell(minefield, gen);
+    result->guesses++;
+    result->reveals++;
+    if (click(minefield, int_index % minefield->dim.width, int_index / minefield->dim.width, 1) == 0) return;
+  } while (userHasWon(minefield) == 0);
+
+  result->won = true;
+}
+
+/*!
+  \fn static void playSolver(board* minefield, solver* solv, rng* gen, solverResult* result)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param minefield The minefield, nothing revealed yet
+  \param solv The solver of the thread
+  \param gen Random number generator
+  \param result Where to store the result
+  \brief Lets the solver play from the centre, like --solve
+  \remarks None
+*/
+static void playSolver(board* minefield, solver* solv, rng* gen, solverResult* result)
+{
+  solveMinefield(solv, minefield, minefield->dim.width / 2, minefield->dim.height / 2, gen, result);
+}
+
+/*! Strategies known by --strategy */
+static const strategy STRATEGIES[] = {
+  {"solver", playSolver},
+  {"random", playRandom}
+};
+
+const strategy* findStrategy(const char* str_name)
+{
+  /* Variables */
+  size_t i;
+
+  for (i = 0; i < sizeof(STRATEGIES) / sizeof(STRATEGIES[0]); i++) {
+    if (strcmp(STRATEGIES[i].name, str_name) == 0) return(&STRATEGIES[i]);
+  }
+
+  return(NULL);
+}
+
+/*!
+  \fn static void* runWorker(void* ptr_worker)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param ptr_worker The simulationWorker of the thread
+  \return NULL
+  \brief Plays chunks of games until there is none left
+  \remarks The minefield, the bit planes and the solver are allocated by the
+  thread itself and reused by all its games
+*/
+static void* runWorker(void* ptr_worker)
+{
+  /* Variables */
+  simulationWorker* worker;
+  simulation* sim;
+  solverResult result;
+  int64_t i;
+  int64_t int_first;
+  int64_t int_last;
+
+  worker = ptr_worker;
+  sim = worker->sim;
+  initMinefield(&worker->minefield, sim->dim);
+  initBitboard(&worker->planes, sim->dim);
+  initSolver(&worker->solv, sim->dim);
+
+  for (;;) {
+    int_first = __atomic_fetch_add(&sim->nextGame, SIMULATION_CHUNK, __ATOMIC_RELAXED);
+    if (int_first >= sim->games) break;
+    int_last = (int_first + SIMULATION_CHUNK < sim->games) ? int_first + SIMULATION_CHUNK : sim->games;
+
+    for (i = int_first; i < int_last; i++) {
+      seedRng(&worker->gen, mixSeed(sim->seed, i));
+      resetMinefield(&worker->minefield);
+      placeMines(&worker->minefield, sim->mines, &worker->gen);
+      countSurroundingMinesRows(&worker->minefield, &worker->planes, 0, sim->dim.height);
+
+      sim->strat->play(&worker->minefield, &worker->solv, &worker->gen, &result);
+      worker->games++;
+      worker->won += result.won;
+      worker->clicks += result.reveals + result.flags;
+      worker->guesses += result.guesses;
+    }
+  }
+
+  freeSolver(&worker->solv);
+  freeBitboard(&worker->planes);
+  freeMinefield(&worker->minefield);
+
+  return(NULL);
+}
+
+void simulateGames(simulation* sim, simulationWorker* workers, int int_threads)
+{
+  /* Variables */
+  int i;
+
+  sim->nextGame = 0;
+  for (i = 0; i < int_threads; i++) {
+    memset(&workers[i], 0, sizeof(simulationWorker));
+    workers[i].sim = sim;
+    if (pthread_create(&workers[i].thread, NULL, runWorker, &workers[i]) != 0) {
+      fprintf(stderr, "Can't start a thread.\n");
+      exit(MEMORY_ALLOCATION_ERROR);
+    }
+  }
+
+  for (i = 0; i < int_threads; i++) pthread_join(workers[i].thread, NULL);
+}
+
+int runSimulation(options* opt)
+{
+  /* Variables */
+  simulation sim;
+  simulationWorker* workers;
+  int i;
+  int int_threads;
+  int64_t int_start;
+  int64_t int_elapsedNs;
+  int64_t int_won;
+  int64_t int_clicks;
+  int64_t int_guesses;
+  double int_rate;
+  double int_centre;
+  double int_margin;
+  double int_z2;
+
+  sim.strat = findStrategy(opt->strategy);
+  if (sim.strat == NULL) {
+    fprintf(stderr, "Unknown strategy %s.\n", opt->strategy);
+    return(ARGUMENT_ERROR);
+  }
+  sim.dim = opt->dim;
+  sim.mines = opt->mines;
+  sim.seed = opt->seed;
+  sim.games = opt->games;
+
+  /* One thread per core by default */
+  int_threads = opt->threads;
+  if (int_threads == 0) int_threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+  if (int_threads < 1) int_threads = 1;
+  workers = malloc(int_threads * sizeof(simulationWorker));
+
+  /* Kill the program if allocation error */
+  if (workers == NULL) {
+    fprintf(stderr, "Memory allocation error.\n");
+    exit(MEMORY_ALLOCATION_ERROR);
+  }
+
+  int_start = nowNs();
+  simulateGames(&sim, workers, int_threads);
+  int_elapsedNs = nowNs() - int_start;
+
+  int_won = 0;
+  int_clicks = 0;
+  int_guesses = 0;
+  for (i = 0; i < int_threads; i++) {
+    int_won += workers[i].won;
+    int_clicks += workers[i].clicks;
+    int_guesses += workers[i].guesses;
+  }
+  free(workers);
+
+  /* Wilson score interval, still meaningful when nearly every game is won or lost */
+  int_rate = (double)int_won / sim.games;
+  int_z2 = SIMULATION_Z * SIMULATION_Z;
+  int_centre = (int_rate + int_z2 / (2.0 * sim.games)) / (1.0 + int_z2 / sim.games);
+  int_margin = SIMULATION_Z / (1.0 + int_z2 / sim.games)
+               * sqrt(int_rate * (1.0 - int_rate) / sim.games + int_z2 / (4.0 * sim.games * sim.games));
+
+  printf("{\"mode\":\"simulate\",\"strategy\":\"%s\",\"threads\":%d,\"width\":%d,\"height\":%d,\"mines\":%lld,"
+         "\"seed\":%llu,\"games\":%lld,\"won\":%lld,\"win_rate\":%.6f,\"win_rate_low\":%.6f,\"win_rate_high\":%.6f,"
+         "\"average_clicks\":%.3f,\"average_guesses\":%.3f,\"elapsed_ns\":%lld,\"games_per_second\":%.0f}\n",
+         sim.strat->name, int_threads, sim.dim.width, sim.dim.height, (long long)sim.mines,
+         (unsigned long long)sim.seed, (long long)sim.games, (long long)int_won, int_rate,
+         int_centre - int_margin, int_centre + int_margin, (double)int_clicks / sim.games,
+         (double)int_guesses / sim.games, (long long)int_elapsedNs,
+         (int_elapsedNs > 0) ? 1e9 * sim.games / int_elapsedNs : 0.0);
+
+  return(0);
+}
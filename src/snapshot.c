@@ -0,0 +1,338 @@
+/*!
+  \file snapshot.c
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \brief Snapshots of a game
+  \remarks None
+
+  Saves a game to a binary file and resumes it later.
+  The file is a header of one page followed by the
+  packed cells exactly as they are in memory, so a
+  snapshot is loaded by mapping it, without reading
+  the cells, however big the minefield.
+
+*/
+
+#include "snapshot.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+
+
+/*!
+  \fn static void hashBytes(uint64_t* ptr_lanes, const uint8_t* ptr_bytes, size_t size_bytes)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param ptr_lanes The 4 lanes of the checksum, updated
+  \param ptr_bytes Bytes to hash
+  \param size_bytes Amount of bytes, a multiple of 32
+  \brief Adds bytes to a checksum
+  \remarks Four independent lanes of multiply and xorshift on 8 bytes, so
+  hashing keeps up with the disk. Hashing a buffer in several pieces of
+  multiples of 32 bytes gives the same checksum as hashing it at once
+*/
+static void hashBytes(uint64_t* ptr_lanes, const uint8_t* ptr_bytes, size_t size_bytes)
+{
+  /* Variables */
+  size_t i;
+  int j;
+
+  for (i = 0; i < size_bytes; i += 32) {
+    for (j = 0; j < 4; j++) {
+      ptr_lanes[j] = (ptr_lanes[j] ^ readLe64(ptr_bytes + i + 8 * j)) * 0x9E3779B97F4A7C15ULL;
+      ptr_lanes[j] ^= ptr_lanes[j] >> 29;
+    }
+  }
+}
+
+/*!
+  \fn static void startChecksum(uint64_t* ptr_lanes)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param ptr_lanes The 4 lanes of the checksum
+  \brief Initializes the lanes of a checksum
+  \remarks None
+*/
+static void startChecksum(uint64_t* ptr_lanes)
+{
+  ptr_lanes[0] = 0x243F6A8885A308D3ULL;
+  ptr_lanes[1] = 0x13198A2E03707344ULL;
+  ptr_lanes[2] = 0xA4093822299F31D0ULL;
+  ptr_lanes[3] = 0x082EFA98EC4E6C89ULL;
+}
+
+/*!
+  \fn static uint64_t endChecksum(const uint64_t* ptr_lanes)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param ptr_lanes The 4 lanes of the checksum
+  \return The checksum
+  \brief Combines the lanes of a checksum
+  \remarks None
+*/
+static uint64_t endChecksum(const uint64_t* ptr_lanes)
+{
+  /* Variables */
+  uint64_t int_h;
+  int j;
+
+  int_h = 0;
+  for (j = 0; j < 4; j++) {
+    int_h = (int_h ^ ptr_lanes[j]) * 0xBF58476D1CE4E5B9ULL;
+    int_h ^= int_h >> 31;
+  }
+
+  return(int_h);
+}
+
+/*!
+  \fn static uint64_t checksum(const uint8_t* ptr_bytes, size_t size_bytes)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param ptr_bytes Bytes to hash
+  \param size_bytes Amount of bytes, a multiple of 32
+  \return The checksum of the bytes
+  \brief Hashes a buffer at once
+  \remarks None
+*/
+static uint64_t checksum(const uint8_t* ptr_bytes, size_t size_bytes)
+{
+  /* Variables */
+  uint64_t ptr_lanes[4];
+
+  startChecksum(ptr_lanes);
+  hashBytes(ptr_lanes, ptr_bytes, size_bytes);
+
+  return(endChecksum(ptr_lanes));
+}
+
+/*!
+  \fn static void encodeHeader(const snapshotHeader* header, uint8_t* ptr_bytes)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param header The header
+  \param ptr_bytes SNAPSHOT_HEADER_SIZE bytes to fill
+  \brief Lays a header out as it is stored in the file, checksum included
+  \remarks None
+*/
+static void encodeHeader(const snapshotHeader* header, uint8_t* ptr_bytes)
+{
+  memset(ptr_bytes, 0, SNAPSHOT_HEADER_SIZE);
+  memcpy(ptr_bytes, SNAPSHOT_MAGIC, 8);
+  writeLe32(ptr_bytes + 8, header->version);
+  writeLe32(ptr_bytes + 12, header->headerSize);
+  writeLe32(ptr_bytes + 16, (uint32_t)header->dim.width);
+  writeLe32(ptr_bytes + 20, (uint32_t)header->dim.height);
+  writeLe64(ptr_bytes + 24, header->seed);
+  writeLe64(ptr_bytes + 32, (uint64_t)header->count.mines);
+  writeLe64(ptr_bytes + 40, (uint64_t)header->count.flags);
+  writeLe64(ptr_bytes + 48, (uint64_t)header->count.validFlags);
+  writeLe64(ptr_bytes + 56, (uint64_t)header->count.hiddenSafe);
+  writeLe64(ptr_bytes + 64, (uint64_t)header->count.hiddenMines);
+  writeLe64(ptr_bytes + 72, header->cellsOffset);
+  writeLe64(ptr_bytes + 80, header->cellsSize);
+  writeLe64(ptr_bytes + 88, header->cellsChecksum);
+  writeLe64(ptr_bytes + SNAPSHOT_HEADER_USED, checksum(ptr_bytes, SNAPSHOT_HEADER_USED));
+}
+
+/*!
+  \fn static boolean decodeHeader(const uint8_t* ptr_bytes, snapshotHeader* header)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param ptr_bytes The first SNAPSHOT_HEADER_USED + 8 bytes of the file
+  \param header The header to fill
+  \return false if the checksum of the header doesn't match
+  \brief Reads a header as it is stored in the file
+  \remarks The magic and the version are checked by the caller
+*/
+static boolean decodeHeader(const uint8_t* ptr_bytes, snapshotHeader* header)
+{
+  header->version = readLe32(ptr_bytes + 8);
+  header->headerSize = readLe32(ptr_bytes + 12);
+  header->dim.width = (int)readLe32(ptr_bytes + 16);
+  header->dim.height = (int)readLe32(ptr_bytes + 20);
+  header->seed = readLe64(ptr_bytes + 24);
+  header->count.mines = (int64_t)readLe64(ptr_bytes + 32);
+  header->count.flags = (int64_t)readLe64(ptr_bytes + 40);
+  header->count.validFlags = (int64_t)readLe64(ptr_bytes + 48);
+  header->count.hiddenSafe = (int64_t)readLe64(ptr_bytes + 56);
+  header->count.hiddenMines = (int64_t)readLe64(ptr_bytes + 64);
+  header->cellsOffset = readLe64(ptr_bytes + 72);
+  header->cellsSize = readLe64(ptr_bytes + 80);
+  header->cellsChecksum = readLe64(ptr_bytes + 88);
+
+  return(readLe64(ptr_bytes + SNAPSHOT_HEADER_USED) == checksum(ptr_bytes, SNAPSHOT_HEADER_USED));
+}
+
+/*!
+  \fn static boolean writeAll(int int_fd, const uint8_t* ptr_bytes, size_t size_bytes, off_t int_offset)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param int_fd File descriptor
+  \param ptr_bytes Bytes to write
+  \param size_bytes Amount of bytes
+  \param int_offset Where to write them in the file
+  \return false on error
+  \brief Writes a buffer entirely, even if the system writes it in pieces
+  \remarks None
+*/
+static boolean writeAll(int int_fd, const uint8_t* ptr_bytes, size_t size_bytes, off_t int_offset)
+{
+  /* Variables */
+  ssize_t int_written;
+
+  while (size_bytes > 0) {
+    int_written = pwrite(int_fd, ptr_bytes, size_bytes, int_offset);
+    if (int_written < 0) {
+      if (errno == EINTR) continue;
+      return(false);
+    }
+    ptr_bytes += int_written;
+    size_bytes -= int_written;
+    int_offset += int_written;
+  }
+
+  return(true);
+}
+
+int saveSnapshot(board* minefield, uint64_t int_seed, const char* str_path)
+{
+  /* Variables */
+  snapshotHeader header;
+  uint8_t ptr_bytes[SNAPSHOT_HEADER_SIZE];
+  uint64_t ptr_lanes[4];
+  char* str_tmp;
+  size_t size_offset;
+  size_t size_chunk;
+  boolean bool_ok;
+  int int_fd;
+
+  str_tmp = malloc(strlen(str_path) + 5);
+
+  /* Kill the program if allocation error */
+  if (str_tmp == NULL) {
+    fprintf(stderr, "Memory allocation error.\n");
+    exit(MEMORY_ALLOCATION_ERROR);
+  }
+  sprintf(str_tmp, "%s.tmp", str_path);
+
+  int_fd = open(str_tmp, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (int_fd < 0) {
+    fprintf(stderr, "Can't write the snapshot %s.\n", str_tmp);
+    free(str_tmp);
+    return(FILE_ERROR);
+  }
+
+  header.version = SNAPSHOT_VERSION;
+  header.headerSize = SNAPSHOT_HEADER_SIZE;
+  header.dim = minefield->dim;
+  header.seed = int_seed;
+  header.count = minefield->count;
+  header.cellsOffset = SNAPSHOT_HEADER_SIZE;
+  header.cellsSize = cellBytes(minefield->dim);
+
+  /* Cells first, straight from the minefield, hashed while they are in cache */
+  bool_ok = true;
+  startChecksum(ptr_lanes);
+  for (size_offset = 0; (bool_ok) && (size_offset < header.cellsSize); size_offset += size_chunk) {
+    size_chunk = (header.cellsSize - size_offset < SNAPSHOT_CHUNK) ? header.cellsSize - size_offset : SNAPSHOT_CHUNK;
+    hashBytes(ptr_lanes, minefield->cells + size_offset, size_chunk);
+    bool_ok = writeAll(int_fd, minefield->cells + size_offset, size_chunk, header.cellsOffset + size_offset);
+  }
+  header.cellsChecksum = endChecksum(ptr_lanes);
+
+  /* Then the header, which needs the checksum of the cells */
+  encodeHeader(&header, ptr_bytes);
+  bool_ok = (bool_ok) && (writeAll(int_fd, ptr_bytes, SNAPSHOT_HEADER_SIZE, 0));
+  bool_ok = (bool_ok) && (fsync(int_fd) == 0);
+  bool_ok = (close(int_fd) == 0) && (bool_ok);
+  bool_ok = (bool_ok) && (rename(str_tmp, str_path) == 0);
+
+  if (bool_ok == false) {
+    fprintf(stderr, "Can't write the snapshot %s.\n", str_path);
+    unlink(str_tmp);
+  }
+  free(str_tmp);
+
+  return( (bool_ok) ? 0 : FILE_ERROR );
+}
+
+int loadSnapshot(board* minefield, uint64_t* ptr_seed, const char* str_path, boolean bool_verify)
+{
+  /* Variables */
+  snapshotHeader header;
+  struct stat file_stat;
+  uint8_t ptr_bytes[SNAPSHOT_HEADER_USED + 8];
+  uint8_t* ptr_mapping;
+  size_t size_mapping;
+  boolean bool_valid;
+  int int_fd;
+
+  int_fd = open(str_path, O_RDONLY);
+  if (int_fd < 0) {
+    fprintf(stderr, "Can't open the snapshot %s.\n", str_path);
+    return(FILE_ERROR);
+  }
+
+  /* Header */
+  if ( (fstat(int_fd, &file_stat) != 0) || (pread(int_fd, ptr_bytes, sizeof(ptr_bytes), 0) != (ssize_t)sizeof(ptr_bytes)) ||
+       (memcmp(ptr_bytes, SNAPSHOT_MAGIC, 8) != 0) ) {
+    fprintf(stderr, "%s is not a snapshot.\n", str_path);
+    close(int_fd);
+    return(FILE_ERROR);
+  }
+  bool_valid = decodeHeader(ptr_bytes, &header);
+  if ( (bool_valid) && (header.version != SNAPSHOT_VERSION) ) {
+    fprintf(stderr, "The snapshot %s has version %u, this program reads version %d.\n", str_path, header.version, SNAPSHOT_VERSION);
+    close(int_fd);
+    return(FILE_ERROR);
+  }
+
+  /* Sizes and counters that can't be those of a minefield */
+  bool_valid = (bool_valid) && (header.dim.width > 0) && (header.dim.height > 0);
+  bool_valid = (bool_valid) && (header.cellsSize == cellBytes(header.dim)) && (header.cellsOffset % SNAPSHOT_HEADER_SIZE == 0);
+  bool_valid = (bool_valid) && (header.cellsOffset >= SNAPSHOT_HEADER_SIZE);
+  bool_valid = (bool_valid) && ((uint64_t)file_stat.st_size >= header.cellsOffset + header.cellsSize);
+  bool_valid = (bool_valid) && (header.count.mines >= 0) && (header.count.mines <= cellCount(header.dim));
+  bool_valid = (bool_valid) && (header.count.hiddenSafe >= 0) && (header.count.hiddenSafe <= cellCount(header.dim) - header.count.mines);
+  if (bool_valid == false) {
+    fprintf(stderr, "The snapshot %s is corrupted.\n", str_path);
+    close(int_fd);
+    return(FILE_ERROR);
+  }
+
+  /* Cells, mapped from the file without reading them */
+  size_mapping = header.cellsOffset + header.cellsSize;
+  ptr_mapping = mmap(NULL, size_mapping, PROT_READ | PROT_WRITE, MAP_PRIVATE, int_fd, 0);
+  close(int_fd);
+  if (ptr_mapping == MAP_FAILED) {
+    fprintf(stderr, "Can't map the snapshot %s.\n", str_path);
+    return(FILE_ERROR);
+  }
+
+  if ( (bool_verify) && (checksum(ptr_mapping + header.cellsOffset, header.cellsSize) != header.cellsChecksum) ) {
+    fprintf(stderr, "The snapshot %s is corrupted.\n", str_path);
+    munmap(ptr_mapping, size_mapping);
+    return(FILE_ERROR);
+  }
+
+  attachMinefield(minefield, ptr_mapping + header.cellsOffset, header.dim);
+  minefield->count = header.count;
+  minefield->mapping = ptr_mapping;
+  minefield->mappingSize = size_mapping;
+  *ptr_seed = header.seed;
+
+  return(0);
+}
@@ -0,0 +1,409 @@
+/*!
+  \file solver.c
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \brief Solver
+  \remarks None
+
+  Plays a minefield using only what a player sees :
+  the numbers of the revealed cells and the flags.
+  The neighbourhoods are handled as 7x7 bit masks
+  centred on the cell being examined, so comparing
+  the hidden neighbours of two numbers is a few
+  bitwise operations.
+
+*/
+
+#include "solver.h"
+#include "minesweeper.h"
+#include "probability.h"
+
+
+
+/*!
+  \fn static void pushCell(solver* solv, int64_t int_index)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param solv The solver
+  \param int_index Index of the cell
+  \brief Adds a cell to the work queue unless it is already in it
+  \remarks None
+*/
+static void pushCell(solver* solv, int64_t int_index)
+{
+  /* Variables */
+  int64_t int_tail;
+  int64_t int_nCells;
+
+  if (solv->queued[int_index]) return;
+  solv->queued[int_index] = 1;
+
+  int_nCells = cellCount(solv->dim);
+  int_tail = solv->head + solv->length;
+  if (int_tail >= int_nCells) int_tail -= int_nCells;
+  solv->queue[int_tail] = int_index;
+  solv->length++;
+}
+
+/*!
+  \fn static int64_t popCell(solver* solv)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param solv The solver, with a cell in its queue
+  \return Index of the oldest cell of the queue
+  \brief Removes the oldest cell of the work queue
+  \remarks None
+*/
+static int64_t popCell(solver* solv)
+{
+  /* Variables */
+  int64_t int_index;
+
+  int_index = solv->queue[solv->head];
+  solv->queued[int_index] = 0;
+  solv->head++;
+  if (solv->head == cellCount(solv->dim)) solv->head = 0;
+  solv->length--;
+
+  return(int_index);
+}
+
+/*!
+  \fn static void absorbChanges(solver* solv, board* minefield)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param solv The solver
+  \param minefield The minefield
+  \brief Queues the revealed cells next to (or being) a cell of the dirty list
+  and clears the list
+  \remarks Every revealed cell is queued if the list overflowed
+*/
+static void absorbChanges(solver* solv, board* minefield)
+{
+  /* Variables */
+  int64_t i;
+  int64_t int_nCells;
+  int64_t int_index;
+  int int_x;
+  int int_y;
+  int int_dx;
+  int int_dy;
+
+  if ( (minefield->dirtyLimit == 0) || minefield->dirtyOverflow ) {
+    int_nCells = cellCount(minefield->dim);
+    for (i = 0; i < int_nCells; i++) {
+      if ((minefield->cells[i] & CELL_HIDDEN) == 0) pushCell(solv, i);
+    }
+    clearDirty(minefield);
+    return;
+  }
+
+  for (i = 0; i < minefield->dirtyCount; i++) {
+    int_index = minefield->dirty[i];
+    int_y = int_index / minefield->dim.width;
+    int_x = int_index - (int64_t)int_y * minefield->dim.width;
+
+    for (int_dy = -1; int_dy <= 1; int_dy++) {
+      if ( (int_y + int_dy < 0) || (int_y + int_dy >= minefield->dim.height) ) continue;
+      for (int_dx = -1; int_dx <= 1; int_dx++) {
+        if ( (int_x + int_dx < 0) || (int_x + int_dx >= minefield->dim.width) ) continue;
+        if ((CELL_AT(minefield, int_x + int_dx, int_y + int_dy) & CELL_HIDDEN) == 0) {
+          pushCell(solv, CELL_INDEX(minefield->dim, int_x + int_dx, int_y + int_dy));
+        }
+      }
+    }
+  }
+  clearDirty(minefield);
+}
+
+/*!
+  \fn static int unknownNeighbours(board* minefield, int int_x, int int_y, int int_cx, int int_cy, uint64_t* ptr_mask)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param minefield The minefield
+  \param int_x x coordinate of a revealed cell
+  \param int_y y coordinate of a revealed cell
+  \param int_cx x coordinate of the centre of the mask, at most 2 columns away
+  \param int_cy y coordinate of the centre of the mask, at most 2 rows away
+  \param ptr_mask Where to store the hidden neighbours without a flag, bit
+  7*(dy+3)+(dx+3) for the cell (cx+dx, cy+dy)
+  \return The amount of mines left among the unknown neighbours
+  \brief Reads the number of a revealed cell and its unknown neighbours
+  \remarks None
+*/
+static int unknownNeighbours(board* minefield, int int_x, int int_y, int int_cx, int int_cy, uint64_t* ptr_mask)
+{
+  /* Variables */
+  int int_dx;
+  int int_dy;
+  int int_mines;
+  cell cell_c;
+
+  *ptr_mask = 0;
+  int_mines = CELL_AT(minefield, int_x, int_y) & CELL_COUNT;
+  for (int_dy = -1; int_dy <= 1; int_dy++) {
+    if ( (int_y + int_dy < 0) || (int_y + int_dy >= minefield->dim.height) ) continue;
+    for (int_dx = -1; int_dx <= 1; int_dx++) {
+      if ( (int_x + int_dx < 0) || (int_x + int_dx >= minefield->dim.width) ) continue;
+      cell_c = CELL_AT(minefield, int_x + int_dx, int_y + int_dy);
+      if ((cell_c & CELL_HIDDEN) == 0) continue;
+      if (cell_c & CELL_FLAG) {
+        int_mines--;
+      } else {
+        *ptr_mask |= 1ULL << (7 * (int_y + int_dy - int_cy + 3) + (int_x + int_dx - int_cx + 3));
+      }
+    }
+  }
+
+  return(int_mines);
+}
+
+/*!
+  \fn static int64_t playMask(solver* solv, board* minefield, int int_cx, int int_cy, uint64_t int_mask, int int_action, int64_t* ptr_flags)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.2 - batches
+  \param solv The solver
+  \param minefield The minefield
+  \param int_cx x coordinate of the centre of the mask
+  \param int_cy y coordinate of the centre of the mask
+  \param int_mask Cells to click (see unknownNeighbours)
+  \param int_action 1 to reveal, 2 to flag
+  \param ptr_flags Where to add the amount of flags placed, may be NULL
+  \return The amount of moves played, -1 if a mine has been revealed
+  \brief Clicks every cell of a mask with one clickBatch
+  \remarks Cells already revealed by a previous click of the mask are rejected
+*/
+static int64_t playMask(solver* solv, board* minefield, int int_cx, int int_cy, uint64_t int_mask, int int_action, int64_t* ptr_flags)
+{
+  /* Variables */
+  boardMove moves[49];
+  batchResult batch;
+  int int_bit;
+  int64_t int_count;
+
+  int_count = 0;
+  while (int_mask != 0) {
+    int_bit = __builtin_ctzll(int_mask);
+    int_mask &= int_mask - 1;
+
+    moves[int_count].x = int_cx + int_bit % 7 - 3;
+    moves[int_count].y = int_cy + int_bit / 7 - 3;
+    moves[int_count].action = int_action;
+    int_count++;
+  }
+
+  clickBatch(minefield, moves, int_count, &batch);
+  if (batch.lost) return(-1);
+  if ( (int_action == 2) && (ptr_flags != NULL) ) *ptr_flags += batch.applied;
+  absorbChanges(solv, minefield);
+
+  return(batch.applied);
+}
+
+/*!
+  \fn static int64_t deduceCell(solver* solv, board* minefield, int64_t int_index, int64_t* ptr_flags)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param solv The solver
+  \param minefield The minefield
+  \param int_index Index of a revealed cell
+  \param ptr_flags Where to add the amount of flags placed, may be NULL
+  \return The amount of moves played, -1 if a mine has been revealed
+  \brief Plays what can be deduced from a number alone or along with one
+  of the numbers up to 2 cells away
+  \remarks Stops at the first deduction, the cell is queued again by the
+  changes it made
+*/
+static int64_t deduceCell(solver* solv, board* minefield, int64_t int_index, int64_t* ptr_flags)
+{
+  /* Variables */
+  int int_x;
+  int int_y;
+  int int_bx;
+  int int_by;
+  int int_needA;
+  int int_needB;
+  int int_low;
+  int int_high;
+  int int_sizeA;
+  int int_sizeB;
+  int int_sizeI;
+  uint64_t int_maskA;
+  uint64_t int_maskB;
+  uint64_t int_onlyA;
+  uint64_t int_onlyB;
+  uint64_t int_both;
+
+  int_y = int_index / minefield->dim.width;
+  int_x = int_index - (int64_t)int_y * minefield->dim.width;
+  int_needA = unknownNeighbours(minefield, int_x, int_y, int_x, int_y, &int_maskA);
+  if (int_maskA == 0) return(0);
+  int_sizeA = __builtin_popcountll(int_maskA);
+
+  /* Single cell rule */
+  if (int_needA == 0) return(playMask(solv, minefield, int_x, int_y, int_maskA, 1, ptr_flags));
+  if (int_needA == int_sizeA) return(playMask(solv, minefield, int_x, int_y, int_maskA, 2, ptr_flags));
+
+  /* Pair rule with every number sharing unknown neighbours */
+  for (int_by = int_y - 2; int_by <= int_y + 2; int_by++) {
+    if ( (int_by < 0) || (int_by >= minefield->dim.height) ) continue;
+    for (int_bx = int_x - 2; int_bx <= int_x + 2; int_bx++) {
+      if ( (int_bx < 0) || (int_bx >= minefield->dim.width) || ((int_bx == int_x) && (int_by == int_y)) ) continue;
+      if (CELL_AT(minefield, int_bx, int_by) & CELL_HIDDEN) continue;
+
+      int_needB = unknownNeighbours(minefield, int_bx, int_by, int_x, int_y, &int_maskB);
+      int_both = int_maskA & int_maskB;
+      if (int_both == 0) continue;
+
+      int_onlyA = int_maskA & ~int_both;
+      int_onlyB = int_maskB & ~int_both;
+      int_sizeI = __builtin_popcountll(int_both);
+      int_sizeA = __builtin_popcountll(int_onlyA);
+      int_sizeB = __builtin_popcountll(int_onlyB);
+
+      /* Bounds of the amount of mines in the shared cells */
+      int_low = 0;
+      if (int_needA - int_sizeA > int_low) int_low = int_needA - int_sizeA;
+      if (int_needB - int_sizeB > int_low) int_low = int_needB - int_sizeB;
+      int_high = int_sizeI;
+      if (int_needA < int_high) int_high = int_needA;
+      if (int_needB < int_high) int_high = int_needB;
+
+      /* The cells of one number only hold what the shared cells can't */
+      if (int_onlyB != 0) {
+        if (int_needB - int_high == int_sizeB) return(playMask(solv, minefield, int_x, int_y, int_onlyB, 2, ptr_flags));
+        if (int_needB - int_low == 0) return(playMask(solv, minefield, int_x, int_y, int_onlyB, 1, ptr_flags));
+      }
+      if (int_onlyA != 0) {
+        if (int_needA - int_high == int_sizeA) return(playMask(solv, minefield, int_x, int_y, int_onlyA, 2, ptr_flags));
+        if (int_needA - int_low == 0) return(playMask(solv, minefield, int_x, int_y, int_onlyA, 1, ptr_flags));
+      }
+    }
+  }
+
+  return(0);
+}
+
+void initSolver(solver* solv, dimensions dim_dimensions)
+{
+  /* Variables */
+  int64_t int_nCells;
+
+  int_nCells = cellCount(dim_dimensions);
+  solv->dim = dim_dimensions;
+  solv->queue = malloc(int_nCells * sizeof(int64_t));
+  solv->queued = calloc(int_nCells, 1);
+  solv->prob = malloc(int_nCells * sizeof(double));
+
+  /* Kill the program if allocation error */
+  if ( (solv->queue == NULL) || (solv->queued == NULL) || (solv->prob == NULL) ) {
+    fprintf(stderr, "Memory allocation error.\n");
+    exit(MEMORY_ALLOCATION_ERROR);
+  }
+
+  solv->head = 0;
+  solv->length = 0;
+}
+
+void freeSolver(solver* solv)
+{
+  free(solv->queue);
+  free(solv->queued);
+  free(solv->prob);
+  solv->queue = NULL;
+  solv->queued = NULL;
+  solv->prob = NULL;
+  solv->length = 0;
+}
+
+int64_t deduceMoves(solver* solv, board* minefield, int64_t* ptr_flags)
+{
+  /* Variables */
+  int64_t int_moves;
+  int64_t int_played;
+
+  absorbChanges(solv, minefield);
+
+  int_moves = 0;
+  while (solv->length > 0) {
+    int_played = deduceCell(solv, minefield, popCell(solv), ptr_flags);
+    if (int_played < 0) {
+      /* Leave the queue empty for the next game */
+      while (solv->length > 0) popCell(solv);
+      return(-1);
+    }
+    int_moves += int_played;
+  }
+
+  return(int_moves);
+}
+
+int64_t pickUnknownCell(board* minefield, rng* gen)
+{
+  /* Variables */
+  int i;
+  int64_t int_index;
+  int64_t int_nCells;
+
+  int_nCells = cellCount(minefield->dim);
+  for (i = 0; i < 64; i++) {
+    int_index = boundedRandom(gen, int_nCells);
+    if ((minefield->cells[int_index] & (CELL_HIDDEN | CELL_FLAG)) == CELL_HIDDEN) return(int_index);
+  }
+
+  /* Nearly everything is revealed or flagged */
+  while ((minefield->cells[int_index] & (CELL_HIDDEN | CELL_FLAG)) != CELL_HIDDEN) {
+    int_index++;
+    if (int_index == int_nCells) int_index = 0;
+  }
+
+  return(int_index);
+}
+
+void solveMinefield(solver* solv, board* minefield, int int_x, int int_y, rng* gen, solverResult* result)
+{
+  /* Variables */
+  int64_t int_played;
+  int64_t int_index;
+  int64_t int_flags;
+
+  result->won = false;
+  result->guesses = 0;
+  result->reveals = 1;
+  result->flags = 0;
+
+  /* Each click changes at most every cell once */
+  trackDirty(minefield, cellCount(minefield->dim));
+  if (click(minefield, int_x, int_y, 1) == 0) return;
+
+  for (;;) {
+    int_flags = result->flags;
+    int_played = deduceMoves(solv, minefield, &result->flags);
+    if (int_played < 0) return;
+    result->reveals += int_played - (result->flags - int_flags);
+
+    if (userHasWon(minefield)) {
+      result->won = true;
+      return;
+    }
+
+    /* Nothing more can be deduced by the rules, the safest cell may still be safe */
+    int_index = -1;
+    if (computeProbabilities(minefield, solv->prob, PROBABILITY_QUICK_BUDGET) == 0) int_index = safestCell(minefield, solv->prob);
+    if (int_index >= 0) {
+      if (solv->prob[int_index] > 0.0) result->guesses++;
+    } else {
+      int_index = pickUnknownCell(minefield, gen);
+      result->guesses++;
+    }
+    result->reveals++;
+    if (click(minefield, int_index % minefield->dim.width, int_index / minefield->dim.width, 1) == 0) return;
+  }
+}
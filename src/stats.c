@@ -0,0 +1,174 @@
+/*!
+  \file stats.c
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \brief Instrumentation of the engine
+  \remarks None
+
+  Log-bucketed latency histograms, and the
+  measurements of the engine printed by --stats :
+  latencies of the moves and of the frames, cells
+  visited and revealed, bytes rendered.
+
+*/
+
+#include "stats.h"
+
+/*! Measurements of the thread, NULL when they are not recorded */
+__thread engineStats* currentStats = NULL;
+
+#ifndef NO_STATS
+/*! Measurements of the thread that called startStats */
+static engineStats mainStats;
+#endif
+
+
+
+/*!
+  \fn static int latencyBucket(int64_t int_ns)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param int_ns Latency, in nanoseconds
+  \return Its bucket of the histogram
+  \brief Finds the bucket of a latency
+  \remarks Exact below 32 ns, then the power of two of the latency and
+  the 4 bits that follow its highest one
+*/
+static int latencyBucket(int64_t int_ns)
+{
+  /* Variables */
+  int int_exp;
+
+  if (int_ns < 32) return( (int_ns < 0) ? 0 : (int)int_ns );
+  int_exp = 63 - __builtin_clzll((uint64_t)int_ns);
+  if (int_exp > 41) return(STATS_BUCKETS - 1);
+
+  return(32 + (int_exp - 5) * 16 + (int)(((uint64_t)int_ns >> (int_exp - 4)) & 15));
+}
+
+/*!
+  \fn static int64_t bucketLatency(int int_bucket)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param int_bucket Bucket of the histogram
+  \return The lowest latency of the bucket, in nanoseconds
+  \brief Inverse of latencyBucket
+  \remarks None
+*/
+static int64_t bucketLatency(int int_bucket)
+{
+  if (int_bucket < 32) return(int_bucket);
+
+  return( (int64_t)(16 + (int_bucket - 32) % 16) << ( (int_bucket - 32) / 16 + 1 ) );
+}
+
+void recordLatency(latencyHistogram* hist, int64_t int_ns)
+{
+  hist->buckets[latencyBucket(int_ns)]++;
+  hist->count++;
+  hist->totalNs += int_ns;
+  if (int_ns > hist->maxNs) hist->maxNs = int_ns;
+}
+
+void mergeHistogram(latencyHistogram* hist, const latencyHistogram* other)
+{
+  /* Variables */
+  int i;
+
+  for (i = 0; i < STATS_BUCKETS; i++) hist->buckets[i] += other->buckets[i];
+  hist->count += other->count;
+  hist->totalNs += other->totalNs;
+  if (other->maxNs > hist->maxNs) hist->maxNs = other->maxNs;
+}
+
+int64_t latencyPercentile(const latencyHistogram* hist, double int_quantile)
+{
+  /* Variables */
+  int64_t int_rank;
+  int64_t int_seen;
+  int i;
+
+  if (hist->count == 0) return(0);
+  int_rank = (int64_t)(int_quantile * hist->count);
+  if (int_rank >= hist->count) int_rank = hist->count - 1;
+
+  int_seen = 0;
+  for (i = 0; i < STATS_BUCKETS - 1; i++) {
+    int_seen += hist->buckets[i];
+    if (int_seen > int_rank) return(bucketLatency(i));
+  }
+
+  return(hist->maxNs);
+}
+
+void recordFrame(int64_t int_bytes, int64_t int_start)
+{
+  /* Variables */
+  int64_t int_now;
+
+  int_now = nowNs();
+  currentStats->frames++;
+  currentStats->bytesRendered += int_bytes;
+  recordLatency(&currentStats->frame, int_now - int_start);
+  if (currentStats->moveStart != 0) {
+    recordLatency(&currentStats->moveToFrame, int_now - currentStats->moveStart);
+    currentStats->moveStart = 0;
+  }
+}
+
+#ifndef NO_STATS
+/*!
+  \fn static void printHistogram(const char* str_name, const latencyHistogram* hist)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param str_name Key of the histogram
+  \param hist The histogram
+  \brief Prints a histogram as a member of a JSON object on stderr
+  \remarks Preceded by a comma
+*/
+static void printHistogram(const char* str_name, const latencyHistogram* hist)
+{
+  fprintf(stderr, ",\"%s\":{\"count\":%lld,\"mean_ns\":%lld,\"p50_ns\":%lld,\"p99_ns\":%lld,\"p999_ns\":%lld,\"max_ns\":%lld}",
+          str_name, (long long)hist->count, (long long)((hist->count > 0) ? hist->totalNs / hist->count : 0),
+          (long long)latencyPercentile(hist, 0.5), (long long)latencyPercentile(hist, 0.99),
+          (long long)latencyPercentile(hist, 0.999), (long long)hist->maxNs);
+}
+
+/*!
+  \fn static void printStats(void)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \brief Prints the measurements of startStats as a line of JSON on stderr
+  \remarks Registered with atexit
+*/
+static void printStats(void)
+{
+  fflush(stdout);
+  fprintf(stderr, "{\"mode\":\"stats\",\"cells_visited\":%lld,\"cells_revealed\":%lld,\"frames\":%lld,\"bytes_rendered\":%lld",
+          (long long)mainStats.cellsVisited, (long long)mainStats.cellsRevealed,
+          (long long)mainStats.frames, (long long)mainStats.bytesRendered);
+  printHistogram("click", &mainStats.click);
+  printHistogram("click_batch", &mainStats.clickBatch);
+  printHistogram("reveal", &mainStats.reveal);
+  printHistogram("user_has_won", &mainStats.userHasWon);
+  printHistogram("count_flags", &mainStats.countFlags);
+  printHistogram("frame", &mainStats.frame);
+  printHistogram("move_to_frame", &mainStats.moveToFrame);
+  fprintf(stderr, "}\n");
+}
+#endif
+
+void startStats(void)
+{
+#ifdef NO_STATS
+  fprintf(stderr, "Statistics are not compiled in (make STATS=1).\n");
+#else
+  currentStats = &mainStats;
+  atexit(printStats);
+#endif
+}
@@ -0,0 +1,589 @@
+/*!
+  \file undo.c
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \brief Undo and redo
+  \remarks None
+
+  Keeps, for every click, only the cells it changed,
+  so that it can be undone and redone without a copy
+  of the minefield and without a new flood fill. Part
+  of the library : nothing is printed and errors are
+  returned.
+
+*/
+
+#include "undo.h"
+
+
+
+/*!
+  \fn static inline size_t putNumber(uint8_t* ptr_out, uint64_t int_value)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param ptr_out Where to write the number
+  \param int_value The number
+  \return The bytes written
+  \brief Writes a number 7 bits per byte, the high bit set on every byte
+  but the last
+  \remarks None
+*/
+static inline size_t putNumber(uint8_t* ptr_out, uint64_t int_value)
+{
+  /* Variables */
+  size_t size_bytes;
+
+  size_bytes = 0;
+  while (int_value >= 0x80) {
+    ptr_out[size_bytes++] = (uint8_t)(int_value | 0x80);
+    int_value >>= 7;
+  }
+  ptr_out[size_bytes++] = (uint8_t)int_value;
+
+  return(size_bytes);
+}
+
+/*!
+  \fn static inline size_t numberBytes(uint64_t int_value)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param int_value The number
+  \return The bytes putNumber writes for it
+  \brief Measures a number
+  \remarks None
+*/
+static inline size_t numberBytes(uint64_t int_value)
+{
+  /* Variables */
+  size_t size_bytes;
+
+  size_bytes = 1;
+  while (int_value >= 0x80) {
+    int_value >>= 7;
+    size_bytes++;
+  }
+
+  return(size_bytes);
+}
+
+/*!
+  \fn static inline uint64_t getNumber(const uint8_t* ptr_data, size_t* ptr_offset)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param ptr_data The records
+  \param ptr_offset Offset of the number, moved after it
+  \return The number
+  \brief Reads a number written by putNumber
+  \remarks The records are trusted, they never leave the history
+*/
+static inline uint64_t getNumber(const uint8_t* ptr_data, size_t* ptr_offset)
+{
+  /* Variables */
+  uint64_t int_value;
+  int int_shift;
+
+  int_value = 0;
+  int_shift = 0;
+  while (ptr_data[*ptr_offset] & 0x80) {
+    int_value |= (uint64_t)(ptr_data[(*ptr_offset)++] & 0x7F) << int_shift;
+    int_shift += 7;
+  }
+  int_value |= (uint64_t)ptr_data[(*ptr_offset)++] << int_shift;
+
+  return(int_value);
+}
+
+/*!
+  \fn static void* growArray(void* ptr_array, int64_t* ptr_size, int64_t int_needed, size_t size_item)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param ptr_array The array, may be NULL
+  \param ptr_size Its capacity, updated
+  \param int_needed Items it must hold
+  \param size_item Bytes of an item
+  \return The array, NULL on allocation error (the array is then left alone)
+  \brief Doubles the capacity of an array until it holds int_needed items
+  \remarks None
+*/
+static void* growArray(void* ptr_array, int64_t* ptr_size, int64_t int_needed, size_t size_item)
+{
+  /* Variables */
+  int64_t int_size;
+  void* ptr_new;
+
+  if (int_needed <= *ptr_size) return(ptr_array);
+  int_size = (*ptr_size < 256) ? 256 : *ptr_size;
+  while (int_size < int_needed) int_size *= 2;
+  ptr_new = realloc(ptr_array, (size_t)int_size * size_item);
+  if (ptr_new == NULL) return(NULL);
+  *ptr_size = int_size;
+
+  return(ptr_new);
+}
+
+/*!
+  \fn static int compareIndices(const void* ptr_a, const void* ptr_b)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param ptr_a A cell index
+  \param ptr_b Another cell index
+  \return Their order, for qsort
+  \brief Compares two cell indices
+  \remarks None
+*/
+static int compareIndices(const void* ptr_a, const void* ptr_b)
+{
+  /* Variables */
+  int64_t int_a;
+  int64_t int_b;
+
+  int_a = *(const int64_t*)ptr_a;
+  int_b = *(const int64_t*)ptr_b;
+
+  return( (int_a > int_b) - (int_a < int_b) );
+}
+
+/*!
+  \fn static inline int64_t extendRuns(int64_t* ptr_runs, int64_t int_runs, int64_t int_index)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param ptr_runs First index and length of each run
+  \param int_runs Amount of runs
+  \param int_index Next cell, above the cells of the runs
+  \return The new amount of runs
+  \brief Adds a cell to the last run, or starts a new one with it
+  \remarks None
+*/
+static inline int64_t extendRuns(int64_t* ptr_runs, int64_t int_runs, int64_t int_index)
+{
+  if ( (int_runs > 0) && (ptr_runs[2 * int_runs - 2] + ptr_runs[2 * int_runs - 1] == int_index) ) {
+    ptr_runs[2 * int_runs - 1]++;
+    return(int_runs);
+  }
+  ptr_runs[2 * int_runs] = int_index;
+  ptr_runs[2 * int_runs + 1] = 1;
+
+  return(int_runs + 1);
+}
+
+/*!
+  \fn static int64_t buildRuns(undoLog* undo, int64_t int_min, int64_t int_max, boolean* ptr_dense)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param undo The history, with the cells of the move
+  \param int_min Lowest index of the cells
+  \param int_max Highest index of the cells
+  \param ptr_dense Where to store true if the bitmap of the cells was built
+  \return The amount of runs, -1 on allocation error
+  \brief Sorts the cells of the move into runs of consecutive indices
+  \remarks When the bitmap from int_min to int_max has no more words than
+  there are cells, the cells are sorted through it, otherwise with qsort
+*/
+static int64_t buildRuns(undoLog* undo, int64_t int_min, int64_t int_max, boolean* ptr_dense)
+{
+  /* Variables */
+  void* ptr_new;
+  uint64_t int_word;
+  int64_t int_words;
+  int64_t int_runs;
+  int64_t i;
+
+  ptr_new = growArray(undo->runs, &undo->runsSize, 2 * undo->nCells, sizeof(int64_t));
+  if (ptr_new == NULL) return(-1);
+  undo->runs = ptr_new;
+
+  int_runs = 0;
+  int_words = (int_max - int_min) / 64 + 1;
+  *ptr_dense = (int_words <= undo->nCells);
+  if (*ptr_dense == false) {
+    qsort(undo->cells, undo->nCells, sizeof(int64_t), compareIndices);
+    for (i = 0; i < undo->nCells; i++) int_runs = extendRuns(undo->runs, int_runs, undo->cells[i]);
+    return(int_runs);
+  }
+
+  ptr_new = growArray(undo->bits, &undo->bitsSize, int_words, sizeof(uint64_t));
+  if (ptr_new == NULL) return(-1);
+  undo->bits = ptr_new;
+  memset(undo->bits, 0, (size_t)int_words * sizeof(uint64_t));
+  for (i = 0; i < undo->nCells; i++) undo->bits[(undo->cells[i] - int_min) >> 6] |= 1ULL << ((undo->cells[i] - int_min) & 63);
+
+  for (i = 0; i < int_words; i++) {
+    int_word = undo->bits[i];
+    while (int_word != 0) {
+      int_runs = extendRuns(undo->runs, int_runs, int_min + 64 * i + __builtin_ctzll(int_word));
+      int_word &= int_word - 1;
+    }
+  }
+
+  return(int_runs);
+}
+
+/*!
+  \fn static boolean reserveBytes(undoLog* undo, size_t size_bytes)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param undo The history
+  \param size_bytes Bytes about to be appended to the records
+  \return false on allocation error
+  \brief Makes room at the end of the records
+  \remarks None
+*/
+static boolean reserveBytes(undoLog* undo, size_t size_bytes)
+{
+  /* Variables */
+  size_t size_new;
+  uint8_t* ptr_new;
+
+  if (undo->used + size_bytes <= undo->size) return(true);
+  size_new = (undo->size < 4096) ? 4096 : undo->size;
+  while (size_new < undo->used + size_bytes) size_new *= 2;
+  ptr_new = realloc(undo->bytes, size_new);
+  if (ptr_new == NULL) return(false);
+  undo->bytes = ptr_new;
+  undo->size = size_new;
+
+  return(true);
+}
+
+/*!
+  \fn static boolean appendCells(undoLog* undo)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param undo The history, with the cells of the move
+  \return false on allocation error
+  \brief Appends the cells revealed by the move to the records : their
+  amount, the encoding, the lowest index, then the runs or the bitmap,
+  whichever is smaller, then the cells that had a flag
+  \remarks A run is the gap from the end of the previous one and its
+  length minus one. The bitmap has one bit per cell from the lowest index
+  to the highest one
+*/
+static boolean appendCells(undoLog* undo)
+{
+  /* Variables */
+  boolean bool_dense;
+  boolean bool_bitmap;
+  uint8_t* ptr_out;
+  int64_t int_min;
+  int64_t int_max;
+  int64_t int_runs;
+  int64_t int_end;
+  int64_t i;
+  size_t size_runs;
+  size_t size_bitmap;
+  size_t size_bytes;
+
+  /* A reveal always reveals the clicked cell, but nothing is assumed */
+  if (undo->nCells == 0) {
+    if (reserveBytes(undo, 1) == false) return(false);
+    undo->bytes[undo->used++] = 0;
+    return(true);
+  }
+
+  int_min = undo->cells[0];
+  int_max = undo->cells[0];
+  for (i = 1; i < undo->nCells; i++) {
+    if (undo->cells[i] < int_min) int_min = undo->cells[i];
+    if (undo->cells[i] > int_max) int_max = undo->cells[i];
+  }
+  int_runs = buildRuns(undo, int_min, int_max, &bool_dense);
+  if (int_runs < 0) return(false);
+
+  /* Sizes of both encodings, the bitmap only exists for dense cells */
+  size_runs = numberBytes(int_runs);
+  int_end = int_min;
+  for (i = 0; i < int_runs; i++) {
+    size_runs += numberBytes(undo->runs[2 * i] - int_end) + numberBytes(undo->runs[2 * i + 1] - 1);
+    int_end = undo->runs[2 * i] + undo->runs[2 * i + 1];
+  }
+  size_bitmap = (size_t)((int_max - int_min) / 8 + 1);
+  bool_bitmap = (bool_dense) && (numberBytes(size_bitmap) + size_bitmap < size_runs);
+
+  size_bytes = numberBytes(undo->nCells) + 1 + numberBytes(int_min) +
+               ( (bool_bitmap) ? numberBytes(size_bitmap) + size_bitmap : size_runs ) + numberBytes(undo->nFlagged);
+  for (i = 0; i < undo->nFlagged; i++) size_bytes += numberBytes(undo->flagged[i]);
+  if (reserveBytes(undo, size_bytes) == false) return(false);
+
+  ptr_out = undo->bytes + undo->used;
+  ptr_out += putNumber(ptr_out, undo->nCells);
+  *ptr_out++ = (bool_bitmap) ? UNDO_BITMAP : UNDO_RUNS;
+  ptr_out += putNumber(ptr_out, int_min);
+  if (bool_bitmap) {
+    ptr_out += putNumber(ptr_out, size_bitmap);
+    for (i = 0; i < (int64_t)size_bitmap; i++) *ptr_out++ = (uint8_t)(undo->bits[i >> 3] >> (8 * (i & 7)));
+  } else {
+    ptr_out += putNumber(ptr_out, int_runs);
+    int_end = int_min;
+    for (i = 0; i < int_runs; i++) {
+      ptr_out += putNumber(ptr_out, undo->runs[2 * i] - int_end);
+      ptr_out += putNumber(ptr_out, undo->runs[2 * i + 1] - 1);
+      int_end = undo->runs[2 * i] + undo->runs[2 * i + 1];
+    }
+  }
+  ptr_out += putNumber(ptr_out, undo->nFlagged);
+  for (i = 0; i < undo->nFlagged; i++) ptr_out += putNumber(ptr_out, undo->flagged[i]);
+  undo->used += size_bytes;
+
+  return(true);
+}
+
+/*!
+  \fn static inline void changeCell(board* minefield, int64_t int_index, boolean bool_hide)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param minefield The minefield
+  \param int_index Index of a cell revealed by a click
+  \param bool_hide true to hide it again, false to reveal it again
+  \brief Hides or reveals a cell and updates the counters like reveal
+  \remarks The flag of the cell goes with it when it is revealed again
+*/
+static inline void changeCell(board* minefield, int64_t int_index, boolean bool_hide)
+{
+  if (bool_hide) {
+    minefield->cells[int_index] |= CELL_HIDDEN;
+    minefield->count.hiddenSafe++;
+  } else {
+    if (minefield->cells[int_index] & CELL_FLAG) minefield->count.flags--;
+    minefield->cells[int_index] &= ~(CELL_HIDDEN | CELL_FLAG);
+    minefield->count.hiddenSafe--;
+  }
+  markDirty(minefield, int_index);
+}
+
+/*!
+  \fn static void restoreCells(undoLog* undo, board* minefield, size_t size_offset, boolean bool_hide)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param undo The history
+  \param minefield The minefield
+  \param size_offset Offset of the cells of a reveal (see appendCells)
+  \param bool_hide true to hide them again, false to reveal them again
+  \brief Undoes or redoes a reveal
+  \remarks The flags removed by the reveal are put back when undoing it
+*/
+static void restoreCells(undoLog* undo, board* minefield, size_t size_offset, boolean bool_hide)
+{
+  /* Variables */
+  int64_t int_index;
+  int64_t int_runs;
+  int64_t int_length;
+  int64_t int_flagged;
+  int64_t i;
+  int64_t j;
+  size_t size_bitmap;
+  int int_encoding;
+  unsigned int int_byte;
+
+  if (getNumber(undo->bytes, &size_offset) == 0) return;
+  int_encoding = undo->bytes[size_offset++];
+  int_index = getNumber(undo->bytes, &size_offset);
+  if (int_encoding == UNDO_BITMAP) {
+    size_bitmap = getNumber(undo->bytes, &size_offset);
+    for (i = 0; i < (int64_t)size_bitmap; i++) {
+      int_byte = undo->bytes[size_offset++];
+      while (int_byte != 0) {
+        changeCell(minefield, int_index + 8 * i + __builtin_ctz(int_byte), bool_hide);
+        int_byte &= int_byte - 1;
+      }
+    }
+  } else {
+    int_runs = getNumber(undo->bytes, &size_offset);
+    for (i = 0; i < int_runs; i++) {
+      int_index += getNumber(undo->bytes, &size_offset);
+      int_length = getNumber(undo->bytes, &size_offset) + 1;
+      for (j = 0; j < int_length; j++) changeCell(minefield, int_index + j, bool_hide);
+      int_index += int_length;
+    }
+  }
+
+  /* Revealing again removes the flags by itself */
+  int_flagged = getNumber(undo->bytes, &size_offset);
+  for (i = 0; (bool_hide) && (i < int_flagged); i++) {
+    int_index = getNumber(undo->bytes, &size_offset);
+    minefield->cells[int_index] |= CELL_FLAG;
+    minefield->count.flags++;
+  }
+}
+
+/*!
+  \fn static void toggleFlag(board* minefield, int64_t int_index)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param minefield The minefield
+  \param int_index Index of a hidden cell
+  \brief Puts or removes a flag and updates the counters like click
+  \remarks A mark undone is the same mark again
+*/
+static void toggleFlag(board* minefield, int64_t int_index)
+{
+  /* Variables */
+  int int_delta;
+
+  minefield->cells[int_index] ^= CELL_FLAG;
+  int_delta = (minefield->cells[int_index] & CELL_FLAG) ? 1 : -1;
+  minefield->count.flags += int_delta;
+  if (minefield->cells[int_index] & CELL_MINE) {
+    minefield->count.validFlags  += int_delta;
+    minefield->count.hiddenMines -= int_delta;
+  }
+  markDirty(minefield, int_index);
+}
+
+/*!
+  \fn static int replayRecord(undoLog* undo, board* minefield, int64_t int_move, boolean bool_undo)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param undo The history
+  \param minefield The minefield
+  \param int_move The move
+  \param bool_undo true to undo it, false to redo it
+  \return The result of the move, 1 or 0 if it revealed a mine
+  \brief Undoes or redoes a move of the history
+  \remarks A record starts with the index of the clicked cell, the action
+  and the result. A mine is followed by 1 if the click set it off, 0 if it
+  already was
+*/
+static int replayRecord(undoLog* undo, board* minefield, int64_t int_move, boolean bool_undo)
+{
+  /* Variables */
+  uint64_t int_header;
+  int64_t int_index;
+  size_t size_offset;
+  int int_action;
+  int int_result;
+
+  size_offset = undo->offsets[int_move];
+  int_header = getNumber(undo->bytes, &size_offset);
+  int_index = (int64_t)(int_header >> 2);
+  int_action = (int)((int_header >> 1) & 1) + 1;
+  int_result = (int)(int_header & 1);
+
+  if (int_action == 2) {
+    toggleFlag(minefield, int_index);
+  } else if (int_result == 0) {
+    /* The mine may have been clicked before */
+    if (getNumber(undo->bytes, &size_offset) == 0) return(int_result);
+    if (bool_undo) {
+      minefield->cells[int_index] &= ~CELL_BOMB;
+    } else {
+      minefield->cells[int_index] |= CELL_BOMB;
+    }
+    markDirty(minefield, int_index);
+  } else {
+    restoreCells(undo, minefield, size_offset, bool_undo);
+  }
+
+  return(int_result);
+}
+
+void initUndo(undoLog* undo, board* minefield)
+{
+  memset(undo, 0, sizeof(undoLog));
+  minefield->undo = undo;
+}
+
+void freeUndo(undoLog* undo, board* minefield)
+{
+  free(undo->bytes);
+  free(undo->offsets);
+  free(undo->cells);
+  free(undo->flagged);
+  free(undo->runs);
+  free(undo->bits);
+  memset(undo, 0, sizeof(undoLog));
+  minefield->undo = NULL;
+}
+
+void beginUndoMove(undoLog* undo)
+{
+  undo->nCells = 0;
+  undo->nFlagged = 0;
+  undo->failed = false;
+}
+
+void recordUndoCell(undoLog* undo, int64_t int_index, boolean bool_flag)
+{
+  /* Variables */
+  void* ptr_new;
+
+  ptr_new = growArray(undo->cells, &undo->cellsSize, undo->nCells + 1, sizeof(int64_t));
+  if (ptr_new == NULL) {
+    undo->failed = true;
+    return;
+  }
+  undo->cells = ptr_new;
+  undo->cells[undo->nCells++] = int_index;
+  if (bool_flag == false) return;
+
+  ptr_new = growArray(undo->flagged, &undo->flaggedSize, undo->nFlagged + 1, sizeof(int64_t));
+  if (ptr_new == NULL) {
+    undo->failed = true;
+    return;
+  }
+  undo->flagged = ptr_new;
+  undo->flagged[undo->nFlagged++] = int_index;
+}
+
+void endUndoMove(undoLog* undo, int64_t int_index, int int_action, int int_result)
+{
+  /* Variables */
+  void* ptr_new;
+  size_t size_start;
+
+  /* Nothing changed */
+  if (int_result == -1) return;
+
+  /* The moves undone can't be redone after a new one */
+  if (undo->position < undo->moves) undo->used = undo->offsets[undo->position];
+  undo->moves = undo->position;
+  size_start = undo->used;
+
+  ptr_new = growArray(undo->offsets, &undo->offsetsSize, undo->moves + 1, sizeof(size_t));
+  if ( (ptr_new != NULL) && (undo->failed == false) && (reserveBytes(undo, 11)) ) {
+    undo->offsets = ptr_new;
+    undo->used += putNumber(undo->bytes + undo->used, ((uint64_t)int_index << 2) | ((uint64_t)(int_action - 1) << 1) | (uint64_t)int_result);
+    if (int_result == 0) undo->bytes[undo->used++] = (uint8_t)undo->nCells;
+    if ( (int_action == 2) || (int_result == 0) || (appendCells(undo)) ) {
+      undo->offsets[undo->moves++] = size_start;
+      undo->position = undo->moves;
+      return;
+    }
+  } else if (ptr_new != NULL) {
+    undo->offsets = ptr_new;
+  }
+
+  /* Without the cells of this move, the moves before can't be undone */
+  undo->used = 0;
+  undo->moves = 0;
+  undo->position = 0;
+}
+
+int undoMove(undoLog* undo, board* minefield)
+{
+  if (undo->position == 0) return(-1);
+  undo->position--;
+
+  return(replayRecord(undo, minefield, undo->position, true));
+}
+
+int redoMove(undoLog* undo, board* minefield)
+{
+  if (undo->position == undo->moves) return(-1);
+  undo->position++;
+
+  return(replayRecord(undo, minefield, undo->position - 1, false));
+}
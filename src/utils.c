@@ -8,171 +8,153 @@
 
   This file stores general utility methods
   as well as custom types for the project.
+  Part of the library : nothing is printed
+  and errors are returned, see console.c.
 
 */
 
 #include "utils.h"
+#include "stats.h"
 
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
 
 
-/*!
-  \fn void display(char char_c)
-  \author L.Draescher <draescherl@eisti.eu>
-  \date 19/12/2020
-  \version 0.1 - first draft
-  \param char_c The character in the toDisplay property of a cell
-  \brief Apply fancy display to character using unicode
-  \remarks None
-*/
-void display(char char_c)
-{
-  switch (char_c) {
-  case 'f' : /* Cell has a flag */
-    printf(RED " \u2690 " reset "|");
-    break;
-
-  case 'h' : /* Cell is hidden */
-    printf(" \u23F9 |");
-    break;
-
-  case 'b' : /* Cell has a bomb */
-    printf(RED " X " reset "|");
-    break;
-
-  case 'd' : /* Cell is displayed and has no adjacent mines */
-    printf("   |");
-    break;
-
-  case '1' :
-    printf(GREEN " %c " reset "|", char_c);
-    break;
-
-  case '2' :
-    printf(CYAN " %c " reset "|", char_c);
-    break;
-
-  case '3' :
-    printf(BLUE " %c " reset "|", char_c);
-    break;
-
-  case '4' :
-    printf(YELLOW " %c " reset "|", char_c);
-    break;
-
-  case '5' :
-  case '6' :
-  case '7' :
-  case '8' :
-    printf(RED " %c " reset "|", char_c);
-    break;
-  
-  default: /* Failsafe */
-    printf(" %c |", char_c);
-    break;
-  }
-}
 
-void printMinefield(cell** minefield, dimensions dim_dimensions)
+int newMinefield(board* minefield, dimensions dim_dimensions)
 {
   /* Variables */
-  int i;
-  int j;
-  int k;
-
-  /* Line of numbers */
-  printf("    ");
-  for (i = 0; i < dim_dimensions.width; i++) {
-    if (i < 10) printf(" ");
-    printf(" %d ", i);
+  void* ptr_cells;
+
+  if (posix_memalign(&ptr_cells, CELL_ALIGNMENT, cellBytes(dim_dimensions)) != 0) {
+    minefield->cells = NULL;
+    return(MEMORY_ALLOCATION_ERROR);
   }
+  attachMinefield(minefield, ptr_cells, dim_dimensions);
 
-  /* Arrow after x axis */
-  printf("   \u2190 x \n");
+  return(0);
+}
 
-  /* Separation line */
-  printf("    ");
-  for (i = 0; i < dim_dimensions.width; i++) printf("+---");
-  printf("+\n");
+void attachMinefield(board* minefield, cell* ptr_cells, dimensions dim_dimensions)
+{
+  minefield->cells = ptr_cells;
+  minefield->dim = dim_dimensions;
+  memset(&minefield->count, 0, sizeof(counters));
+  minefield->count.hiddenSafe = cellCount(dim_dimensions);
+
+  /* The flood fill allocates its work buffer on first use */
+  minefield->queue = NULL;
+  minefield->queueSize = 0;
+
+  /* Changes are not tracked by default */
+  minefield->dirty = NULL;
+  minefield->dirtyCount = 0;
+  minefield->dirtySize = 0;
+  minefield->dirtyLimit = 0;
+  minefield->dirtyOverflow = false;
+  minefield->dirtyEpoch = 0;
+
+  /* The cells belong to the minefield */
+  minefield->mapping = NULL;
+  minefield->mappingSize = 0;
+  minefield->arena = NULL;
+
+  /* Clicks are not recorded by default */
+  minefield->journal = NULL;
+  minefield->onClick = NULL;
+  minefield->undo = NULL;
+}
 
-  /* Display minefield */
-  for (i = 0; i < dim_dimensions.height; i++) {
-    /* Numbers */
-    if (i < 10) printf(" ");
-    printf(" %d |", i);
+void freeMinefield(board* minefield)
+{
+  /* Variables */
+  void* ptr_arena;
+
+  /* The cells and the work buffers of an arena are part of it */
+  ptr_arena = minefield->arena;
+  if (ptr_arena == NULL) {
+    if (minefield->mapping != NULL) {
+      munmap(minefield->mapping, minefield->mappingSize);
+    } else {
+      free(minefield->cells);
+    }
+    free(minefield->queue);
+    free(minefield->dirty);
+  }
+  minefield->cells = NULL;
+  minefield->arena = NULL;
+  minefield->mapping = NULL;
+  minefield->mappingSize = 0;
+  minefield->queue = NULL;
+  minefield->queueSize = 0;
+  minefield->dirty = NULL;
+  minefield->dirtySize = 0;
+  minefield->dirtyLimit = 0;
+
+  /* Last, the minefield may be in its own arena (see takeMinefield) */
+  free(ptr_arena);
+}
 
-    /* Values */
-    for (j = 0; j < dim_dimensions.width; j++) display(minefield[j][i].toDisplay);
-    printf("\n");
+void resetMinefield(board* minefield)
+{
+  memset(minefield->cells, CELL_HIDDEN, cellBytes(minefield->dim));
+  memset(&minefield->count, 0, sizeof(counters));
+  minefield->count.hiddenSafe = cellCount(minefield->dim);
+  clearDirty(minefield);
+}
 
-    /* Separation line */
-    printf("    ");
-    for (k = 0; k < dim_dimensions.width; k++) printf("+---");
-    printf("+\n");
-  }
+void trackDirty(board* minefield, int64_t int_limit)
+{
+  minefield->dirtyLimit = int_limit;
+  clearDirty(minefield);
+}
 
-  /* Arrow below y axis */
-  printf("  \u2191 \n  y \n\n");
+void clearDirty(board* minefield)
+{
+  minefield->dirtyCount = 0;
+  minefield->dirtyOverflow = false;
+  minefield->dirtyEpoch++;
 }
 
-void initMinefield(cell** minefield, dimensions dim_dimensions)
+boolean growDirty(board* minefield)
 {
   /* Variables */
-  int i;
-  int j;
+  int64_t int_newSize;
+  int64_t* ptr_dirty;
 
-  for (i = 0; i < dim_dimensions.width; i++) {
-    /* Create second dimension */
-    minefield[i] = malloc(dim_dimensions.height * sizeof(cell));
+  if (minefield->arena != NULL) return(false);
+  int_newSize = (minefield->dirtySize == 0) ? 256 : 2 * minefield->dirtySize;
+  if (int_newSize > minefield->dirtyLimit) int_newSize = minefield->dirtyLimit;
+  ptr_dirty = realloc(minefield->dirty, int_newSize * sizeof(int64_t));
 
-    /* Kill the program if allocation error */
-    if (minefield[i] == NULL) {
-      fprintf(stderr, "Memory allocation error.\n");
-      exit(MEMORY_ALLOCATION_ERROR);
-    }
+  /* The caller gives up on the list */
+  if (ptr_dirty == NULL) return(false);
 
-    /* Init all attributes of all cells */
-    for (j = 0; j < dim_dimensions.height; j++) {
-      minefield[i][j].hasMine  = false;
-      minefield[i][j].isHidden = true;
-      minefield[i][j].hasFlag  = false;
-      minefield[i][j].surroundingMines = 0;
-      minefield[i][j].toDisplay = 'h';
-    }
-  }
+  minefield->dirty = ptr_dirty;
+  minefield->dirtySize = int_newSize;
+
+  return(true);
 }
 
-int intInput(void)
+int64_t nowNs(void)
 {
   /* Variables */
-  int int_input;
-  int int_correct;
-  int int_c;
-
-  int_correct = scanf("%d", &int_input);
-  if (int_correct == 0) {
-    fprintf(stderr, "The value is not an int.\n");
-    exit(INT_INPUT_ERROR);
-  }
+  struct timespec time_now;
 
-  /* Empty buffer */
-  while ( ((int_c = getchar()) != '\n') && (int_c != EOF) ) { }
+  clock_gettime(CLOCK_MONOTONIC, &time_now);
 
-  return (int_input);
+  return((int64_t)time_now.tv_sec * 1000000000 + time_now.tv_nsec);
 }
 
-int countFlags(cell** minefield, dimensions dim_dimensions)
+int64_t countFlags(board* minefield)
 {
   /* Variables */
-  int i;
-  int j;
-  int int_nFlags;
-
-  int_nFlags = 0;
-  for (i = 0; i < dim_dimensions.width; i++) {
-    for (j = 0; j < dim_dimensions.height; j++) {
-      if (minefield[i][j].hasFlag) int_nFlags++;
-    }
-  }
+  int64_t int_flags;
+  STATS_CLOCK(int_start)
+
+  int_flags = minefield->count.flags;
+  STATS_LATENCY(countFlags, int_start);
 
-  return(int_nFlags);
+  return(int_flags);
 }
\ No newline at end of file
@@ -0,0 +1,738 @@
+/*!
+  \file world.c
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \brief Infinite minefield
+  \remarks None
+
+  Splits an infinite minefield into chunks of
+  64x64 cells. The mines of a row of a chunk come
+  from a stream seeded by the seed, the chunk and
+  the row, so a chunk is only created when a click
+  or the view reaches it, its counts reading the
+  border rows of its neighbours without creating
+  them. Chunks left resolved are evicted to keep the
+  memory bounded.
+
+*/
+
+#include "world.h"
+#include "console.h"
+#include "random.h"
+#include "render.h"
+
+#include <unistd.h>
+
+
+
+/*!
+  \fn static uint64_t chunkKey(int64_t int_cx, int64_t int_cy)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param int_cx x coordinate of the chunk
+  \param int_cy y coordinate of the chunk
+  \return The key of the chunk in the table and in the seed of its mines
+  \brief Packs the coordinates of a chunk in a word
+  \remarks Chunk coordinates always fit in 32 bits
+*/
+static uint64_t chunkKey(int64_t int_cx, int64_t int_cy)
+{
+  return(((uint64_t)(uint32_t)int_cx << 32) | (uint32_t)int_cy);
+}
+
+/*!
+  \fn static uint64_t mineRow(world* field, int64_t int_cx, int64_t int_cy, int int_row)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param field The infinite minefield
+  \param int_cx x coordinate of the chunk
+  \param int_cy y coordinate of the chunk
+  \param int_row Row of the chunk
+  \return The mines of the row, bit i for the cell i of the row
+  \brief Draws the mines of a row of a chunk
+  \remarks Every row has its own stream, so the border rows of a chunk
+  are drawn without the rest of it. Each draw gives 4 cells of 16 bits
+*/
+static uint64_t mineRow(world* field, int64_t int_cx, int64_t int_cy, int int_row)
+{
+  /* Variables */
+  rng gen;
+  uint64_t int_bits;
+  uint64_t int_draw;
+  int i;
+  int k;
+
+  seedRng(&gen, mixSeed(mixSeed(field->seed, chunkKey(int_cx, int_cy)), int_row));
+  int_bits = 0;
+  for (i = 0; i < WORLD_CHUNK; i += 4) {
+    int_draw = nextRandom(&gen);
+    for (k = 0; k < 4; k++) {
+      if (((int_draw >> (16 * k)) & 0xFFFF) < field->threshold) int_bits |= 1ULL << (i + k);
+    }
+  }
+
+  return(int_bits);
+}
+
+/*!
+  \fn static void setHaloRow(world* field, int int_y, uint64_t int_mines, uint64_t int_left, uint64_t int_right)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param field The infinite minefield
+  \param int_y Row of the scratch minefield
+  \param int_mines Mines of the row of the chunk
+  \param int_left 1 if the cell on the left of the row holds a mine
+  \param int_right 1 if the cell on the right of the row holds a mine
+  \brief Writes the mines of a row of the scratch minefield
+  \remarks None
+*/
+static void setHaloRow(world* field, int int_y, uint64_t int_mines, uint64_t int_left, uint64_t int_right)
+{
+  /* Variables */
+  cell* cell_row;
+  int i;
+
+  cell_row = &CELL_AT(&field->halo, 0, int_y);
+  cell_row[0] = (int_left) ? CELL_MINE : 0;
+  for (i = 0; i < WORLD_CHUNK; i++) cell_row[i + 1] = ((int_mines >> i) & 1) ? CELL_MINE : 0;
+  cell_row[WORLD_CHUNK + 1] = (int_right) ? CELL_MINE : 0;
+}
+
+/*!
+  \fn static int resolvedState(worldChunk* chunk)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param chunk The chunk
+  \return WORLD_RESOLVED or WORLD_RESOLVED_FLAGGED if the chunk can be
+  evicted, 0 otherwise
+  \brief Tells if the cells of a chunk can be created again from its mines
+  \remarks None
+*/
+static int resolvedState(worldChunk* chunk)
+{
+  if (chunk->hiddenSafe != 0) return(0);
+  if (chunk->flags == 0) return(WORLD_RESOLVED);
+  if ( (chunk->flags == chunk->validFlags) && (chunk->validFlags == chunk->mines) ) return(WORLD_RESOLVED_FLAGGED);
+
+  return(0);
+}
+
+/*!
+  \fn static void growTable(world* field)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param field The infinite minefield
+  \brief Doubles the chunk table and inserts every entry again
+  \remarks None
+*/
+static void growTable(world* field)
+{
+  /* Variables */
+  worldEntry* ptr_old;
+  int64_t int_oldSize;
+  int64_t i;
+  uint64_t int_slot;
+  uint64_t int_mask;
+
+  ptr_old = field->entries;
+  int_oldSize = field->tableSize;
+  field->tableSize = (int_oldSize == 0) ? 1024 : 2 * int_oldSize;
+  field->entries = calloc(field->tableSize, sizeof(worldEntry));
+
+  /* Kill the program if allocation error */
+  if (field->entries == NULL) {
+    fprintf(stderr, "Memory allocation error.\n");
+    exit(MEMORY_ALLOCATION_ERROR);
+  }
+
+  int_mask = field->tableSize - 1;
+  for (i = 0; i < int_oldSize; i++) {
+    if ( (ptr_old[i].chunk == NULL) && (ptr_old[i].resolved == 0) ) continue;
+    int_slot = mixSeed(0, ptr_old[i].key) & int_mask;
+    while ( (field->entries[int_slot].chunk != NULL) || (field->entries[int_slot].resolved != 0) ) int_slot = (int_slot + 1) & int_mask;
+    field->entries[int_slot] = ptr_old[i];
+  }
+  free(ptr_old);
+}
+
+/*!
+  \fn static worldEntry* findEntry(world* field, int64_t int_cx, int64_t int_cy, boolean bool_create)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param field The infinite minefield
+  \param int_cx x coordinate of the chunk
+  \param int_cy y coordinate of the chunk
+  \param bool_create true to add the entry if the chunk has none
+  \return The entry of the chunk, NULL if it has none and bool_create is false
+  \brief Looks a chunk up in the chunk table
+  \remarks A new entry is empty (no chunk, not resolved) : the caller
+  fills it before the next lookup. Creating an entry may move the others
+*/
+static worldEntry* findEntry(world* field, int64_t int_cx, int64_t int_cy, boolean bool_create)
+{
+  /* Variables */
+  uint64_t int_key;
+  uint64_t int_slot;
+  uint64_t int_mask;
+
+  if ( (bool_create) && (2 * (field->used + 1) > field->tableSize) ) growTable(field);
+
+  int_key = chunkKey(int_cx, int_cy);
+  int_mask = field->tableSize - 1;
+  int_slot = mixSeed(0, int_key) & int_mask;
+  while ( (field->entries[int_slot].chunk != NULL) || (field->entries[int_slot].resolved != 0) ) {
+    if (field->entries[int_slot].key == int_key) return(&field->entries[int_slot]);
+    int_slot = (int_slot + 1) & int_mask;
+  }
+  if (bool_create == false) return(NULL);
+
+  field->entries[int_slot].key = int_key;
+  field->used++;
+
+  return(&field->entries[int_slot]);
+}
+
+/*!
+  \fn static void queueResolved(world* field, worldChunk* chunk)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param field The infinite minefield
+  \param chunk A chunk whose cells have just changed
+  \brief Adds a chunk to the eviction queue if it is resolved
+  \remarks The state is checked again before the eviction
+*/
+static void queueResolved(world* field, worldChunk* chunk)
+{
+  if ( (chunk->queued) || (resolvedState(chunk) == 0) ) return;
+
+  /* Reuse the room of the chunks already looked at, or grow */
+  if (field->queueCount == field->queueSize) {
+    if (field->queueHead > 0) {
+      memmove(field->queue, field->queue + field->queueHead, (field->queueCount - field->queueHead) * sizeof(worldChunk*));
+      field->queueCount -= field->queueHead;
+      field->queueHead = 0;
+    } else {
+      field->queueSize = (field->queueSize == 0) ? 256 : 2 * field->queueSize;
+      field->queue = realloc(field->queue, field->queueSize * sizeof(worldChunk*));
+
+      /* Kill the program if allocation error */
+      if (field->queue == NULL) {
+        fprintf(stderr, "Memory allocation error.\n");
+        exit(MEMORY_ALLOCATION_ERROR);
+      }
+    }
+  }
+
+  field->queue[field->queueCount++] = chunk;
+  chunk->queued = true;
+}
+
+/*!
+  \fn static worldChunk* createChunk(world* field, int64_t int_cx, int64_t int_cy)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param field The infinite minefield
+  \param int_cx x coordinate of the chunk
+  \param int_cy y coordinate of the chunk
+  \return The chunk, in memory
+  \brief Gets a chunk, creating it if it isn't in memory
+  \remarks The mines of the chunk and the border rows of its 8 neighbours
+  are drawn in the scratch minefield and counted with the bit planes. A
+  chunk evicted resolved comes back with every safe cell revealed (and a
+  flag on every mine if it had them)
+*/
+static worldChunk* createChunk(world* field, int64_t int_cx, int64_t int_cy)
+{
+  /* Variables */
+  worldEntry* entry;
+  worldChunk* chunk;
+  void* ptr_chunk;
+  uint64_t int_mines;
+  int int_resolved;
+  int int_x;
+  int int_y;
+  cell* cell_c;
+
+  entry = findEntry(field, int_cx, int_cy, true);
+  if (entry->chunk != NULL) return(entry->chunk);
+
+  /* Kill the program if allocation error */
+  if (posix_memalign(&ptr_chunk, CELL_ALIGNMENT, sizeof(worldChunk)) != 0) {
+    fprintf(stderr, "Memory allocation error.\n");
+    exit(MEMORY_ALLOCATION_ERROR);
+  }
+  chunk = ptr_chunk;
+  chunk->cx = int_cx;
+  chunk->cy = int_cy;
+  chunk->mines = 0;
+  chunk->flags = 0;
+  chunk->validFlags = 0;
+  chunk->queued = false;
+
+  /* Mines of the chunk and of the cells around it */
+  setHaloRow(field, 0, mineRow(field, int_cx, int_cy - 1, WORLD_CHUNK - 1),
+             mineRow(field, int_cx - 1, int_cy - 1, WORLD_CHUNK - 1) >> 63, mineRow(field, int_cx + 1, int_cy - 1, WORLD_CHUNK - 1) & 1);
+  for (int_y = 0; int_y < WORLD_CHUNK; int_y++) {
+    int_mines = mineRow(field, int_cx, int_cy, int_y);
+    chunk->mines += __builtin_popcountll(int_mines);
+    setHaloRow(field, int_y + 1, int_mines, mineRow(field, int_cx - 1, int_cy, int_y) >> 63, mineRow(field, int_cx + 1, int_cy, int_y) & 1);
+  }
+  setHaloRow(field, WORLD_CHUNK + 1, mineRow(field, int_cx, int_cy + 1, 0),
+             mineRow(field, int_cx - 1, int_cy + 1, 0) >> 63, mineRow(field, int_cx + 1, int_cy + 1, 0) & 1);
+  countSurroundingMinesRows(&field->halo, &field->planes, 1, WORLD_CHUNK + 1);
+
+  for (int_y = 0; int_y < WORLD_CHUNK; int_y++) {
+    cell_c = &CELL_AT(&field->halo, 1, int_y + 1);
+    for (int_x = 0; int_x < WORLD_CHUNK; int_x++) chunk->cells[(int_y << WORLD_CHUNK_BITS) | int_x] = cell_c[int_x] | CELL_HIDDEN;
+  }
+  chunk->hiddenSafe = WORLD_CHUNK_CELLS - chunk->mines;
+
+  /* A resolved chunk comes back as it was evicted */
+  int_resolved = entry->resolved;
+  if (int_resolved != 0) {
+    for (int_x = 0; int_x < WORLD_CHUNK_CELLS; int_x++) {
+      cell_c = &chunk->cells[int_x];
+      if ((*cell_c & CELL_MINE) == 0) {
+        *cell_c &= ~CELL_HIDDEN;
+      } else if (int_resolved == WORLD_RESOLVED_FLAGGED) {
+        *cell_c |= CELL_FLAG;
+      }
+    }
+    chunk->hiddenSafe = 0;
+    if (int_resolved == WORLD_RESOLVED_FLAGGED) {
+      chunk->flags = chunk->mines;
+      chunk->validFlags = chunk->mines;
+    }
+  }
+
+  entry->chunk = chunk;
+  entry->resolved = 0;
+  field->resident++;
+  field->created++;
+  if (field->resident > field->peakResident) field->peakResident = field->resident;
+  if (int_resolved != 0) queueResolved(field, chunk);
+
+  return(chunk);
+}
+
+/*!
+  \fn static void evictResolved(world* field)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param field The infinite minefield
+  \brief Evicts the oldest resolved chunks while more than cacheLimit chunks
+  are in memory
+  \remarks Chunks changed since they were queued are skipped. Only their
+  entry is kept, with the way they were resolved
+*/
+static void evictResolved(world* field)
+{
+  /* Variables */
+  worldChunk* chunk;
+  worldEntry* entry;
+  int int_resolved;
+
+  while ( (field->resident > field->cacheLimit) && (field->queueHead < field->queueCount) ) {
+    chunk = field->queue[field->queueHead++];
+    chunk->queued = false;
+    int_resolved = resolvedState(chunk);
+    if (int_resolved == 0) continue;
+
+    entry = findEntry(field, chunk->cx, chunk->cy, false);
+    entry->chunk = NULL;
+    entry->resolved = int_resolved;
+    free(chunk);
+    field->resident--;
+    field->evicted++;
+  }
+  if (field->queueHead == field->queueCount) {
+    field->queueHead = 0;
+    field->queueCount = 0;
+  }
+}
+
+/*!
+  \fn static void revealWorldCell(world* field, worldChunk* chunk, cell* cell_c)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param field The infinite minefield
+  \param chunk The chunk of the cell
+  \param cell_c A hidden cell without a mine
+  \brief Reveals a cell, removing its flag, and updates the counters
+  \remarks None
+*/
+static void revealWorldCell(world* field, worldChunk* chunk, cell* cell_c)
+{
+  if (*cell_c & CELL_FLAG) {
+    chunk->flags--;
+    field->flags--;
+  }
+  *cell_c &= ~(CELL_HIDDEN | CELL_FLAG);
+  chunk->hiddenSafe--;
+  field->revealed++;
+  if (chunk->hiddenSafe == 0) queueResolved(field, chunk);
+}
+
+/*!
+  \fn static void pushCell(world* field, int64_t* ptr_length, int64_t int_x, int64_t int_y)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param field The infinite minefield
+  \param ptr_length Coordinates in the stack, updated
+  \param int_x x coordinate of the cell
+  \param int_y y coordinate of the cell
+  \brief Pushes a cell on the flood fill stack, growing it if needed
+  \remarks None
+*/
+static void pushCell(world* field, int64_t* ptr_length, int64_t int_x, int64_t int_y)
+{
+  if (*ptr_length + 2 > field->stackSize) {
+    field->stackSize = (field->stackSize == 0) ? 1024 : 2 * field->stackSize;
+    field->stack = realloc(field->stack, field->stackSize * sizeof(int64_t));
+
+    /* Kill the program if allocation error */
+    if (field->stack == NULL) {
+      fprintf(stderr, "Memory allocation error.\n");
+      exit(MEMORY_ALLOCATION_ERROR);
+    }
+  }
+
+  field->stack[(*ptr_length)++] = int_x;
+  field->stack[(*ptr_length)++] = int_y;
+}
+
+/*!
+  \fn static void revealWorld(world* field, worldChunk* chunk, int64_t int_x, int64_t int_y)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param field The infinite minefield
+  \param chunk The chunk of the cell
+  \param int_x x coordinate of a hidden cell without a mine
+  \param int_y y coordinate of the cell
+  \brief Reveals a cell and, if it is empty, the region around it, like reveal
+  \remarks Chunks evicted resolved are skipped : all their safe cells are
+  already revealed, and so are the ones their empty cells touch
+*/
+static void revealWorld(world* field, worldChunk* chunk, int64_t int_x, int64_t int_y)
+{
+  /* Variables */
+  int i;
+  int j;
+  int64_t int_newX;
+  int64_t int_newY;
+  int64_t int_length;
+  worldEntry* entry;
+  cell* cell_c;
+
+  cell_c = &chunk->cells[((int_y & (WORLD_CHUNK - 1)) << WORLD_CHUNK_BITS) | (int_x & (WORLD_CHUNK - 1))];
+  revealWorldCell(field, chunk, cell_c);
+  if ((*cell_c & CELL_COUNT) != 0) return;
+
+  int_length = 0;
+  pushCell(field, &int_length, int_x, int_y);
+
+  /* Every stacked cell is revealed and has no adjacent mines */
+  while (int_length > 0) {
+    int_y = field->stack[--int_length];
+    int_x = field->stack[--int_length];
+
+    for (j = -1; j <= 1; j++) {
+      for (i = -1; i <= 1; i++) {
+        int_newX = int_x + i;
+        int_newY = int_y + j;
+
+        /* Neighbours are mostly in the same chunk */
+        if ( (chunk == NULL) || ((int_newX >> WORLD_CHUNK_BITS) != chunk->cx) || ((int_newY >> WORLD_CHUNK_BITS) != chunk->cy) ) {
+          entry = findEntry(field, int_newX >> WORLD_CHUNK_BITS, int_newY >> WORLD_CHUNK_BITS, false);
+          if ( (entry != NULL) && (entry->resolved != 0) ) {
+            chunk = NULL;
+            continue;
+          }
+          chunk = ( (entry != NULL) && (entry->chunk != NULL) ) ? entry->chunk : createChunk(field, int_newX >> WORLD_CHUNK_BITS, int_newY >> WORLD_CHUNK_BITS);
+        }
+
+        cell_c = &chunk->cells[((int_newY & (WORLD_CHUNK - 1)) << WORLD_CHUNK_BITS) | (int_newX & (WORLD_CHUNK - 1))];
+        if ((*cell_c & CELL_HIDDEN) == 0) continue;
+        revealWorldCell(field, chunk, cell_c);
+        if ((*cell_c & CELL_COUNT) == 0) pushCell(field, &int_length, int_newX, int_newY);
+      }
+    }
+  }
+}
+
+void initWorld(world* field, uint64_t int_seed, int int_density, int64_t int_cacheLimit)
+{
+  /* Variables */
+  dimensions dim_halo;
+
+  field->seed = int_seed;
+  field->threshold = (uint32_t)((65536 * int_density + 50) / 100);
+  field->entries = NULL;
+  field->tableSize = 0;
+  field->used = 0;
+  field->resident = 0;
+  field->cacheLimit = int_cacheLimit;
+  field->queue = NULL;
+  field->queueHead = 0;
+  field->queueCount = 0;
+  field->queueSize = 0;
+  field->stack = NULL;
+  field->stackSize = 0;
+  field->revealed = 0;
+  field->flags = 0;
+  field->validFlags = 0;
+  field->created = 0;
+  field->evicted = 0;
+  field->peakResident = 0;
+  growTable(field);
+
+  /* A chunk with a border of one cell */
+  dim_halo.width = WORLD_CHUNK + 2;
+  dim_halo.height = WORLD_CHUNK + 2;
+  initMinefield(&field->halo, dim_halo);
+  initBitboard(&field->planes, dim_halo);
+}
+
+void freeWorld(world* field)
+{
+  /* Variables */
+  int64_t i;
+
+  for (i = 0; i < field->tableSize; i++) free(field->entries[i].chunk);
+  free(field->entries);
+  free(field->queue);
+  free(field->stack);
+  freeMinefield(&field->halo);
+  freeBitboard(&field->planes);
+  field->entries = NULL;
+  field->queue = NULL;
+  field->stack = NULL;
+  field->tableSize = 0;
+  field->resident = 0;
+}
+
+cell worldCell(world* field, int64_t int_x, int64_t int_y)
+{
+  /* Variables */
+  worldChunk* chunk;
+
+  chunk = createChunk(field, int_x >> WORLD_CHUNK_BITS, int_y >> WORLD_CHUNK_BITS);
+
+  return(chunk->cells[((int_y & (WORLD_CHUNK - 1)) << WORLD_CHUNK_BITS) | (int_x & (WORLD_CHUNK - 1))]);
+}
+
+int worldClick(world* field, int64_t int_x, int64_t int_y, int int_action)
+{
+  /* Variables */
+  worldChunk* chunk;
+  cell* cell_c;
+  int int_delta;
+  int int_res;
+
+  chunk = createChunk(field, int_x >> WORLD_CHUNK_BITS, int_y >> WORLD_CHUNK_BITS);
+  cell_c = &chunk->cells[((int_y & (WORLD_CHUNK - 1)) << WORLD_CHUNK_BITS) | (int_x & (WORLD_CHUNK - 1))];
+
+  if ((*cell_c & CELL_HIDDEN) == 0) {
+    /* Cell is already revealed */
+    int_res = -1;
+  } else if (int_action == 2) {
+    /* Toggle the flag */
+    *cell_c ^= CELL_FLAG;
+    int_delta = (*cell_c & CELL_FLAG) ? 1 : -1;
+    chunk->flags += int_delta;
+    field->flags += int_delta;
+    if (*cell_c & CELL_MINE) {
+      chunk->validFlags += int_delta;
+      field->validFlags += int_delta;
+    }
+    queueResolved(field, chunk);
+    int_res = 1;
+  } else if (*cell_c & CELL_MINE) {
+    /* User clicked on a mine */
+    *cell_c |= CELL_BOMB;
+    int_res = 0;
+  } else {
+    revealWorld(field, chunk, int_x, int_y);
+    int_res = 1;
+  }
+
+  /* Only between clicks, the flood fill holds chunks */
+  evictResolved(field);
+
+  return(int_res);
+}
+
+size_t worldBytes(world* field)
+{
+  return(field->resident * sizeof(worldChunk) + field->tableSize * sizeof(worldEntry) + field->queueSize * sizeof(worldChunk*));
+}
+
+int runInfinite(options* opt, moveStream* stream)
+{
+  /* Variables */
+  world field;
+  int64_t int_start;
+  int64_t int_playNs;
+  int64_t int_x;
+  int64_t int_y;
+  int64_t int_action;
+  int64_t int_moves;
+  int64_t int_rejected;
+  int64_t int_errorLine;
+  int int_read;
+  int int_clicked;
+  int int_outcome;
+  static const char* const OUTCOMES[] = { "unfinished", "won", "lost" };
+
+  initWorld(&field, opt->seed, opt->density, opt->cache);
+  int_outcome = OUTCOME_UNFINISHED;
+  int_moves = 0;
+  int_rejected = 0;
+  int_errorLine = 0;
+
+  int_start = nowNs();
+  while ( (int_read = readMove(stream, &int_x, &int_y, &int_action)) == 1 ) {
+    if ( (int_action < 1) || (int_action > 2) ) {
+      int_rejected++;
+      continue;
+    }
+
+    int_clicked = worldClick(&field, int_x, int_y, int_action);
+    if (int_clicked == -1) {
+      int_rejected++;
+      continue;
+    }
+    int_moves++;
+
+    /* There is no last safe cell to win on */
+    if (int_clicked == 0) {
+      int_outcome = OUTCOME_LOST;
+      break;
+    }
+  }
+  if (int_read == -1) int_errorLine = stream->line;
+  int_playNs = nowNs() - int_start;
+
+  printf("{\"mode\":\"infinite\",\"outcome\":\"%s\",\"density\":%d,\"seed\":%llu,\"moves\":%lld,\"rejected\":%lld,"
+         "\"revealed\":%lld,\"flags\":%lld,\"chunks\":%lld,\"evicted\":%lld,\"resident\":%lld,\"peak_resident\":%lld,"
+         "\"resident_bytes\":%zu,\"play_ns\":%lld,\"moves_per_second\":%.0f",
+         OUTCOMES[int_outcome], opt->density, (unsigned long long)opt->seed, (long long)int_moves,
+         (long long)int_rejected, (long long)field.revealed, (long long)field.flags, (long long)field.created,
+         (long long)field.evicted, (long long)field.resident, (long long)field.peakResident, worldBytes(&field),
+         (long long)int_playNs, (int_playNs > 0) ? 1e9 * (int_moves + int_rejected) / int_playNs : 0.0);
+  if (int_errorLine != 0) printf(",\"error_line\":%lld", (long long)int_errorLine);
+  printf("}\n");
+
+  freeWorld(&field);
+
+  return( (int_errorLine != 0) ? MOVE_INPUT_ERROR : 0 );
+}
+
+/*!
+  \fn static void fillView(world* field, board* view, int64_t int_originX, int64_t int_originY)
+  \author L.Draescher <draescherl@eisti.eu>
+  \date 18/10/2026
+  \version 0.1 - first draft
+  \param field The infinite minefield
+  \param view The minefield of the view
+  \param int_originX x coordinate of the top left cell of the view
+  \param int_originY y coordinate of the top left cell of the view
+  \brief Copies the cells under the view
+  \remarks Creates the chunks the view reaches
+*/
+static void fillView(world* field, board* view, int64_t int_originX, int64_t int_originY)
+{
+  /* Variables */
+  int i;
+  int j;
+
+  for (j = 0; j < view->dim.height; j++) {
+    for (i = 0; i < view->dim.width; i++) CELL_AT(view, i, j) = worldCell(field, int_originX + i, int_originY + j);
+  }
+}
+
+int playInfinite(options* opt)
+{
+  /* Variables */
+  world field;
+  board view;
+  renderer screen;
+  dimensions dim_view;
+  int64_t int_originX;
+  int64_t int_originY;
+  int int_x;
+  int int_y;
+  int int_action;
+  int int_res;
+  char str_hint[128];
+
+  dim_view.width = (opt->dim.width > 0) ? opt->dim.width : WORLD_VIEW_WIDTH;
+  dim_view.height = (opt->dim.height > 0) ? opt->dim.height : WORLD_VIEW_HEIGHT;
+  initWorld(&field, opt->seed, opt->density, opt->cache);
+  allocMinefield(&view, dim_view);
+  initRenderer(&screen, STDOUT_FILENO);
+
+  /* The view starts around (0, 0) */
+  int_originX = -dim_view.width / 2;
+  int_originY = -dim_view.height / 2;
+  str_hint[0] = '\0';
+  clrscr();
+  do {
+    fillView(&field, &view, int_originX, int_originY);
+    renderMinefield(&screen, &view);
+    printf("View : x from %lld to %lld, y from %lld to %lld\n", (long long)int_originX, (long long)(int_originX + dim_view.width - 1),
+           (long long)int_originY, (long long)(int_originY + dim_view.height - 1));
+    printf("Revealed : %lld, flags : %lld\n", (long long)field.revealed, (long long)field.flags);
+    printf("%s", str_hint);
+    str_hint[0] = '\0';
+
+    /* Coordinates in the view */
+    do {
+      printf("x coordinate (between 0 and %d) : ", dim_view.width - 1);
+      int_x = intInput();
+    } while ( (int_x < 0) || (int_x > dim_view.width - 1) );
+    do {
+      printf("y coordinate (between 0 and %d) : ", dim_view.height - 1);
+      int_y = intInput();
+    } while ( (int_y < 0) || (int_y > dim_view.height - 1) );
+    do {
+      printf("Do you want to reveal (1), mark (2) or move the view here (3) ? ");
+      int_action = intInput();
+    } while ( (int_action < 1) || (int_action > 3) );
+
+    if (int_action == 3) {
+      int_originX += int_x - dim_view.width / 2;
+      int_originY += int_y - dim_view.height / 2;
+      int_res = 1;
+    } else {
+      int_res = worldClick(&field, int_originX + int_x, int_originY + int_y, int_action);
+      if (int_res == -1) snprintf(str_hint, sizeof(str_hint), "This cell can't be clicked.\n");
+    }
+    clrscr();
+  } while (int_res != 0);
+
+  /* There is no last safe cell to win on */
+  fillView(&field, &view, int_originX, int_originY);
+  renderMinefield(&screen, &view);
+  printf("BOOM ! You just stepped on a mine, after revealing %lld cells.\n", (long long)field.revealed);
+  printf("Seed : %llu\n", (unsigned long long)opt->seed);
+
+  freeRenderer(&screen);
+  freeMinefield(&view);
+  freeWorld(&field);
+
+  return(0);
+}